@@ -2,6 +2,7 @@
 
 #include "al2o3_platform/platform.h"
 #include "al2o3_enki/TaskScheduler_c.h"
+#include "tiny_imageformat/tinyimageformat_base.h"
 
 // highest level API. If uncompressed return src, null if cant, new image returned if decompressed
 AL2O3_EXTERN_C Image_ImageHeader const *Image_Decompress(Image_ImageHeader const *src);
@@ -9,9 +10,50 @@ AL2O3_EXTERN_C Image_ImageHeader const *Image_Decompress(Image_ImageHeader const
 // this will decompress using all cores using enki task manager
 AL2O3_EXTERN_C Image_ImageHeader const *ImageDecompressWithEnki(Image_ImageHeader const *src, enkiTaskSchedulerHandle taskScheduler);
 
+// as above but into dstFormat, TinyImageFormat_UNDEFINED gives the default format. null if src can't be decoded to dstFormat
+// ASTC UNORM to R16G16B16A16_SFLOAT decodes with the HDR profile
+// formats decoding to B8G8R8A8 can also go to R8G8B8A8, R8G8B8 or B8G8R8 of the same colour space or B8G8R8X8_UNORM
+// UNORM and SNORM formats can also go to the float or half float format with the same channels (R, RG or RGBA),
+// BC6H to R32G32B32A32_SFLOAT. sRGB formats to R32G32B32A32_SFLOAT or R16G16B16A16_SFLOAT are decoded to linear
+// BC1 decodes directly to B5G6R5_UNORM (its endpoint layout) or R8G8B8, EAC R11 and RG11 to R8 and R8G8 of the same
+// signedness, as BC4 and BC5 already do
+AL2O3_EXTERN_C Image_ImageHeader const *Image_DecompressTo(Image_ImageHeader const *src, TinyImageFormat dstFormat);
+AL2O3_EXTERN_C Image_ImageHeader const *ImageDecompressToWithEnki(Image_ImageHeader const *src, TinyImageFormat dstFormat, enkiTaskSchedulerHandle taskScheduler);
+
+// as above with the colour premultiplied by alpha as it's stored. sRGB colour is premultiplied in linear space,
+// float outputs after conversion. null for an uncompressed src
+AL2O3_EXTERN_C Image_ImageHeader const *Image_DecompressToPremultiplied(Image_ImageHeader const *src, TinyImageFormat dstFormat);
+AL2O3_EXTERN_C Image_ImageHeader const *ImageDecompressToPremultipliedWithEnki(Image_ImageHeader const *src, TinyImageFormat dstFormat, enkiTaskSchedulerHandle taskScheduler);
+
+// normal maps with only X and Y stored (BC5, EAC RG11 and DXT5nm BC3 with X in alpha) decoded with Z rebuilt as
+// sqrt(1 - x^2 - y^2). dstFormat R8G8B8_UNORM, R8G8B8A8_UNORM (alpha 1) or R16G16B16_UNORM hold XYZ * 0.5 + 0.5,
+// R32G32B32_SFLOAT holds XYZ. null if src isn't one of those formats
+AL2O3_EXTERN_C Image_ImageHeader const *Image_DecompressNormalMap(Image_ImageHeader const *src, TinyImageFormat dstFormat);
+AL2O3_EXTERN_C Image_ImageHeader const *ImageDecompressNormalMapWithEnki(Image_ImageHeader const *src, TinyImageFormat dstFormat, enkiTaskSchedulerHandle taskScheduler);
+
+// a single channel of a compressed image that decodes to 8 bit RGBA as an R8_UNORM image (R8_SRGB for the colour
+// channels of sRGB formats). Alpha of BC1, BC2, BC3 and ETC2 is decoded without the colour, other formats (BC7,
+// ASTC...) decode in full and keep only the channel. Red or green of BC4, BC5, EAC R11 and RG11 is decoded alone
+// to R8_UNORM (R8_SNORM for the signed formats). null for other formats or channels
+AL2O3_EXTERN_C Image_ImageHeader const *Image_DecompressChannel(Image_ImageHeader const *src, TinyImageFormat_LogicalChannel channel);
+AL2O3_EXTERN_C Image_ImageHeader const *ImageDecompressChannelWithEnki(Image_ImageHeader const *src, TinyImageFormat_LogicalChannel channel, enkiTaskSchedulerHandle taskScheduler);
+
+// decodes src to its default format and box filters a mip chain from it while each tile of texels is in cache,
+// sRGB colour is filtered in linear space. mips[0] is the decoded image, returns how many levels were written to mips
+// (at most maxMipCount), 0 if src can't be. 2D formats decoding to R8, R8G8 or B8G8R8A8 UNORM or SRGB only
+AL2O3_EXTERN_C uint32_t Image_DecompressWithMips(Image_ImageHeader const *src, uint32_t maxMipCount, Image_ImageHeader const **mips);
+AL2O3_EXTERN_C uint32_t ImageDecompressWithMipsWithEnki(Image_ImageHeader const *src, uint32_t maxMipCount, Image_ImageHeader const **mips,
+																												enkiTaskSchedulerHandle taskScheduler);
+
+// 3D ASTC has no TinyImageFormat, src is the tightly packed 16 byte blocks (x fastest then y then z) of a width x height x depth volume
+// dstFormat B8G8R8A8_UNORM, B8G8R8A8_SRGB or R16G16B16A16_SFLOAT (HDR profile). null if the footprint or dstFormat isn't supported
+AL2O3_EXTERN_C Image_ImageHeader const *Image_DecompressASTC3D(void const *src, uint32_t width, uint32_t height, uint32_t depth,
+																															 uint32_t blockWidth, uint32_t blockHeight, uint32_t blockDepth, TinyImageFormat dstFormat);
+AL2O3_EXTERN_C Image_ImageHeader const *ImageDecompressASTC3DWithEnki(void const *src, uint32_t width, uint32_t height, uint32_t depth,
+																																			uint32_t blockWidth, uint32_t blockHeight, uint32_t blockDepth, TinyImageFormat dstFormat,
+																																			enkiTaskSchedulerHandle taskScheduler);
+
 // lowest level interface block decompression API
-// TODO BC4 and 5 should have UNORM & SNORM for float decoders
-// TODO sRGB decode for float versions
 
 // RGB Single mode takes input 8 byte RGB block, outputs 16 x BGRA (4)
 // Alpha Single mode takes input 8 byte Alpha block, outputs 16 x A
@@ -30,10 +72,26 @@ AL2O3_EXTERN_C void Image_DecompressDXBC2Block(void const * input,	uint8_t outpu
 AL2O3_EXTERN_C void Image_DecompressDXBC3Block(void const * input,	uint8_t output[4 * 4 * sizeof(uint32_t)]);
 AL2O3_EXTERN_C void Image_DecompressDXBC4Block(void const * input,	uint8_t output[4 * 4]);
 AL2O3_EXTERN_C void Image_DecompressDXBC5Block(void const * input,	uint8_t output[4 * 4 * 2]);
+// SNORM BC4/5, output is 16 x R or 16 x RG int8 (-127 to 127)
+AL2O3_EXTERN_C void Image_DecompressDXBC4SNormBlock(void const * input,	uint8_t output[4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC5SNormBlock(void const * input,	uint8_t output[4 * 4 * 2]);
 AL2O3_EXTERN_C void Image_DecompressDXBC7Block(void const * input,	uint8_t output[4 * 4 * sizeof(uint32_t)]);
+// BC7 blockCount consecutive 16 byte blocks to blockCount 16 x BGRA (4) blocks, blocks are grouped by mode internally
+AL2O3_EXTERN_C void Image_DecompressDXBC7Blocks(void const * input, uint32_t blockCount, uint8_t* output);
+// BC6H outputs 16 x RGBA half floats, alpha is 1
+AL2O3_EXTERN_C void Image_DecompressDXBC6HUFloatBlock(void const * input,	uint8_t output[4 * 4 * 4 * sizeof(uint16_t)]);
+AL2O3_EXTERN_C void Image_DecompressDXBC6HSFloatBlock(void const * input,	uint8_t output[4 * 4 * 4 * sizeof(uint16_t)]);
 
 // output has to have 12 * 12 * sizeof(uint32_t) bytes for largest ASTC block
 AL2O3_EXTERN_C void Image_DecompressASTCBlock(void const * input,	uint32_t blockWidth, uint32_t blockHeight, bool isSRGB, uint8_t* output);
+// blockCount consecutive 2D blocks to blockCount consecutive decompressed blocks, blocks are grouped by partition count,
+// dual plane and weight grid size internally
+AL2O3_EXTERN_C void Image_DecompressASTCBlocks(void const * input,	uint32_t blockCount, uint32_t blockWidth, uint32_t blockHeight, bool isSRGB, uint8_t* output);
+// HDR profile, outputs RGBA half floats so output has to have 12 * 12 * 4 * sizeof(uint16_t) bytes for largest ASTC block
+AL2O3_EXTERN_C void Image_DecompressASTCHDRBlock(void const * input,	uint32_t blockWidth, uint32_t blockHeight, uint8_t* output);
+// 3D blocks (3x3x3 to 6x6x6), output is x fastest then y then z so up to 6 * 6 * 6 texels
+AL2O3_EXTERN_C void Image_DecompressASTC3DBlock(void const * input,	uint32_t blockWidth, uint32_t blockHeight, uint32_t blockDepth, bool isSRGB, uint8_t* output);
+AL2O3_EXTERN_C void Image_DecompressASTCHDR3DBlock(void const * input,	uint32_t blockWidth, uint32_t blockHeight, uint32_t blockDepth, uint8_t* output);
 
 AL2O3_EXTERN_C void Image_DecompressETC1Block(void const * input, uint8_t output[4 * 4 * sizeof(uint32_t)]);
 AL2O3_EXTERN_C void Image_DecompressETC2Block(void const *AL2O3_RESTRICT input, uint8_t output[4 * 4 * sizeof(uint32_t)]);
@@ -44,9 +102,57 @@ AL2O3_EXTERN_C void Image_DecompressEACDualSigned11Block(void const *AL2O3_RESTR
 AL2O3_EXTERN_C void Image_DecompressEAC11Block(void const *AL2O3_RESTRICT input, uint8_t output[4 * 4 * sizeof(uint16_t)]);
 AL2O3_EXTERN_C void Image_DecompressEACDual11Block(void const *AL2O3_RESTRICT input, uint8_t output[4 * 4 * sizeof(uint16_t) * 2]);
 
+// float outputs are RGBA, the SRGB versions decode the colour to linear
 AL2O3_EXTERN_C void Image_DecompressDXBC1BlockF(void const * input,	float output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC1SRGBBlockF(void const * input,	float output[4 * 4 * 4]);
 AL2O3_EXTERN_C void Image_DecompressDXBC2BlockF(void const * input,	float output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC2SRGBBlockF(void const * input,	float output[4 * 4 * 4]);
 AL2O3_EXTERN_C void Image_DecompressDXBC3BlockF(void const * input,	float output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC3SRGBBlockF(void const * input,	float output[4 * 4 * 4]);
 AL2O3_EXTERN_C void Image_DecompressDXBC4BlockF(void const * input,	float output[4 * 4]);
 AL2O3_EXTERN_C void Image_DecompressDXBC5BlockF(void const * input,	float output[4 * 4 * 2]);
+AL2O3_EXTERN_C void Image_DecompressDXBC4SNormBlockF(void const * input,	float output[4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC5SNormBlockF(void const * input,	float output[4 * 4 * 2]);
 AL2O3_EXTERN_C void Image_DecompressDXBC7BlockF(void const * input,	float output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC7SRGBBlockF(void const * input,	float output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC6HUFloatBlockF(void const * input,	float output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC6HSFloatBlockF(void const * input,	float output[4 * 4 * 4]);
+// output is blockWidth x blockHeight x RGBA, UNORM is the HDR profile decode and SRGB the LDR decode
+AL2O3_EXTERN_C void Image_DecompressASTCBlockF(void const * input,	uint32_t blockWidth, uint32_t blockHeight, bool isSRGB, float* output);
+AL2O3_EXTERN_C void Image_DecompressETC2BlockF(void const * input, float output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressETC2SRGBBlockF(void const * input, float output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressETC2PunchThroughBlockF(void const * input, float output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressETC2PunchThroughSRGBBlockF(void const * input, float output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressETC2EACBlockF(void const * input, float output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressETC2EACSRGBBlockF(void const * input, float output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressEAC11BlockF(void const * input, float output[4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressEACSigned11BlockF(void const * input, float output[4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressEACDual11BlockF(void const * input, float output[4 * 4 * 2]);
+AL2O3_EXTERN_C void Image_DecompressEACDualSigned11BlockF(void const * input, float output[4 * 4 * 2]);
+
+// half float outputs, laid out as the float ones
+AL2O3_EXTERN_C void Image_DecompressDXBC1BlockH(void const * input,	uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC1SRGBBlockH(void const * input,	uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC2BlockH(void const * input,	uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC2SRGBBlockH(void const * input,	uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC3BlockH(void const * input,	uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC3SRGBBlockH(void const * input,	uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC4BlockH(void const * input,	uint16_t output[4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC5BlockH(void const * input,	uint16_t output[4 * 4 * 2]);
+AL2O3_EXTERN_C void Image_DecompressDXBC4SNormBlockH(void const * input,	uint16_t output[4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC5SNormBlockH(void const * input,	uint16_t output[4 * 4 * 2]);
+AL2O3_EXTERN_C void Image_DecompressDXBC7BlockH(void const * input,	uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC7SRGBBlockH(void const * input,	uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC6HUFloatBlockH(void const * input,	uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressDXBC6HSFloatBlockH(void const * input,	uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressASTCBlockH(void const * input,	uint32_t blockWidth, uint32_t blockHeight, bool isSRGB, uint16_t* output);
+AL2O3_EXTERN_C void Image_DecompressETC2BlockH(void const * input, uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressETC2SRGBBlockH(void const * input, uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressETC2PunchThroughBlockH(void const * input, uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressETC2PunchThroughSRGBBlockH(void const * input, uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressETC2EACBlockH(void const * input, uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressETC2EACSRGBBlockH(void const * input, uint16_t output[4 * 4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressEAC11BlockH(void const * input, uint16_t output[4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressEACSigned11BlockH(void const * input, uint16_t output[4 * 4]);
+AL2O3_EXTERN_C void Image_DecompressEACDual11BlockH(void const * input, uint16_t output[4 * 4 * 2]);
+AL2O3_EXTERN_C void Image_DecompressEACDualSigned11BlockH(void const * input, uint16_t output[4 * 4 * 2]);
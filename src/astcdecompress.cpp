@@ -1,5 +1,5 @@
 // basisu_astc_decomp.cpp: Only used for ASTC decompression, to validate the transcoder's output.
-// This version does not support HDR.
+// Image_DecompressASTCHDRBlock decodes with the HDR profile to RGBA half floats.
 
 /*-------------------------------------------------------------------------
  * drawElements Quality Program Tester Core
@@ -35,6 +35,12 @@
 #include "al2o3_platform/platform.h"
 #include <assert.h>
 #include <algorithm>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ASTC_DECOMP_SSE2 1
+#else
+#define ASTC_DECOMP_SSE2 0
+#endif
 
 #define DE_LENGTH_OF_ARRAY(x) (sizeof(x)/sizeof(x[0]))
 #define DE_UNREF(x) (void)x
@@ -50,6 +56,13 @@ typedef uint64_t deUint64;
 
 #define DE_ASSERT assert
 
+// in decompressstore.cpp, for the float and half block decodes
+extern float const *UNorm8ToFloatTable();
+extern float const *SRGBToLinearTable();
+extern uint16_t const *UNorm8ToHalfTable();
+extern uint16_t const *SRGBToLinearHalfTable();
+extern float HalfToFloat(uint16_t h);
+
 namespace basisu
 {
 static bool inBounds(int v, int l, int h)
@@ -199,14 +212,29 @@ static bool deInBounds32(uint32_t v, uint32_t l, uint32_t h)
 
 namespace astc
 {
+static uint32_t pack32B8(uint8_t b) {
+	return (uint32_t) b;
+}
+
+static uint32_t pack32G8(uint8_t g) {
+	return (uint32_t) g << 8;
+}
+
+static uint32_t pack32R8(uint8_t r) {
+	return (uint32_t) r << 16;
+}
+
+static uint32_t pack32A8(uint8_t a) {
+	return (uint32_t) a << 24;
+}
+
+static uint32_t pack32RGBA8(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
+	return pack32R8(r) | pack32G8(g) | pack32B8(b) | pack32A8(a);
+}
+
 namespace
 {
 // Common utilities
-enum
-{
-	MAX_BLOCK_WIDTH		= 12,
-	MAX_BLOCK_HEIGHT	= 12
-};
 inline deUint32 getBit (deUint32 src, int ndx)
 {
 			DE_ASSERT(basisu::inBounds(ndx, 0, 32));
@@ -225,13 +253,14 @@ inline bool isBitSet (deUint32 src, int ndx)
 {
 	return getBit(src, ndx) != 0;
 }
-inline deUint32 reverseBits (deUint32 src, int numBits)
+inline deUint64 reverseBits64 (deUint64 v)
 {
-			DE_ASSERT(basisu::inRange(numBits, 0, 32));
-	deUint32 result = 0;
-	for (int i = 0; i < numBits; i++)
-		result |= ((src >> i) & 1) << (numBits-1-i);
-	return result;
+	v = ((v >> 1) & 0x5555555555555555ull) | ((v & 0x5555555555555555ull) << 1);
+	v = ((v >> 2) & 0x3333333333333333ull) | ((v & 0x3333333333333333ull) << 2);
+	v = ((v >> 4) & 0x0f0f0f0f0f0f0f0full) | ((v & 0x0f0f0f0f0f0f0f0full) << 4);
+	v = ((v >> 8) & 0x00ff00ff00ff00ffull) | ((v & 0x00ff00ff00ff00ffull) << 8);
+	v = ((v >> 16) & 0x0000ffff0000ffffull) | ((v & 0x0000ffff0000ffffull) << 16);
+	return (v >> 32) | (v << 32);
 }
 inline deUint32 bitReplicationScale (deUint32 src, int numSrcBits, int numDstBits)
 {
@@ -329,6 +358,8 @@ enum DecompressResult
 	DECOMPRESS_RESULT_LAST
 };
 // A helper for getting bits from a 128-bit block.
+// The block is also kept bit reversed, so the weights, which are stored backwards from bit 127,
+// read forwards like everything else. Words are zero padded so a field may run past the end.
 class Block128
 {
 private:
@@ -337,7 +368,8 @@ private:
 	{
 		WORD_BYTES	= sizeof(Word),
 		WORD_BITS	= 8*WORD_BYTES,
-		NUM_WORDS	= 128 / WORD_BITS
+		NUM_WORDS	= 128 / WORD_BITS,
+		NUM_PADDED	= NUM_WORDS + 2
 	};
 	//DE_STATIC_ASSERT(128 % WORD_BITS == 0);
 public:
@@ -349,6 +381,13 @@ public:
 			for (int byteNdx = 0; byteNdx < WORD_BYTES; byteNdx++)
 				m_words[wordNdx] |= (Word)src[wordNdx*WORD_BYTES + byteNdx] << (8*byteNdx);
 		}
+		for (int wordNdx = 0; wordNdx < NUM_WORDS; wordNdx++)
+			m_reversedWords[wordNdx] = reverseBits64(m_words[NUM_WORDS-1 - wordNdx]);
+		for (int wordNdx = NUM_WORDS; wordNdx < NUM_PADDED; wordNdx++)
+		{
+			m_words[wordNdx] = 0;
+			m_reversedWords[wordNdx] = 0;
+		}
 	}
 	deUint32 getBit (int ndx) const
 	{
@@ -360,65 +399,61 @@ public:
 				DE_ASSERT(basisu::inBounds(low, 0, 128));
 				DE_ASSERT(basisu::inBounds(high, 0, 128));
 				DE_ASSERT(basisu::inRange(high-low+1, 0, 32));
-		if (high-low+1 == 0)
-			return 0;
-		const int word0Ndx = low / WORD_BITS;
-		const int word1Ndx = high / WORD_BITS;
-		// \note "foo << bar << 1" done instead of "foo << (bar+1)" to avoid overflow, i.e. shift amount being too big.
-		if (word0Ndx == word1Ndx)
-			return (deUint32)((m_words[word0Ndx] & ((((Word)1 << high%WORD_BITS << 1) - 1))) >> ((Word)low % WORD_BITS));
-		else
-		{
-					DE_ASSERT(word1Ndx == word0Ndx + 1);
-			return (deUint32)(m_words[word0Ndx] >> (low%WORD_BITS)) |
-					(deUint32)((m_words[word1Ndx] & (((Word)1 << high%WORD_BITS << 1) - 1)) << (high-low - high%WORD_BITS));
-		}
+		return extractBits(m_words, low, high-low+1);
 	}
 	bool isBitSet (int ndx) const
 	{
 				DE_ASSERT(basisu::inBounds(ndx, 0, 128));
 		return getBit(ndx) != 0;
 	}
+	// Bit ndx of the reversed words is bit 127-ndx of the block.
+	const Word* getWords (bool reversed) const
+	{
+		return reversed ? m_reversedWords : m_words;
+	}
+	// Funnel shift of the two words the field can touch, no branch on crossing the word boundary.
+	static deUint32 extractBits (const Word* words, int low, int numBits)
+	{
+				DE_ASSERT(basisu::inBounds(low, 0, (NUM_PADDED-1)*WORD_BITS));
+				DE_ASSERT(basisu::inRange(numBits, 0, 32));
+		const int	wordNdx	= low / WORD_BITS;
+		const int	shift	= low % WORD_BITS;
+		// \note "(foo << 1) << (63-shift)" done instead of "foo << (64-shift)" so a shift of 0 stays defined.
+		const Word	bits	= (words[wordNdx] >> shift) | ((words[wordNdx+1] << 1) << (WORD_BITS-1 - shift));
+		return (deUint32)(bits & (((Word)1 << numBits) - 1));
+	}
 private:
-	Word m_words[NUM_WORDS];
+	Word m_words[NUM_PADDED];
+	Word m_reversedWords[NUM_PADDED];
 };
 // A helper for sequential access into a Block128.
 class BitAccessStream
 {
 public:
 	BitAccessStream (const Block128& src, int startNdxInSrc, int length, bool forward)
-			: m_src				(src)
-			, m_startNdxInSrc	(startNdxInSrc)
+			: m_words			(src.getWords(!forward))
+			, m_startNdx		(forward ? startNdxInSrc : 127 - startNdxInSrc)
 			, m_length			(length)
-			, m_forward			(forward)
 			, m_ndx				(0)
 	{
 	}
 	// Get the next num bits. Bits at positions greater than or equal to m_length are zeros.
 	deUint32 getNext (int num)
 	{
-		if (num == 0 || m_ndx >= m_length)
-			return 0;
-		const int end				= m_ndx + num;
-		const int numBitsFromSrc	= basisu::max(0, basisu::min(m_length, end) - m_ndx);
-		const int low				= m_ndx;
-		const int high				= m_ndx + numBitsFromSrc - 1;
+		const int numBitsFromSrc	= basisu::clamp(m_length - m_ndx, 0, num);
+		const int low				= m_startNdx + m_ndx;
 		m_ndx += num;
-		return m_forward ?			   m_src.getBits(m_startNdxInSrc + low,  m_startNdxInSrc + high)
-										 : reverseBits(m_src.getBits(m_startNdxInSrc - high, m_startNdxInSrc - low), numBitsFromSrc);
+		return Block128::extractBits(m_words, low, numBitsFromSrc);
 	}
 private:
-	const Block128&		m_src;
-	const int			m_startNdxInSrc;
+	const deUint64*		m_words;
+	const int			m_startNdx;
 	const int			m_length;
-	const bool			m_forward;
 	int					m_ndx;
 };
 struct ISEDecodedResult
 {
-	deUint32 m;
-	deUint32 tq; //!< Trit or quint value, depending on ISE mode.
-	deUint32 v;
+	deUint32 v; //!< (tq << numBits) | m, which is all the unquantization tables need.
 };
 // Data from an ASTC block's "block mode" part (i.e. bits [0,10]).
 struct ASTCBlockMode
@@ -430,6 +465,7 @@ struct ASTCBlockMode
 	bool		isDualPlane;
 	int			weightGridWidth;
 	int			weightGridHeight;
+	int			weightGridDepth;	//!< 1 for 2D blocks.
 	ISEParams	weightISEParams;
 	ASTCBlockMode (void)
 			: isError			(true)
@@ -437,24 +473,61 @@ struct ASTCBlockMode
 			, isDualPlane		(true)
 			, weightGridWidth	(-1)
 			, weightGridHeight	(-1)
+			, weightGridDepth	(-1)
 			, weightISEParams	(ISEMODE_LAST, -1)
 	{
 	}
 };
 inline int computeNumWeights (const ASTCBlockMode& mode)
 {
-	return mode.weightGridWidth * mode.weightGridHeight * (mode.isDualPlane ? 2 : 1);
+	return mode.weightGridWidth * mode.weightGridHeight * mode.weightGridDepth * (mode.isDualPlane ? 2 : 1);
 }
 struct ColorEndpointPair
 {
 	UVec4 e0;
 	UVec4 e1;
 };
-struct TexelWeightPair
+// Interpolated texel weights (0..64), one plane per array. Plane 1 is only used by dual plane blocks.
+template<int NumTexels>
+struct TexelWeightPlanes
 {
-	deUint32 w[2];
+	deUint8 w[2][NumTexels];
 };
-ASTCBlockMode getASTCBlockMode (deUint32 blockModeData)
+// Weight range from the block mode's R and H bits, the same for 2D and 3D blocks.
+ISEParams decodeWeightISEParams (deUint32 r, bool h)
+{
+	ISEParams params(ISEMODE_PLAIN_BIT, 0);
+	ISEMode&	m	= params.mode;
+	int&		b	= params.numBits;
+	if (h)
+	{
+		switch (r)
+		{
+		case 2:							m = ISEMODE_QUINT;	b = 1;	break;
+		case 3:		m = ISEMODE_TRIT;						b = 2;	break;
+		case 4:												b = 4;	break;
+		case 5:							m = ISEMODE_QUINT;	b = 2;	break;
+		case 6:		m = ISEMODE_TRIT;						b = 3;	break;
+		case 7:												b = 5;	break;
+		default:	DE_ASSERT(false);
+		}
+	}
+	else
+	{
+		switch (r)
+		{
+		case 2:												b = 1;	break;
+		case 3:		m = ISEMODE_TRIT;								break;
+		case 4:												b = 2;	break;
+		case 5:							m = ISEMODE_QUINT;			break;
+		case 6:		m = ISEMODE_TRIT;						b = 1;	break;
+		case 7:												b = 3;	break;
+		default:	DE_ASSERT(false);
+		}
+	}
+	return params;
+}
+ASTCBlockMode decodeASTCBlockMode (deUint32 blockModeData)
 {
 	ASTCBlockMode blockMode;
 	blockMode.isError = true; // \note Set to false later, if not error.
@@ -519,78 +592,204 @@ ASTCBlockMode getASTCBlockMode (deUint32 blockModeData)
 		const bool	zeroDH		= getBits(blockModeData, 0, 1) == 0 && getBits(blockModeData, 7, 8) == 2;
 		const bool	h			= zeroDH ? 0 : isBitSet(blockModeData, 9);
 		blockMode.isDualPlane	= zeroDH ? 0 : isBitSet(blockModeData, 10);
+		blockMode.weightGridDepth	= 1;
+		blockMode.weightISEParams	= decodeWeightISEParams(r, h);
+	}
+	blockMode.isError = false;
+	return blockMode;
+}
+// 3D block modes only differ from 2D in how the weight grid dimensions are packed.
+ASTCBlockMode decodeASTCBlockMode3D (deUint32 blockModeData)
+{
+	ASTCBlockMode blockMode;
+	blockMode.isError = true; // \note Set to false later, if not error.
+	blockMode.isVoidExtent = getBits(blockModeData, 0, 8) == 0x1fc;
+	if (!blockMode.isVoidExtent)
+	{
+		if (getBits(blockModeData, 0, 3) == 0)
+			return blockMode; // Invalid ("reserved").
+		const deUint32	a	= getBits(blockModeData, 5, 6);
+		deUint32		r	= (deUint32)-1; // \note Set in the following branches.
+		bool			h	= isBitSet(blockModeData, 9);
+		blockMode.isDualPlane = isBitSet(blockModeData, 10);
+		if (getBits(blockModeData, 0, 1) != 0)
+		{
+			r = (getBits(blockModeData, 0, 1) << 1) | getBit(blockModeData, 4);
+			blockMode.weightGridWidth	= a + 2;
+			blockMode.weightGridHeight	= getBits(blockModeData, 7, 8) + 2;
+			blockMode.weightGridDepth	= getBits(blockModeData, 2, 3) + 2;
+		}
+		else
 		{
-			ISEMode&	m	= blockMode.weightISEParams.mode;
-			int&		b	= blockMode.weightISEParams.numBits;
-			m = ISEMODE_PLAIN_BIT;
-			b = 0;
-			if (h)
+			const deUint32 b	= getBits(blockModeData, 9, 10);
+			const deUint32 i78	= getBits(blockModeData, 7, 8);
+			r = (getBits(blockModeData, 2, 3) << 1) | getBit(blockModeData, 4);
+			if (i78 != 3)
 			{
-				switch (r)
-				{
-				case 2:							m = ISEMODE_QUINT;	b = 1;	break;
-				case 3:		m = ISEMODE_TRIT;						b = 2;	break;
-				case 4:												b = 4;	break;
-				case 5:							m = ISEMODE_QUINT;	b = 2;	break;
-				case 6:		m = ISEMODE_TRIT;						b = 3;	break;
-				case 7:												b = 5;	break;
-				default:	DE_ASSERT(false);
-				}
+				h = false;
+				blockMode.isDualPlane = false;
 			}
-			else
+			switch (i78)
 			{
-				switch (r)
-				{
-				case 2:												b = 1;	break;
-				case 3:		m = ISEMODE_TRIT;								break;
-				case 4:												b = 2;	break;
-				case 5:							m = ISEMODE_QUINT;			break;
-				case 6:		m = ISEMODE_TRIT;						b = 1;	break;
-				case 7:												b = 3;	break;
-				default:	DE_ASSERT(false);
-				}
+			case 0:		blockMode.weightGridWidth = 6;		blockMode.weightGridHeight = b + 2;	blockMode.weightGridDepth = a + 2;	break;
+			case 1:		blockMode.weightGridWidth = a + 2;	blockMode.weightGridHeight = 6;		blockMode.weightGridDepth = b + 2;	break;
+			case 2:		blockMode.weightGridWidth = a + 2;	blockMode.weightGridHeight = b + 2;	blockMode.weightGridDepth = 6;		break;
+			default:
+				if (a == 3)
+					return blockMode; // Invalid ("reserved").
+				blockMode.weightGridWidth	= a == 0 ? 6 : 2;
+				blockMode.weightGridHeight	= a == 1 ? 6 : 2;
+				blockMode.weightGridDepth	= a == 2 ? 6 : 2;
+				break;
 			}
 		}
+		blockMode.weightISEParams = decodeWeightISEParams(r, h);
 	}
 	blockMode.isError = false;
 	return blockMode;
 }
-inline void setASTCErrorColorBlock (void* dst, int blockWidth, int blockHeight, bool isSRGB)
+// Output is packed 32 bit BGRA8 (pack32RGBA8) for both UNORM and sRGB, error color is magenta.
+// Everything from here on that touches texels is templated on the block footprint, so the
+// texel loops unroll and the scratch arrays are sized exactly for each of the 2D and 3D footprints.
+// Texels are stored x fastest, then y, then z.
+template<int NumTexels>
+inline void fillTexels (deUint32* dst, deUint32 color)
 {
-	if (isSRGB)
+	int i = 0;
+#if ASTC_DECOMP_SSE2
+	const __m128i color4 = _mm_set1_epi32((int)color);
+	for (; i + 4 <= NumTexels; i += 4)
+		_mm_storeu_si128((__m128i*)(dst + i), color4);
+#endif
+	for (; i < NumTexels; i++)
+		dst[i] = color;
+}
+// The float and half block decodes take the same path with RGBA float or half texels, each channel of the
+// packed BGRA8 converted by table as it is written.
+template<typename Texel>
+struct LDRTexelTraits
+{
+	enum
+	{
+		TEXEL_SIZE = 4
+	};
+};
+template<>
+struct LDRTexelTraits<deUint32>
+{
+	enum
+	{
+		TEXEL_SIZE = 1
+	};
+};
+inline const float* ldrColorTable (bool isSRGB, const float*)
+{
+	return isSRGB ? SRGBToLinearTable() : UNorm8ToFloatTable();
+}
+inline const deUint16* ldrColorTable (bool isSRGB, const deUint16*)
+{
+	return isSRGB ? SRGBToLinearHalfTable() : UNorm8ToHalfTable();
+}
+inline const float* ldrAlphaTable (const float*)
+{
+	return UNorm8ToFloatTable();
+}
+inline const deUint16* ldrAlphaTable (const deUint16*)
+{
+	return UNorm8ToHalfTable();
+}
+template<bool IsSRGB, typename Texel>
+class LDRTexelWriter
+{
+public:
+	LDRTexelWriter (void)
+		: m_color	(ldrColorTable(IsSRGB, (const Texel*)nullptr))
+		, m_alpha	(ldrAlphaTable((const Texel*)nullptr))
 	{
-		deUint8* const dstU = (deUint8*)dst;
-		for (int i = 0; i < blockWidth*blockHeight; i++)
-		{
-			dstU[4*i + 0] = 0xff;
-			dstU[4*i + 1] = 0;
-			dstU[4*i + 2] = 0xff;
-			dstU[4*i + 3] = 0xff;
-		}
 	}
-	else
+	void store (Texel* dst, deUint32 bgra) const
 	{
-		float* const dstF = (float*)dst;
-		for (int i = 0; i < blockWidth*blockHeight; i++)
-		{
-			dstF[4*i + 0] = 1.0f;
-			dstF[4*i + 1] = 0.0f;
-			dstF[4*i + 2] = 1.0f;
-			dstF[4*i + 3] = 1.0f;
-		}
+		dst[0] = m_color[(bgra >> 16) & 0xff];
+		dst[1] = m_color[(bgra >> 8) & 0xff];
+		dst[2] = m_color[bgra & 0xff];
+		dst[3] = m_alpha[bgra >> 24];
+	}
+#if ASTC_DECOMP_SSE2
+	void store4 (Texel* dst, __m128i bgra4) const
+	{
+		deUint32 bgra[4];
+		_mm_storeu_si128((__m128i*)bgra, bgra4);
+		for (int i = 0; i < 4; i++)
+			store(dst + i*4, bgra[i]);
+	}
+#endif
+private:
+	const Texel*	m_color;
+	const Texel*	m_alpha;
+};
+template<bool IsSRGB>
+class LDRTexelWriter<IsSRGB, deUint32>
+{
+public:
+	void store (deUint32* dst, deUint32 bgra) const
+	{
+		*dst = bgra;
+	}
+#if ASTC_DECOMP_SSE2
+	void store4 (deUint32* dst, __m128i bgra4) const
+	{
+		_mm_storeu_si128((__m128i*)dst, bgra4);
+	}
+#endif
+};
+template<int NumTexels, bool IsSRGB, typename Texel>
+inline void fillTexels (Texel* dst, deUint32 color)
+{
+	Texel texel[4];
+	LDRTexelWriter<IsSRGB, Texel>().store(texel, color);
+	for (int i = 0; i < NumTexels; i++)
+		memcpy(dst + i*4, texel, sizeof(texel));
+}
+template<int NumTexels, bool IsSRGB>
+inline void fillTexels (deUint32* dst, deUint32 color)
+{
+	fillTexels<NumTexels>(dst, color);
+}
+template<int BlockWidth, int BlockHeight, int BlockDepth, bool IsSRGB, typename Texel>
+inline void setASTCErrorColorBlock (Texel* dst)
+{
+	fillTexels<BlockWidth*BlockHeight*BlockDepth, IsSRGB>(dst, pack32RGBA8(0xff, 0, 0xff, 0xff));
+}
+// Void-extent coordinates are 13 bits per axis in 2D blocks and 9 bits per axis (with an extra R pair) in 3D blocks.
+template<int BlockDepth>
+bool isVoidExtentValid (const Block128& blockData)
+{
+	if (BlockDepth == 1)
+	{
+		const deUint32	minSExtent			= blockData.getBits(12, 24);
+		const deUint32	maxSExtent			= blockData.getBits(25, 37);
+		const deUint32	minTExtent			= blockData.getBits(38, 50);
+		const deUint32	maxTExtent			= blockData.getBits(51, 63);
+		const bool		allExtentsAllOnes	= minSExtent == 0x1fff && maxSExtent == 0x1fff && minTExtent == 0x1fff && maxTExtent == 0x1fff;
+		return allExtentsAllOnes || (minSExtent < maxSExtent && minTExtent < maxTExtent);
 	}
+	const deUint32	minSExtent			= blockData.getBits(10, 18);
+	const deUint32	maxSExtent			= blockData.getBits(19, 27);
+	const deUint32	minTExtent			= blockData.getBits(28, 36);
+	const deUint32	maxTExtent			= blockData.getBits(37, 45);
+	const deUint32	minRExtent			= blockData.getBits(46, 54);
+	const deUint32	maxRExtent			= blockData.getBits(55, 63);
+	const bool		allExtentsAllOnes	= minSExtent == 0x1ff && maxSExtent == 0x1ff && minTExtent == 0x1ff && maxTExtent == 0x1ff &&
+																			minRExtent == 0x1ff && maxRExtent == 0x1ff;
+	return allExtentsAllOnes || (minSExtent < maxSExtent && minTExtent < maxTExtent && minRExtent < maxRExtent);
 }
-DecompressResult decodeVoidExtentBlock (void* dst, const Block128& blockData, int blockWidth, int blockHeight, bool isSRGB, bool isLDRMode)
+template<int BlockWidth, int BlockHeight, int BlockDepth, bool IsSRGB, typename Texel>
+DecompressResult decodeVoidExtentBlock (Texel* dst, const Block128& blockData, bool isLDRMode)
 {
-	const deUint32	minSExtent			= blockData.getBits(12, 24);
-	const deUint32	maxSExtent			= blockData.getBits(25, 37);
-	const deUint32	minTExtent			= blockData.getBits(38, 50);
-	const deUint32	maxTExtent			= blockData.getBits(51, 63);
-	const bool		allExtentsAllOnes	= minSExtent == 0x1fff && maxSExtent == 0x1fff && minTExtent == 0x1fff && maxTExtent == 0x1fff;
-	const bool		isHDRBlock			= blockData.isBitSet(9);
-	if ((isLDRMode && isHDRBlock) || (!allExtentsAllOnes && (minSExtent >= maxSExtent || minTExtent >= maxTExtent)))
+	const bool isHDRBlock = blockData.isBitSet(9);
+	if ((isLDRMode && isHDRBlock) || !isVoidExtentValid<BlockDepth>(blockData))
 	{
-		setASTCErrorColorBlock(dst, blockWidth, blockHeight, isSRGB);
+		setASTCErrorColorBlock<BlockWidth, BlockHeight, BlockDepth, IsSRGB>(dst);
 		return DECOMPRESS_RESULT_ERROR;
 	}
 	const deUint32 rgba[4] =
@@ -600,37 +799,9 @@ DecompressResult decodeVoidExtentBlock (void* dst, const Block128& blockData, in
 					blockData.getBits(96,  111),
 					blockData.getBits(112, 127)
 			};
-	if (isSRGB)
-	{
-		deUint8* const dstU = (deUint8*)dst;
-		for (int i = 0; i < blockWidth*blockHeight; i++)
-			for (int c = 0; c < 4; c++)
-				dstU[i*4 + c] = (deUint8)((rgba[c] & 0xff00) >> 8);
-	}
-	else
-	{
-		float* const dstF = (float*)dst;
-		if (isHDRBlock)
-		{
-			// rg - REMOVING HDR SUPPORT FOR NOW
-#if 0
-			for (int c = 0; c < 4; c++)
-			{
-				if (isFloat16InfOrNan((deFloat16)rgba[c]))
-					throw InternalError("Infinity or NaN color component in HDR void extent block in ASTC texture (behavior undefined by ASTC specification)");
-			}
-			for (int i = 0; i < blockWidth*blockHeight; i++)
-			for (int c = 0; c < 4; c++)
-				dstF[i*4 + c] = deFloat16To32((deFloat16)rgba[c]);
-#endif
-		}
-		else
-		{
-			for (int i = 0; i < blockWidth*blockHeight; i++)
-				for (int c = 0; c < 4; c++)
-					dstF[i*4 + c] = rgba[c] == 65535 ? 1.0f : (float)rgba[c] / 65536.0f;
-		}
-	}
+	// rg - REMOVING HDR SUPPORT FOR NOW, HDR blocks are rejected above.
+	// LDR (UNORM and sRGB alike) is the top byte of the 16 bit color.
+	fillTexels<BlockWidth*BlockHeight*BlockDepth, IsSRGB>(dst, pack32RGBA8((deUint8)(rgba[0] >> 8), (deUint8)(rgba[1] >> 8), (deUint8)(rgba[2] >> 8), (deUint8)(rgba[3] >> 8)));
 	return DECOMPRESS_RESULT_VALID_BLOCK;
 }
 void decodeColorEndpointModes (deUint32* endpointModesDst, const Block128& blockData, int numPartitions, int extraCemBitsStart)
@@ -667,33 +838,14 @@ int computeNumColorEndpointValues (const deUint32* endpointModes, int numPartiti
 		result += computeNumColorEndpointValues(endpointModes[i]);
 	return result;
 }
+// Trit and quint blocks are read from the stream in one go, the packed T/Q bits are
+// gathered with fixed shifts and the values come straight out of the decode tables.
 void decodeISETritBlock (ISEDecodedResult* dst, int numValues, BitAccessStream& data, int numBits)
 {
 			DE_ASSERT(basisu::inRange(numValues, 1, 5));
-	deUint32 m[5];
-	m[0]			= data.getNext(numBits);
-	deUint32 T01	= data.getNext(2);
-	m[1]			= data.getNext(numBits);
-	deUint32 T23	= data.getNext(2);
-	m[2]			= data.getNext(numBits);
-	deUint32 T4		= data.getNext(1);
-	m[3]			= data.getNext(numBits);
-	deUint32 T56	= data.getNext(2);
-	m[4]			= data.getNext(numBits);
-	deUint32 T7		= data.getNext(1);
-	switch (numValues)
-	{
-		// \note Fall-throughs.
-	case 1: T23		= 0;
-	case 2: T4		= 0;
-	case 3: T56		= 0;
-	case 4: T7		= 0;
-	case 5: break;
-	default:
-				DE_ASSERT(false);
-	}
-	const deUint32 T = (T7 << 7) | (T56 << 5) | (T4 << 4) | (T23 << 2) | (T01 << 0);
-	static const deUint32 tritsFromT[256][5] =
+	// T bits that are zeroed when the block holds fewer than 5 values.
+	static const deUint32 tritMask[6] = { 0, 0x03, 0x0f, 0x1f, 0x7f, 0xff };
+	static const deUint8 tritsFromT[256][5] =
 			{
 					{ 0,0,0,0,0 }, { 1,0,0,0,0 }, { 2,0,0,0,0 }, { 0,0,2,0,0 }, { 0,1,0,0,0 }, { 1,1,0,0,0 }, { 2,1,0,0,0 }, { 1,0,2,0,0 }, { 0,2,0,0,0 }, { 1,2,0,0,0 }, { 2,2,0,0,0 }, { 2,0,2,0,0 }, { 0,2,2,0,0 }, { 1,2,2,0,0 }, { 2,2,2,0,0 }, { 2,0,2,0,0 },
 					{ 0,0,1,0,0 }, { 1,0,1,0,0 }, { 2,0,1,0,0 }, { 0,1,2,0,0 }, { 0,1,1,0,0 }, { 1,1,1,0,0 }, { 2,1,1,0,0 }, { 1,1,2,0,0 }, { 0,2,1,0,0 }, { 1,2,1,0,0 }, { 2,2,1,0,0 }, { 2,1,2,0,0 }, { 0,0,0,2,2 }, { 1,0,0,2,2 }, { 2,0,0,2,2 }, { 0,0,2,2,2 },
@@ -712,35 +864,33 @@ void decodeISETritBlock (ISEDecodedResult* dst, int numValues, BitAccessStream&
 					{ 0,0,0,1,2 }, { 1,0,0,1,2 }, { 2,0,0,1,2 }, { 0,0,2,1,2 }, { 0,1,0,1,2 }, { 1,1,0,1,2 }, { 2,1,0,1,2 }, { 1,0,2,1,2 }, { 0,2,0,1,2 }, { 1,2,0,1,2 }, { 2,2,0,1,2 }, { 2,0,2,1,2 }, { 0,2,2,1,2 }, { 1,2,2,1,2 }, { 2,2,2,1,2 }, { 2,0,2,1,2 },
 					{ 0,0,1,1,2 }, { 1,0,1,1,2 }, { 2,0,1,1,2 }, { 0,1,2,1,2 }, { 0,1,1,1,2 }, { 1,1,1,1,2 }, { 2,1,1,1,2 }, { 1,1,2,1,2 }, { 0,2,1,1,2 }, { 1,2,1,1,2 }, { 2,2,1,1,2 }, { 2,1,2,1,2 }, { 0,2,2,2,2 }, { 1,2,2,2,2 }, { 2,2,2,2,2 }, { 2,1,2,2,2 }
 			};
-	const deUint32 (& trits)[5] = tritsFromT[T];
+	const int		blockBits	= 5*numBits + 8;
+	const deUint64	lo			= data.getNext(basisu::min(blockBits, 32));
+	const deUint64	bits		= lo | ((deUint64)data.getNext(basisu::max(blockBits - 32, 0)) << 32);
+	const deUint32	mMask		= (1u << numBits) - 1;
+	const deUint32	T			= ((deUint32)(bits >> (  numBits    )) & 3)
+								| ((deUint32)(bits >> (2*numBits + 2)) & 3) << 2
+								| ((deUint32)(bits >> (3*numBits + 4)) & 1) << 4
+								| ((deUint32)(bits >> (4*numBits + 5)) & 3) << 5
+								| ((deUint32)(bits >> (5*numBits + 7)) & 1) << 7;
+	const deUint32	m[5]		=
+			{
+					(deUint32)(bits						) & mMask,
+					(deUint32)(bits >> (  numBits + 2)) & mMask,
+					(deUint32)(bits >> (2*numBits + 4)) & mMask,
+					(deUint32)(bits >> (3*numBits + 5)) & mMask,
+					(deUint32)(bits >> (4*numBits + 7)) & mMask
+			};
+	const deUint8 (& trits)[5] = tritsFromT[T & tritMask[numValues]];
 	for (int i = 0; i < numValues; i++)
-	{
-		dst[i].m	= m[i];
-		dst[i].tq	= trits[i];
-		dst[i].v	= (trits[i] << numBits) + m[i];
-	}
+		dst[i].v = ((deUint32)trits[i] << numBits) | m[i];
 }
 void decodeISEQuintBlock (ISEDecodedResult* dst, int numValues, BitAccessStream& data, int numBits)
 {
 			DE_ASSERT(basisu::inRange(numValues, 1, 3));
-	deUint32 m[3];
-	m[0]			= data.getNext(numBits);
-	deUint32 Q012	= data.getNext(3);
-	m[1]			= data.getNext(numBits);
-	deUint32 Q34	= data.getNext(2);
-	m[2]			= data.getNext(numBits);
-	deUint32 Q56	= data.getNext(2);
-	switch (numValues)
-	{
-		// \note Fall-throughs.
-	case 1: Q34		= 0;
-	case 2: Q56		= 0;
-	case 3: break;
-	default:
-				DE_ASSERT(false);
-	}
-	const deUint32 Q = (Q56 << 5) | (Q34 << 3) | (Q012 << 0);
-	static const deUint32 quintsFromQ[256][3] =
+	// Q bits that are zeroed when the block holds fewer than 3 values.
+	static const deUint32 quintMask[4] = { 0, 0x07, 0x1f, 0x7f };
+	static const deUint8 quintsFromQ[128][3] =
 			{
 					{ 0,0,0 }, { 1,0,0 }, { 2,0,0 }, { 3,0,0 }, { 4,0,0 }, { 0,4,0 }, { 4,4,0 }, { 4,4,4 }, { 0,1,0 }, { 1,1,0 }, { 2,1,0 }, { 3,1,0 }, { 4,1,0 }, { 1,4,0 }, { 4,4,1 }, { 4,4,4 },
 					{ 0,2,0 }, { 1,2,0 }, { 2,2,0 }, { 3,2,0 }, { 4,2,0 }, { 2,4,0 }, { 4,4,2 }, { 4,4,4 }, { 0,3,0 }, { 1,3,0 }, { 2,3,0 }, { 3,3,0 }, { 4,3,0 }, { 3,4,0 }, { 4,4,3 }, { 4,4,4 },
@@ -751,18 +901,24 @@ void decodeISEQuintBlock (ISEDecodedResult* dst, int numValues, BitAccessStream&
 					{ 0,0,3 }, { 1,0,3 }, { 2,0,3 }, { 3,0,3 }, { 4,0,3 }, { 0,4,3 }, { 0,0,4 }, { 1,0,4 }, { 0,1,3 }, { 1,1,3 }, { 2,1,3 }, { 3,1,3 }, { 4,1,3 }, { 1,4,3 }, { 0,1,4 }, { 1,1,4 },
 					{ 0,2,3 }, { 1,2,3 }, { 2,2,3 }, { 3,2,3 }, { 4,2,3 }, { 2,4,3 }, { 0,2,4 }, { 1,2,4 }, { 0,3,3 }, { 1,3,3 }, { 2,3,3 }, { 3,3,3 }, { 4,3,3 }, { 3,4,3 }, { 0,3,4 }, { 1,3,4 }
 			};
-	const deUint32 (& quints)[3] = quintsFromQ[Q];
+	const deUint32	bits		= data.getNext(3*numBits + 7);
+	const deUint32	mMask		= (1u << numBits) - 1;
+	const deUint32	Q			= ((bits >> (  numBits    )) & 7)
+								| ((bits >> (2*numBits + 3)) & 3) << 3
+								| ((bits >> (3*numBits + 5)) & 3) << 5;
+	const deUint32	m[3]		=
+			{
+					(bits					) & mMask,
+					(bits >> (  numBits + 3)) & mMask,
+					(bits >> (2*numBits + 5)) & mMask
+			};
+	const deUint8 (& quints)[3] = quintsFromQ[Q & quintMask[numValues]];
 	for (int i = 0; i < numValues; i++)
-	{
-		dst[i].m	= m[i];
-		dst[i].tq	= quints[i];
-		dst[i].v	= (quints[i] << numBits) + m[i];
-	}
+		dst[i].v = ((deUint32)quints[i] << numBits) | m[i];
 }
 inline void decodeISEBitBlock (ISEDecodedResult* dst, BitAccessStream& data, int numBits)
 {
-	dst[0].m = data.getNext(numBits);
-	dst[0].v = dst[0].m;
+	dst[0].v = data.getNext(numBits);
 }
 void decodeISE (ISEDecodedResult* dst, int numValues, BitAccessStream& data, const ISEParams& params)
 {
@@ -791,7 +947,8 @@ void decodeISE (ISEDecodedResult* dst, int numValues, BitAccessStream& data, con
 			decodeISEBitBlock(&dst[i], data, params.numBits);
 	}
 }
-void unquantizeColorEndpoints (deUint32* dst, const ISEDecodedResult* iseResults, int numEndpoints, const ISEParams& iseParams)
+// Unquantizes a single ISE encoded color endpoint value. Only used to build the tables below.
+deUint32 computeUnquantizedColorEndpoint (deUint32 v, const ISEParams& iseParams)
 {
 	if (iseParams.mode == ISEMODE_TRIT || iseParams.mode == ISEMODE_QUINT)
 	{
@@ -799,37 +956,146 @@ void unquantizeColorEndpoints (deUint32* dst, const ISEDecodedResult* iseResults
 				DE_ASSERT(basisu::inRange(rangeCase, 0, 10));
 		static const deUint32	Ca[11]	= { 204, 113, 93, 54, 44, 26, 22, 13, 11, 6, 5 };
 		const deUint32			C		= Ca[rangeCase];
-		for (int endpointNdx = 0; endpointNdx < numEndpoints; endpointNdx++)
+		const deUint32			m		= v & ((1u << iseParams.numBits) - 1);
+		const deUint32			tq		= v >> iseParams.numBits;
+		const deUint32 a = getBit(m, 0);
+		const deUint32 b = getBit(m, 1);
+		const deUint32 c = getBit(m, 2);
+		const deUint32 d = getBit(m, 3);
+		const deUint32 e = getBit(m, 4);
+		const deUint32 f = getBit(m, 5);
+		const deUint32 A = a == 0 ? 0 : (1<<9)-1;
+		const deUint32 B = rangeCase == 0	? 0
+										 : rangeCase == 1	? 0
+										 : rangeCase == 2	? (b << 8) |									(b << 4) |				(b << 2) |	(b << 1)
+										 : rangeCase == 3	? (b << 8) |												(b << 3) |	(b << 2)
+										 : rangeCase == 4	? (c << 8) | (b << 7) |										(c << 3) |	(b << 2) |	(c << 1) |	(b << 0)
+										 : rangeCase == 5	? (c << 8) | (b << 7) |													(c << 2) |	(b << 1) |	(c << 0)
+										 : rangeCase == 6	? (d << 8) | (c << 7) | (b << 6) |										(d << 2) |	(c << 1) |	(b << 0)
+										 : rangeCase == 7	? (d << 8) | (c << 7) | (b << 6) |													(d << 1) |	(c << 0)
+										 : rangeCase == 8	? (e << 8) | (d << 7) | (c << 6) | (b << 5) |										(e << 1) |	(d << 0)
+										 : rangeCase == 9	? (e << 8) | (d << 7) | (c << 6) | (b << 5) |													(e << 0)
+										 : rangeCase == 10	? (f << 8) | (e << 7) | (d << 6) | (c << 5) |	(b << 4) |										(f << 0)
+										 : (deUint32)-1;
+				DE_ASSERT(B != (deUint32)-1);
+		return (((tq*C + B) ^ A) >> 2) | (A & 0x80);
+	}
+	else
+	{
+				DE_ASSERT(iseParams.mode == ISEMODE_PLAIN_BIT);
+		return bitReplicationScale(v, iseParams.numBits, 8);
+	}
+}
+// Unquantizes a single ISE encoded weight to 0..64. Only used to build the tables below.
+deUint32 computeUnquantizedWeight (deUint32 v, const ISEParams& iseParams)
+{
+	deUint32 w;
+	if (iseParams.mode == ISEMODE_TRIT || iseParams.mode == ISEMODE_QUINT)
+	{
+		const int rangeCase = iseParams.numBits*2 + (iseParams.mode == ISEMODE_QUINT ? 1 : 0);
+		if (rangeCase == 0 || rangeCase == 1)
+		{
+			static const deUint32 map0[3]	= { 0, 32, 63 };
+			static const deUint32 map1[5]	= { 0, 16, 32, 47, 63 };
+					DE_ASSERT(v < (rangeCase == 0 ? 3u : 5u));
+			w = rangeCase == 0 ? map0[v] : map1[v];
+		}
+		else
 		{
-			const deUint32 a = getBit(iseResults[endpointNdx].m, 0);
-			const deUint32 b = getBit(iseResults[endpointNdx].m, 1);
-			const deUint32 c = getBit(iseResults[endpointNdx].m, 2);
-			const deUint32 d = getBit(iseResults[endpointNdx].m, 3);
-			const deUint32 e = getBit(iseResults[endpointNdx].m, 4);
-			const deUint32 f = getBit(iseResults[endpointNdx].m, 5);
-			const deUint32 A = a == 0 ? 0 : (1<<9)-1;
-			const deUint32 B = rangeCase == 0	? 0
-																				 : rangeCase == 1	? 0
-																													 : rangeCase == 2	? (b << 8) |									(b << 4) |				(b << 2) |	(b << 1)
-																																						 : rangeCase == 3	? (b << 8) |												(b << 3) |	(b << 2)
-																																															 : rangeCase == 4	? (c << 8) | (b << 7) |										(c << 3) |	(b << 2) |	(c << 1) |	(b << 0)
-																																																								 : rangeCase == 5	? (c << 8) | (b << 7) |													(c << 2) |	(b << 1) |	(c << 0)
-																																																																	 : rangeCase == 6	? (d << 8) | (c << 7) | (b << 6) |										(d << 2) |	(c << 1) |	(b << 0)
-																																																																										 : rangeCase == 7	? (d << 8) | (c << 7) | (b << 6) |													(d << 1) |	(c << 0)
-																																																																																			 : rangeCase == 8	? (e << 8) | (d << 7) | (c << 6) | (b << 5) |										(e << 1) |	(d << 0)
-																																																																																												 : rangeCase == 9	? (e << 8) | (d << 7) | (c << 6) | (b << 5) |													(e << 0)
-																																																																																																					 : rangeCase == 10	? (f << 8) | (e << 7) | (d << 6) | (c << 5) |	(b << 4) |										(f << 0)
-																																																																																																															: (deUint32)-1;
-					DE_ASSERT(B != (deUint32)-1);
-			dst[endpointNdx] = (((iseResults[endpointNdx].tq*C + B) ^ A) >> 2) | (A & 0x80);
+					DE_ASSERT(rangeCase <= 6);
+			static const deUint32	Ca[5]	= { 50, 28, 23, 13, 11 };
+			const deUint32			C		= Ca[rangeCase-2];
+			const deUint32			m		= v & ((1u << iseParams.numBits) - 1);
+			const deUint32			tq		= v >> iseParams.numBits;
+			const deUint32 a = getBit(m, 0);
+			const deUint32 b = getBit(m, 1);
+			const deUint32 c = getBit(m, 2);
+			const deUint32 A = a == 0 ? 0 : (1<<7)-1;
+			const deUint32 B = rangeCase == 2 ? 0
+											: rangeCase == 3 ? 0
+											: rangeCase == 4 ? (b << 6) |					(b << 2) |				(b << 0)
+											: rangeCase == 5 ? (b << 6) |								(b << 1)
+											: rangeCase == 6 ? (c << 6) | (b << 5) |					(c << 1) |	(b << 0)
+											: (deUint32)-1;
+			w = (((tq*C + B) ^ A) >> 2) | (A & 0x20);
 		}
 	}
 	else
 	{
 				DE_ASSERT(iseParams.mode == ISEMODE_PLAIN_BIT);
-		for (int endpointNdx = 0; endpointNdx < numEndpoints; endpointNdx++)
-			dst[endpointNdx] = bitReplicationScale(iseResults[endpointNdx].v, iseParams.numBits, 8);
+		w = bitReplicationScale(v, iseParams.numBits, 6);
+	}
+	return w + (w > 32 ? 1 : 0);
+}
+// Everything that only depends on a few header bits is decoded once, up front, so the per block
+// work is a handful of table lookups instead of data dependent branches.
+struct ASTCDecodeTables
+{
+	enum
+	{
+		MAX_ISE_BITS = 8
+	};
+	ASTCBlockMode	blockModes[2][2048];										//!< [is3D][block mode bits [0,10]]
+	deUint8			colorEndpointUnquant[ISEMODE_LAST][MAX_ISE_BITS+1][256];	//!< [mode][numBits][v]
+	deUint8			weightUnquant[ISEMODE_LAST][MAX_ISE_BITS+1][64];			//!< [mode][numBits][v]
+	deInt16			numWeightDataBits[2][2048];									//!< [is3D][block mode bits [0,10]], 0 if error or void-extent.
+	deUint16		lnsMantissaToHalf[2048];									//!< HDR: 11 bit LNS mantissa to the 10 bit half mantissa.
+	ASTCDecodeTables (void)
+	{
+		for (deUint32 i = 0; i < DE_LENGTH_OF_ARRAY(blockModes[0]); i++)
+		{
+			blockModes[0][i] = decodeASTCBlockMode(i);
+			blockModes[1][i] = decodeASTCBlockMode3D(i);
+			for (int is3D = 0; is3D < 2; is3D++)
+			{
+				const ASTCBlockMode& mode = blockModes[is3D][i];
+				numWeightDataBits[is3D][i] = (deInt16)(mode.isError || mode.isVoidExtent ? 0 :
+						computeNumRequiredBits(mode.weightISEParams, computeNumWeights(mode)));
+			}
+		}
+		for (deUint32 m = 0; m < DE_LENGTH_OF_ARRAY(lnsMantissaToHalf); m++)
+		{
+			const deUint32 mt = m < 512		? 3*m
+											: m >= 1536		? 5*m - 2048
+											:				  4*m - 512;
+			lnsMantissaToHalf[m] = (deUint16)(mt >> 3);
+		}
+		memset(colorEndpointUnquant, 0, sizeof(colorEndpointUnquant));
+		memset(weightUnquant, 0, sizeof(weightUnquant));
+		// Color endpoints use trits with 1-6 bits, quints with 1-5 bits or 1-8 plain bits.
+		// Weights use trits with 0-3 bits, quints with 0-2 bits or 1-5 plain bits.
+		static const int maxEndpointBits[ISEMODE_LAST]	= { 6, 5, 8 };
+		static const int minWeightBits[ISEMODE_LAST]	= { 0, 0, 1 };
+		static const int maxWeightBits[ISEMODE_LAST]	= { 3, 2, 5 };
+		static const int levelsPerBit[ISEMODE_LAST]		= { 3, 5, 1 };
+		for (int mode = 0; mode < ISEMODE_LAST; mode++)
+		{
+			for (int numBits = 1; numBits <= maxEndpointBits[mode]; numBits++)
+			{
+				const ISEParams params((ISEMode)mode, numBits);
+				for (deUint32 v = 0; v < (deUint32)(levelsPerBit[mode] << numBits); v++)
+					colorEndpointUnquant[mode][numBits][v] = (deUint8)computeUnquantizedColorEndpoint(v, params);
+			}
+			for (int numBits = minWeightBits[mode]; numBits <= maxWeightBits[mode]; numBits++)
+			{
+				const ISEParams params((ISEMode)mode, numBits);
+				for (deUint32 v = 0; v < (deUint32)(levelsPerBit[mode] << numBits); v++)
+					weightUnquant[mode][numBits][v] = (deUint8)computeUnquantizedWeight(v, params);
+			}
+		}
 	}
+};
+static const ASTCDecodeTables s_decodeTables;
+inline const ASTCBlockMode& getASTCBlockMode (deUint32 blockModeData, bool is3D)
+{
+	return s_decodeTables.blockModes[is3D ? 1 : 0][blockModeData & 0x7ff];
+}
+void unquantizeColorEndpoints (deUint32* dst, const ISEDecodedResult* iseResults, int numEndpoints, const ISEParams& iseParams)
+{
+			DE_ASSERT(iseParams.numBits <= ASTCDecodeTables::MAX_ISE_BITS);
+	const deUint8* const table = s_decodeTables.colorEndpointUnquant[iseParams.mode][iseParams.numBits];
+	for (int endpointNdx = 0; endpointNdx < numEndpoints; endpointNdx++)
+		dst[endpointNdx] = table[iseResults[endpointNdx].v];
 }
 inline void bitTransferSigned (deInt32& a, deInt32& b)
 {
@@ -1202,108 +1468,147 @@ void computeColorEndpoints (ColorEndpointPair* dst, const Block128& blockData, c
 }
 void unquantizeWeights (deUint32 dst[64], const ISEDecodedResult* weightGrid, const ASTCBlockMode& blockMode)
 {
-	const int			numWeights	= computeNumWeights(blockMode);
-	const ISEParams&	iseParams	= blockMode.weightISEParams;
-	if (iseParams.mode == ISEMODE_TRIT || iseParams.mode == ISEMODE_QUINT)
-	{
-		const int rangeCase = iseParams.numBits*2 + (iseParams.mode == ISEMODE_QUINT ? 1 : 0);
-		if (rangeCase == 0 || rangeCase == 1)
-		{
-			static const deUint32 map0[3]	= { 0, 32, 63 };
-			static const deUint32 map1[5]	= { 0, 16, 32, 47, 63 };
-			const deUint32* const map		= rangeCase == 0 ? &map0[0] : &map1[0];
-			for (int i = 0; i < numWeights; i++)
-			{
-						DE_ASSERT(weightGrid[i].v < (rangeCase == 0 ? 3u : 5u));
-				dst[i] = map[weightGrid[i].v];
-			}
-		}
-		else
-		{
-					DE_ASSERT(rangeCase <= 6);
-			static const deUint32	Ca[5]	= { 50, 28, 23, 13, 11 };
-			const deUint32			C		= Ca[rangeCase-2];
-			for (int weightNdx = 0; weightNdx < numWeights; weightNdx++)
-			{
-				const deUint32 a = getBit(weightGrid[weightNdx].m, 0);
-				const deUint32 b = getBit(weightGrid[weightNdx].m, 1);
-				const deUint32 c = getBit(weightGrid[weightNdx].m, 2);
-				const deUint32 A = a == 0 ? 0 : (1<<7)-1;
-				const deUint32 B = rangeCase == 2 ? 0
-																					: rangeCase == 3 ? 0
-																													 : rangeCase == 4 ? (b << 6) |					(b << 2) |				(b << 0)
-																																						: rangeCase == 5 ? (b << 6) |								(b << 1)
-																																														 : rangeCase == 6 ? (c << 6) | (b << 5) |					(c << 1) |	(b << 0)
-																																																							: (deUint32)-1;
-				dst[weightNdx] = (((weightGrid[weightNdx].tq*C + B) ^ A) >> 2) | (A & 0x20);
-			}
-		}
-	}
-	else
-	{
-				DE_ASSERT(iseParams.mode == ISEMODE_PLAIN_BIT);
-		for (int weightNdx = 0; weightNdx < numWeights; weightNdx++)
-			dst[weightNdx] = bitReplicationScale(weightGrid[weightNdx].v, iseParams.numBits, 6);
-	}
+	const int				numWeights	= computeNumWeights(blockMode);
+	const ISEParams&		iseParams	= blockMode.weightISEParams;
+	const deUint8* const	table		= s_decodeTables.weightUnquant[iseParams.mode][iseParams.numBits];
 	for (int weightNdx = 0; weightNdx < numWeights; weightNdx++)
-		dst[weightNdx] += dst[weightNdx] > 32 ? 1 : 0;
+		dst[weightNdx] = table[weightGrid[weightNdx].v];
 	// Initialize nonexistent weights to poison values
 	for (int weightNdx = numWeights; weightNdx < 64; weightNdx++)
 		dst[weightNdx] = ~0u;
 }
-void interpolateWeights (TexelWeightPair* dst, const deUint32 (&unquantizedWeights) [64], int blockWidth, int blockHeight, const ASTCBlockMode& blockMode)
+// Bilinear infill of a single weight plane from its weight grid, which is stored plane local.
+template<int BlockWidth, int BlockHeight>
+void interpolateWeightPlane (deUint8* dst, const deUint32 (&gridWeights) [64], int gridWidth, int gridHeight)
 {
-	const int		numWeightsPerTexel	= blockMode.isDualPlane ? 2 : 1;
-	const deUint32	scaleX				= (1024 + blockWidth/2) / (blockWidth-1);
-	const deUint32	scaleY				= (1024 + blockHeight/2) / (blockHeight-1);
-			DE_ASSERT(blockMode.weightGridWidth*blockMode.weightGridHeight*numWeightsPerTexel <= DE_LENGTH_OF_ARRAY(unquantizedWeights));
-	for (int texelY = 0; texelY < blockHeight; texelY++)
+	const deUint32	scaleX				= (1024 + BlockWidth/2) / (BlockWidth-1);
+	const deUint32	scaleY				= (1024 + BlockHeight/2) / (BlockHeight-1);
+			DE_ASSERT(gridWidth*gridHeight <= (int)DE_LENGTH_OF_ARRAY(gridWeights));
+	for (int texelY = 0; texelY < BlockHeight; texelY++)
 	{
-		for (int texelX = 0; texelX < blockWidth; texelX++)
+		const deUint32 gY	= (scaleY*texelY*(gridHeight-1) + 32) >> 6;
+		const deUint32 jY	= gY >> 4;
+		const deUint32 fY	= gY & 0xf;
+		for (int texelX = 0; texelX < BlockWidth; texelX++)
 		{
-			const deUint32 gX	= (scaleX*texelX*(blockMode.weightGridWidth-1) + 32) >> 6;
-			const deUint32 gY	= (scaleY*texelY*(blockMode.weightGridHeight-1) + 32) >> 6;
+			const deUint32 gX	= (scaleX*texelX*(gridWidth-1) + 32) >> 6;
 			const deUint32 jX	= gX >> 4;
-			const deUint32 jY	= gY >> 4;
 			const deUint32 fX	= gX & 0xf;
-			const deUint32 fY	= gY & 0xf;
 			const deUint32 w11	= (fX*fY + 8) >> 4;
 			const deUint32 w10	= fY - w11;
 			const deUint32 w01	= fX - w11;
 			const deUint32 w00	= 16 - fX - fY + w11;
-			const deUint32 i00	= jY*blockMode.weightGridWidth + jX;
+			const deUint32 i00	= jY*gridWidth + jX;
 			const deUint32 i01	= i00 + 1;
-			const deUint32 i10	= i00 + blockMode.weightGridWidth;
-			const deUint32 i11	= i00 + blockMode.weightGridWidth + 1;
+			const deUint32 i10	= i00 + gridWidth;
+			const deUint32 i11	= i00 + gridWidth + 1;
 			// These addresses can be out of bounds, but respective weights will be 0 then.
-					DE_ASSERT(deInBounds32(i00, 0, blockMode.weightGridWidth*blockMode.weightGridHeight) || w00 == 0);
-					DE_ASSERT(deInBounds32(i01, 0, blockMode.weightGridWidth*blockMode.weightGridHeight) || w01 == 0);
-					DE_ASSERT(deInBounds32(i10, 0, blockMode.weightGridWidth*blockMode.weightGridHeight) || w10 == 0);
-					DE_ASSERT(deInBounds32(i11, 0, blockMode.weightGridWidth*blockMode.weightGridHeight) || w11 == 0);
-			for (int texelWeightNdx = 0; texelWeightNdx < numWeightsPerTexel; texelWeightNdx++)
+					DE_ASSERT(deInBounds32(i00, 0, gridWidth*gridHeight) || w00 == 0);
+					DE_ASSERT(deInBounds32(i01, 0, gridWidth*gridHeight) || w01 == 0);
+					DE_ASSERT(deInBounds32(i10, 0, gridWidth*gridHeight) || w10 == 0);
+					DE_ASSERT(deInBounds32(i11, 0, gridWidth*gridHeight) || w11 == 0);
+			// & 0x3f clamps address to bounds of gridWeights
+			const deUint32 p00	= gridWeights[i00 & 0x3f];
+			const deUint32 p01	= gridWeights[i01 & 0x3f];
+			const deUint32 p10	= gridWeights[i10 & 0x3f];
+			const deUint32 p11	= gridWeights[i11 & 0x3f];
+			dst[texelY*BlockWidth + texelX] = (deUint8)((p00*w00 + p01*w01 + p10*w10 + p11*w11 + 8) >> 4);
+		}
+	}
+}
+// Simplex infill of a single weight plane of a 3D block, each texel blends the 4 grid corners of the
+// tetrahedron its fractional position falls in.
+template<int BlockWidth, int BlockHeight, int BlockDepth>
+void interpolateWeightVolume (deUint8* dst, const deUint32 (&gridWeights) [64], int gridWidth, int gridHeight, int gridDepth)
+{
+	const deUint32	scaleX		= (1024 + BlockWidth/2) / (BlockWidth-1);
+	const deUint32	scaleY		= (1024 + BlockHeight/2) / (BlockHeight-1);
+	const deUint32	scaleZ		= (1024 + BlockDepth/2) / (BlockDepth > 1 ? BlockDepth-1 : 1);
+	const deUint32	strideY		= gridWidth;
+	const deUint32	strideZ		= gridWidth*gridHeight;
+			DE_ASSERT(gridWidth*gridHeight*gridDepth <= (int)DE_LENGTH_OF_ARRAY(gridWeights));
+	for (int texelZ = 0; texelZ < BlockDepth; texelZ++)
+	{
+		const deUint32 gZ	= (scaleZ*texelZ*(gridDepth-1) + 32) >> 6;
+		const deUint32 jZ	= gZ >> 4;
+		const deUint32 fZ	= gZ & 0xf;
+		for (int texelY = 0; texelY < BlockHeight; texelY++)
+		{
+			const deUint32 gY	= (scaleY*texelY*(gridHeight-1) + 32) >> 6;
+			const deUint32 jY	= gY >> 4;
+			const deUint32 fY	= gY & 0xf;
+			for (int texelX = 0; texelX < BlockWidth; texelX++)
 			{
-				// & 0x3f clamps address to bounds of unquantizedWeights
-				const deUint32 p00	= unquantizedWeights[(i00 * numWeightsPerTexel + texelWeightNdx) & 0x3f];
-				const deUint32 p01	= unquantizedWeights[(i01 * numWeightsPerTexel + texelWeightNdx) & 0x3f];
-				const deUint32 p10	= unquantizedWeights[(i10 * numWeightsPerTexel + texelWeightNdx) & 0x3f];
-				const deUint32 p11	= unquantizedWeights[(i11 * numWeightsPerTexel + texelWeightNdx) & 0x3f];
-				dst[texelY*blockWidth + texelX].w[texelWeightNdx] = (p00*w00 + p01*w01 + p10*w10 + p11*w11 + 8) >> 4;
+				const deUint32 gX	= (scaleX*texelX*(gridWidth-1) + 32) >> 6;
+				const deUint32 jX	= gX >> 4;
+				const deUint32 fX	= gX & 0xf;
+				deUint32 s1, s2, w0, w1, w2, w3;
+				if (fX > fY)
+				{
+					if (fY > fZ)		{ s1 = 1;		s2 = strideY;	w0 = 16 - fX;	w1 = fX - fY;	w2 = fY - fZ;	w3 = fZ; }
+					else if (fX > fZ)	{ s1 = 1;		s2 = strideZ;	w0 = 16 - fX;	w1 = fX - fZ;	w2 = fZ - fY;	w3 = fY; }
+					else				{ s1 = strideZ;	s2 = 1;			w0 = 16 - fZ;	w1 = fZ - fX;	w2 = fX - fY;	w3 = fY; }
+				}
+				else
+				{
+					if (fX > fZ)		{ s1 = strideY;	s2 = 1;			w0 = 16 - fY;	w1 = fY - fX;	w2 = fX - fZ;	w3 = fZ; }
+					else if (fY > fZ)	{ s1 = strideY;	s2 = strideZ;	w0 = 16 - fY;	w1 = fY - fZ;	w2 = fZ - fX;	w3 = fX; }
+					else				{ s1 = strideZ;	s2 = strideY;	w0 = 16 - fZ;	w1 = fZ - fY;	w2 = fY - fX;	w3 = fX; }
+				}
+				const deUint32 i0	= jZ*strideZ + jY*strideY + jX;
+				const deUint32 i1	= i0 + s1;
+				const deUint32 i2	= i1 + s2;
+				const deUint32 i3	= i0 + strideZ + strideY + 1;
+				// As in 2D, out of bounds addresses only ever have a 0 weight.
+				const deUint32 p0	= gridWeights[i0 & 0x3f];
+				const deUint32 p1	= gridWeights[i1 & 0x3f];
+				const deUint32 p2	= gridWeights[i2 & 0x3f];
+				const deUint32 p3	= gridWeights[i3 & 0x3f];
+				dst[(texelZ*BlockHeight + texelY)*BlockWidth + texelX] = (deUint8)((p0*w0 + p1*w1 + p2*w2 + p3*w3 + 8) >> 4);
 			}
 		}
 	}
 }
-void computeTexelWeights (TexelWeightPair* dst, const Block128& blockData, int blockWidth, int blockHeight, const ASTCBlockMode& blockMode)
+template<int BlockWidth, int BlockHeight, int BlockDepth>
+inline void interpolateWeightGrid (deUint8* dst, const deUint32 (&gridWeights) [64], const ASTCBlockMode& blockMode)
+{
+	if (BlockDepth == 1)
+		interpolateWeightPlane<BlockWidth, BlockHeight>(dst, gridWeights, blockMode.weightGridWidth, blockMode.weightGridHeight);
+	else
+		interpolateWeightVolume<BlockWidth, BlockHeight, BlockDepth>(dst, gridWeights, blockMode.weightGridWidth, blockMode.weightGridHeight, blockMode.weightGridDepth);
+}
+template<int BlockWidth, int BlockHeight, int BlockDepth>
+void computeTexelWeights (TexelWeightPlanes<BlockWidth*BlockHeight*BlockDepth>& dst, const Block128& blockData, const ASTCBlockMode& blockMode, int numWeights, int numWeightDataBits)
 {
 	ISEDecodedResult weightGrid[64];
 	{
-		BitAccessStream dataStream(blockData, 127, computeNumRequiredBits(blockMode.weightISEParams, computeNumWeights(blockMode)), false);
-		decodeISE(&weightGrid[0], computeNumWeights(blockMode), dataStream, blockMode.weightISEParams);
+		BitAccessStream dataStream(blockData, 127, numWeightDataBits, false);
+		decodeISE(&weightGrid[0], numWeights, dataStream, blockMode.weightISEParams);
 	}
+	deUint32 unquantizedWeights[64];
+	unquantizeWeights(&unquantizedWeights[0], &weightGrid[0], blockMode);
+	if (!blockMode.isDualPlane)
 	{
-		deUint32 unquantizedWeights[64];
-		unquantizeWeights(&unquantizedWeights[0], &weightGrid[0], blockMode);
-		interpolateWeights(dst, unquantizedWeights, blockWidth, blockHeight, blockMode);
+		interpolateWeightGrid<BlockWidth, BlockHeight, BlockDepth>(dst.w[0], unquantizedWeights, blockMode);
+		return;
+	}
+	// Dual plane grids interleave the two planes. Split them so each plane interpolates exactly
+	// like a single plane block instead of striding through the shared grid per texel.
+	const int	numGridWeights = blockMode.weightGridWidth*blockMode.weightGridHeight*blockMode.weightGridDepth;
+	deUint32	planeWeights[2][64];
+	for (int i = 0; i < numGridWeights; i++)
+	{
+		planeWeights[0][i] = unquantizedWeights[2*i + 0];
+		planeWeights[1][i] = unquantizedWeights[2*i + 1];
+	}
+	// Only ever read with a zero filter weight.
+	for (int i = numGridWeights; i < 64; i++)
+	{
+		planeWeights[0][i] = 0;
+		planeWeights[1][i] = 0;
 	}
+	interpolateWeightGrid<BlockWidth, BlockHeight, BlockDepth>(dst.w[0], planeWeights[0], blockMode);
+	interpolateWeightGrid<BlockWidth, BlockHeight, BlockDepth>(dst.w[1], planeWeights[1], blockMode);
 }
 inline deUint32 hash52 (deUint32 v)
 {
@@ -1315,7 +1620,6 @@ inline deUint32 hash52 (deUint32 v)
 }
 int computeTexelPartition (deUint32 seedIn, deUint32 xIn, deUint32 yIn, deUint32 zIn, int numPartitions, bool smallBlock)
 {
-			DE_ASSERT(zIn == 0);
 	const deUint32	x		= smallBlock ? xIn << 1 : xIn;
 	const deUint32	y		= smallBlock ? yIn << 1 : yIn;
 	const deUint32	z		= smallBlock ? zIn << 1 : zIn;
@@ -1371,100 +1675,403 @@ int computeTexelPartition (deUint32 seedIn, deUint32 xIn, deUint32 yIn, deUint32
 																															 : c >= d						? 2
 																																									 :								  3;
 }
-DecompressResult setTexelColors (void* dst, ColorEndpointPair* colorEndpoints, TexelWeightPair* texelWeights, int ccs, deUint32 partitionIndexSeed,
-																 int numPartitions, int blockWidth, int blockHeight, bool isSRGB, bool isLDRMode, const deUint32* colorEndpointModes)
+// LDR endpoints expand to 16 bits as (e << 8) | e, or (e << 8) | 0x80 for sRGB, and the 8 bit result
+// is the top byte of (c0*(64-w) + c1*w + 32) / 64. With s = e0*(64-w) + e1*w that is (257*s + 32) >> 14
+// for UNORM and (256*s + 8224) >> 14 for sRGB, which keeps everything in 16 bit multiplies.
+template<bool IsSRGB>
+inline deUint32 interpolateLDRChannel (deUint32 e0, deUint32 e1, deUint32 w)
 {
-	const bool			smallBlock	= blockWidth*blockHeight < 31;
-	DecompressResult	result		= DECOMPRESS_RESULT_VALID_BLOCK;
-	bool				isHDREndpoint[4];
-	for (int i = 0; i < numPartitions; i++)
+	const deUint32 s = e0*(64-w) + e1*w;
+	return ((s << 8) + (IsSRGB ? 8224 : s + 32)) >> 14;
+}
+// The LDR profile interpolates to RGBA8, packed as one deUint32 per texel or converted to RGBA float or half.
+template<bool IsSRGB, typename TexelType = deUint32>
+class LDRInterpolator
+{
+public:
+	typedef TexelType Texel;
+	enum
 	{
-		isHDREndpoint[i] = isColorEndpointModeHDR(colorEndpointModes[i]);
-
-		// rg - REMOVING HDR SUPPORT FOR NOW
-		if (isHDREndpoint[i])
-			return DECOMPRESS_RESULT_ERROR;
+		TEXEL_SIZE = LDRTexelTraits<TexelType>::TEXEL_SIZE
+	};
+	LDRInterpolator (const ColorEndpointPair* colorEndpoints, int numPartitions, int ccs)
+		: m_colorEndpoints	(colorEndpoints)
+		, m_ccs				(ccs)
+	{
+		DE_UNREF(numPartitions);
+#if ASTC_DECOMP_SSE2
+		// One madd per texel does all four channels. Endpoint pairs are interleaved (e0, e1) per
+		// channel in BGRA order so the result packs straight to the output.
+		for (int partNdx = 0; partNdx < numPartitions; partNdx++)
+		{
+			const UVec4& e0 = colorEndpoints[partNdx].e0;
+			const UVec4& e1 = colorEndpoints[partNdx].e1;
+			m_endpoints[partNdx] = _mm_setr_epi16((short)e0[2], (short)e1[2], (short)e0[1], (short)e1[1],
+																						(short)e0[0], (short)e1[0], (short)e0[3], (short)e1[3]);
+		}
+		// Dual plane blends in the second plane's weight for the ccs channel, the mask is fixed per block.
+		static const int bgraLane[4] = { 2, 1, 0, 3 };
+		m_planeMask = ccs >= 0 ? _mm_cmpeq_epi32(_mm_setr_epi32(0, 1, 2, 3), _mm_set1_epi32(bgraLane[ccs & 3])) : _mm_setzero_si128();
+#endif
 	}
-
-	for (int texelY = 0; texelY < blockHeight; texelY++)
-		for (int texelX = 0; texelX < blockWidth; texelX++)
+#if ASTC_DECOMP_SSE2
+	template<bool IsDualPlane>
+	void interpolate4 (Texel* dst, const deUint8* partitions, const deUint8* weights0, const deUint8* weights1) const
+	{
+		const __m128i rounding = _mm_set1_epi32(IsSRGB ? 8224 : 32);
+		__m128i c[4];
+		for (int i = 0; i < 4; i++)
 		{
-			const int				texelNdx			= texelY*blockWidth + texelX;
-			const int				colorEndpointNdx	= numPartitions == 1 ? 0 : computeTexelPartition(partitionIndexSeed, texelX, texelY, 0, numPartitions, smallBlock);
-					DE_ASSERT(colorEndpointNdx < numPartitions);
-			const UVec4&			e0					= colorEndpoints[colorEndpointNdx].e0;
-			const UVec4&			e1					= colorEndpoints[colorEndpointNdx].e1;
-			const TexelWeightPair&	weight				= texelWeights[texelNdx];
-			if (isLDRMode && isHDREndpoint[colorEndpointNdx])
+			const deUint32	w0		= weights0[i];
+			__m128i			w		= _mm_set1_epi32((int)((w0 << 16) | (64 - w0)));
+			if (IsDualPlane)
 			{
-				if (isSRGB)
-				{
-					((deUint8*)dst)[texelNdx*4 + 0] = 0xff;
-					((deUint8*)dst)[texelNdx*4 + 1] = 0;
-					((deUint8*)dst)[texelNdx*4 + 2] = 0xff;
-					((deUint8*)dst)[texelNdx*4 + 3] = 0xff;
-				}
-				else
-				{
-					((float*)dst)[texelNdx*4 + 0] = 1.0f;
-					((float*)dst)[texelNdx*4 + 1] = 0;
-					((float*)dst)[texelNdx*4 + 2] = 1.0f;
-					((float*)dst)[texelNdx*4 + 3] = 1.0f;
-				}
-				result = DECOMPRESS_RESULT_ERROR;
+				const deUint32	w1	= weights1[i];
+				w = _mm_or_si128(_mm_and_si128(m_planeMask, _mm_set1_epi32((int)((w1 << 16) | (64 - w1)))), _mm_andnot_si128(m_planeMask, w));
 			}
-			else
+			const __m128i	sum		= _mm_madd_epi16(m_endpoints[partitions[i]], w);
+			const __m128i	scaled	= IsSRGB ? _mm_slli_epi32(sum, 8) : _mm_add_epi32(_mm_slli_epi32(sum, 8), sum);
+			c[i] = _mm_srli_epi32(_mm_add_epi32(scaled, rounding), 14);
+		}
+		const __m128i packed = _mm_packus_epi16(_mm_packs_epi32(c[0], c[1]), _mm_packs_epi32(c[2], c[3]));
+		m_writer.store4(dst, packed);
+	}
+#endif
+	template<bool IsDualPlane>
+	void interpolate1 (Texel* dst, int partNdx, deUint32 w0, deUint32 w1) const
+	{
+		const ColorEndpointPair&	endpoints = m_colorEndpoints[partNdx];
+		deUint8						rgba[4];
+		for (int channelNdx = 0; channelNdx < 4; channelNdx++)
+			rgba[channelNdx] = (deUint8)interpolateLDRChannel<IsSRGB>(endpoints.e0[channelNdx], endpoints.e1[channelNdx], IsDualPlane && m_ccs == channelNdx ? w1 : w0);
+		m_writer.store(dst, pack32RGBA8(rgba[0], rgba[1], rgba[2], rgba[3]));
+	}
+private:
+	const ColorEndpointPair*	m_colorEndpoints;
+	int							m_ccs;
+	LDRTexelWriter<IsSRGB, TexelType>	m_writer;
+#if ASTC_DECOMP_SSE2
+	__m128i						m_endpoints[4];
+	__m128i						m_planeMask;
+#endif
+};
+// Texel interpolation shared by both profiles, the Interpolator (LDRInterpolator or HDRInterpolator)
+// supplies the endpoint expansion and the output packing. Single partition blocks (the bulk of most
+// textures) skip the partition table entirely, and single plane blocks skip the second weight plane
+// and the channel blend.
+template<int NumTexels, bool IsSinglePartition, bool IsDualPlane, class Interpolator>
+void interpolateTexels (typename Interpolator::Texel* dst, const Interpolator& interpolator, const TexelWeightPlanes<NumTexels>& texelWeights, const deUint8* texelPartitions)
+{
+	const deUint8* const	weights0	= texelWeights.w[0];
+	const deUint8* const	weights1	= texelWeights.w[IsDualPlane ? 1 : 0];
+	int						texelNdx	= 0;
+#if ASTC_DECOMP_SSE2
+	static const deUint8	noPartitions[4]	= { 0, 0, 0, 0 };
+	for (; texelNdx + 4 <= NumTexels; texelNdx += 4)
+		interpolator.template interpolate4<IsDualPlane>(dst + texelNdx*Interpolator::TEXEL_SIZE, IsSinglePartition ? noPartitions : texelPartitions + texelNdx,
+																										weights0 + texelNdx, weights1 + texelNdx);
+#endif
+	// The tail steps a texel pointer, indexing dst with texelNdx*TEXEL_SIZE let GCC assume the int multiply can't wrap
+	// and warn (-Waggressive-loop-optimizations) for footprints whose tail never runs.
+	typename Interpolator::Texel* texelDst = dst + texelNdx*Interpolator::TEXEL_SIZE;
+	for (; texelNdx < NumTexels; texelNdx++, texelDst += Interpolator::TEXEL_SIZE)
+		interpolator.template interpolate1<IsDualPlane>(texelDst, IsSinglePartition ? 0 : texelPartitions[texelNdx],
+																										weights0[texelNdx], weights1[texelNdx]);
+}
+template<int BlockWidth, int BlockHeight, int BlockDepth>
+void computeTexelPartitions (deUint8* dst, deUint32 partitionIndexSeed, int numPartitions)
+{
+	const bool smallBlock = BlockWidth*BlockHeight*BlockDepth < 31;
+	for (int texelZ = 0; texelZ < BlockDepth; texelZ++)
+		for (int texelY = 0; texelY < BlockHeight; texelY++)
+			for (int texelX = 0; texelX < BlockWidth; texelX++)
+				dst[(texelZ*BlockHeight + texelY)*BlockWidth + texelX] = (deUint8)computeTexelPartition(partitionIndexSeed, texelX, texelY, texelZ, numPartitions, smallBlock);
+}
+template<int BlockWidth, int BlockHeight, int BlockDepth, bool IsSRGB, typename Texel>
+DecompressResult setTexelColors (Texel* dst, ColorEndpointPair* colorEndpoints, const TexelWeightPlanes<BlockWidth*BlockHeight*BlockDepth>& texelWeights, int ccs, deUint32 partitionIndexSeed,
+																 int numPartitions, const deUint32* colorEndpointModes)
+{
+	enum
+	{
+		NUM_TEXELS	= BlockWidth*BlockHeight*BlockDepth
+	};
+	for (int i = 0; i < numPartitions; i++)
+	{
+		// HDR endpoints are only valid with the HDR profile, see setTexelColorsHDR.
+		if (isColorEndpointModeHDR(colorEndpointModes[i]))
+		{
+			setASTCErrorColorBlock<BlockWidth, BlockHeight, BlockDepth, IsSRGB>(dst);
+			return DECOMPRESS_RESULT_ERROR;
+		}
+	}
+	const LDRInterpolator<IsSRGB, Texel> interpolator(colorEndpoints, numPartitions, ccs);
+	if (numPartitions == 1)
+	{
+		if (ccs < 0)
+			interpolateTexels<NUM_TEXELS, true, false>(dst, interpolator, texelWeights, nullptr);
+		else
+			interpolateTexels<NUM_TEXELS, true, true>(dst, interpolator, texelWeights, nullptr);
+		return DECOMPRESS_RESULT_VALID_BLOCK;
+	}
+	deUint8 texelPartitions[NUM_TEXELS];
+	computeTexelPartitions<BlockWidth, BlockHeight, BlockDepth>(texelPartitions, partitionIndexSeed, numPartitions);
+	if (ccs < 0)
+		interpolateTexels<NUM_TEXELS, false, false>(dst, interpolator, texelWeights, texelPartitions);
+	else
+		interpolateTexels<NUM_TEXELS, false, true>(dst, interpolator, texelWeights, texelPartitions);
+	return DECOMPRESS_RESULT_VALID_BLOCK;
+}
+// HDR profile output is RGBA half floats, 4 deUint16 per texel.
+// Round to nearest even float to half, only for the finite non-negative values produced here.
+inline deUint16 floatToHalf (float f)
+{
+	deUint32 x;
+	memcpy(&x, &f, sizeof(x));
+	DE_ASSERT(x < 0x47800000u);
+	if (x < 0x38800000u)
+	{
+		// Half denormal, let the float adder do the rounding by aligning the mantissa with 0.5f.
+		float		aligned = f + 0.5f;
+		deUint32	bits;
+		memcpy(&bits, &aligned, sizeof(bits));
+		return (deUint16)(bits - 0x3f000000u);
+	}
+	const deUint32 mantissaOdd = (x >> 13) & 1;
+	x += ((deUint32)(15 - 127) << 23) + 0xfff + mantissaOdd;
+	return (deUint16)(x >> 13);
+}
+// UNORM16 results (LDR endpoints) go through float exactly as the LDR profile's float output.
+inline deUint16 unorm16ToHalf (deUint32 c)
+{
+	return c == 65535 ? 0x3c00 : floatToHalf((float)c * (1.0f / 65536.0f));
+}
+// LNS results (HDR endpoints) become halves with a table lookup for the mantissa, infinity and NaN are clamped to the max half.
+inline deUint16 lnsToHalf (deUint32 c)
+{
+	const deUint32 h = ((c >> 11) << 10) + s_decodeTables.lnsMantissaToHalf[c & 0x7ff];
+	return (deUint16)basisu::min(h, 0x7bffu);
+}
+// Halves are written as they are or, for the float block decode, as the floats they are.
+inline void storeHalf (deUint16* dst, deUint16 h)
+{
+	*dst = h;
+}
+inline void storeHalf (float* dst, deUint16 h)
+{
+	*dst = HalfToFloat(h);
+}
+template<int BlockWidth, int BlockHeight, int BlockDepth, typename Texel>
+inline void fillTexelsHDR (Texel* dst, const deUint16 rgba[4])
+{
+	Texel texel[4];
+	for (int c = 0; c < 4; c++)
+		storeHalf(texel + c, rgba[c]);
+	for (int i = 0; i < BlockWidth*BlockHeight*BlockDepth; i++)
+		memcpy(dst + i*4, texel, sizeof(texel));
+}
+// The HDR profile error color is NaN in every channel, the all ones half (a NaN float for the float block decode).
+template<int BlockWidth, int BlockHeight, int BlockDepth, typename Texel>
+inline void setASTCErrorColorBlockHDR (Texel* dst)
+{
+	static const deUint16 errorColor[4] = { 0xffff, 0xffff, 0xffff, 0xffff };
+	fillTexelsHDR<BlockWidth, BlockHeight, BlockDepth>(dst, errorColor);
+}
+template<int BlockWidth, int BlockHeight, int BlockDepth, typename Texel>
+DecompressResult decodeVoidExtentBlockHDR (Texel* dst, const Block128& blockData)
+{
+	const bool isHDRBlock = blockData.isBitSet(9);
+	if (!isVoidExtentValid<BlockDepth>(blockData))
+	{
+		setASTCErrorColorBlockHDR<BlockWidth, BlockHeight, BlockDepth>(dst);
+		return DECOMPRESS_RESULT_ERROR;
+	}
+	// HDR void-extent colors are halves already, LDR ones are UNORM16.
+	deUint16 rgba[4];
+	for (int c = 0; c < 4; c++)
+	{
+		const deUint32 v = blockData.getBits(64 + 16*c, 79 + 16*c);
+		rgba[c] = isHDRBlock ? (deUint16)v : unorm16ToHalf(v);
+	}
+	fillTexelsHDR<BlockWidth, BlockHeight, BlockDepth>(dst, rgba);
+	return DECOMPRESS_RESULT_VALID_BLOCK;
+}
+// The HDR profile interpolates to RGBA half floats, 4 deUint16 per texel. HDR endpoints are 12 bit and
+// interpolate as LNS, LDR endpoints (and the alpha of mode 14) as UNORM16, either way the interpolated
+// value is 16 bit and only the pack step differs. Texels are halves, or floats for the float block decode.
+template<typename TexelType = deUint16>
+class HDRInterpolator
+{
+public:
+	typedef TexelType Texel;
+	enum
+	{
+		TEXEL_SIZE = 4
+	};
+	HDRInterpolator (const ColorEndpointPair* colorEndpoints, const deUint32* colorEndpointModes, int numPartitions, int ccs)
+		: m_ccs	(ccs)
+	{
+		for (int partNdx = 0; partNdx < numPartitions; partNdx++)
+		{
+			const bool isHDR = isColorEndpointModeHDR(colorEndpointModes[partNdx]);
+			for (int channelNdx = 0; channelNdx < 4; channelNdx++)
 			{
-				for (int channelNdx = 0; channelNdx < 4; channelNdx++)
-				{
-					if (!isHDREndpoint[colorEndpointNdx] || (channelNdx == 3 && colorEndpointModes[colorEndpointNdx] == 14)) // \note Alpha for mode 14 is treated the same as LDR.
-					{
-						const deUint32 c0	= (e0[channelNdx] << 8) | (isSRGB ? 0x80 : e0[channelNdx]);
-						const deUint32 c1	= (e1[channelNdx] << 8) | (isSRGB ? 0x80 : e1[channelNdx]);
-						const deUint32 w	= weight.w[ccs == channelNdx ? 1 : 0];
-						const deUint32 c	= (c0*(64-w) + c1*w + 32) / 64;
-						if (isSRGB)
-							((deUint8*)dst)[texelNdx*4 + channelNdx] = (deUint8)((c & 0xff00) >> 8);
-						else
-							((float*)dst)[texelNdx*4 + channelNdx] = c == 65535 ? 1.0f : (float)c / 65536.0f;
-					}
-					else
-					{
-						//DE_STATIC_ASSERT((basisu::meta::TypesSame<deFloat16, deUint16>::Value));
-						// rg - REMOVING HDR SUPPORT FOR NOW
-#if 0
-						const deUint32		c0	= e0[channelNdx] << 4;
-					const deUint32		c1	= e1[channelNdx] << 4;
-					const deUint32		w	= weight.w[ccs == channelNdx ? 1 : 0];
-					const deUint32		c	= (c0*(64-w) + c1*w + 32) / 64;
-					const deUint32		e	= getBits(c, 11, 15);
-					const deUint32		m	= getBits(c, 0, 10);
-					const deUint32		mt	= m < 512		? 3*m
-											: m >= 1536		? 5*m - 2048
-											:				  4*m - 512;
-					const deFloat16		cf	= (deFloat16)((e << 10) + (mt >> 3));
-					((float*)dst)[texelNdx*4 + channelNdx] = deFloat16To32(isFloat16InfOrNan(cf) ? 0x7bff : cf);
+				const deUint32	e0	= colorEndpoints[partNdx].e0[channelNdx];
+				const deUint32	e1	= colorEndpoints[partNdx].e1[channelNdx];
+				const bool		lns	= isHDR && !(channelNdx == 3 && colorEndpointModes[partNdx] == 14);
+				m_isLNS[partNdx][channelNdx]	= lns;
+				m_c0[partNdx][channelNdx]		= (deUint16)(lns ? e0 << 4 : (e0 << 8) | e0);
+				m_c1[partNdx][channelNdx]		= (deUint16)(lns ? e1 << 4 : (e1 << 8) | e1);
+			}
+		}
+#if ASTC_DECOMP_SSE2
+		m_planeMask = ccs >= 0 ? _mm_cmpeq_epi16(_mm_setr_epi16(0, 1, 2, 3, 0, 1, 2, 3), _mm_set1_epi16((short)ccs)) : _mm_setzero_si128();
 #endif
-					}
-				}
+	}
+#if ASTC_DECOMP_SSE2
+	// Two texels per vector, one per 64 bit half. The products need 22 bits so they are widened to 32.
+	template<bool IsDualPlane>
+	void interpolate4 (Texel* dst, const deUint8* partitions, const deUint8* weights0, const deUint8* weights1) const
+	{
+		for (int pairNdx = 0; pairNdx < 2; pairNdx++)
+		{
+			const int		partA	= partitions[2*pairNdx];
+			const int		partB	= partitions[2*pairNdx + 1];
+			const __m128i	c0		= _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)m_c0[partA]), _mm_loadl_epi64((const __m128i*)m_c0[partB]));
+			const __m128i	c1		= _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)m_c1[partA]), _mm_loadl_epi64((const __m128i*)m_c1[partB]));
+			__m128i			w		= _mm_unpacklo_epi64(_mm_set1_epi16((short)weights0[2*pairNdx]), _mm_set1_epi16((short)weights0[2*pairNdx + 1]));
+			if (IsDualPlane)
+			{
+				const __m128i w1 = _mm_unpacklo_epi64(_mm_set1_epi16((short)weights1[2*pairNdx]), _mm_set1_epi16((short)weights1[2*pairNdx + 1]));
+				w = _mm_or_si128(_mm_and_si128(m_planeMask, w1), _mm_andnot_si128(m_planeMask, w));
+			}
+			const __m128i	iw		= _mm_sub_epi16(_mm_set1_epi16(64), w);
+			const __m128i	p0lo	= _mm_mullo_epi16(c0, iw);
+			const __m128i	p0hi	= _mm_mulhi_epu16(c0, iw);
+			const __m128i	p1lo	= _mm_mullo_epi16(c1, w);
+			const __m128i	p1hi	= _mm_mulhi_epu16(c1, w);
+			const __m128i	rounding	= _mm_set1_epi32(32);
+			const __m128i	sumA	= _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(_mm_unpacklo_epi16(p0lo, p0hi), _mm_unpacklo_epi16(p1lo, p1hi)), rounding), 6);
+			const __m128i	sumB	= _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(_mm_unpackhi_epi16(p0lo, p0hi), _mm_unpackhi_epi16(p1lo, p1hi)), rounding), 6);
+			// The sums are unsigned 16 bit, bias them into the signed range so the pack doesn't saturate.
+			const __m128i	bias	= _mm_set1_epi32(32768);
+			const __m128i	packed	= _mm_xor_si128(_mm_packs_epi32(_mm_sub_epi32(sumA, bias), _mm_sub_epi32(sumB, bias)), _mm_set1_epi16((short)0x8000));
+			deUint16		c[8];
+			_mm_storeu_si128((__m128i*)c, packed);
+			for (int channelNdx = 0; channelNdx < 4; channelNdx++)
+			{
+				storeHalf(dst + pairNdx*8 + channelNdx, pack(partA, channelNdx, c[channelNdx]));
+				storeHalf(dst + pairNdx*8 + 4 + channelNdx, pack(partB, channelNdx, c[4 + channelNdx]));
 			}
 		}
-	return result;
+	}
+#endif
+	template<bool IsDualPlane>
+	void interpolate1 (Texel* dst, int partNdx, deUint32 w0, deUint32 w1) const
+	{
+		for (int channelNdx = 0; channelNdx < 4; channelNdx++)
+		{
+			const deUint32 w = IsDualPlane && channelNdx == m_ccs ? w1 : w0;
+			storeHalf(dst + channelNdx, pack(partNdx, channelNdx, (m_c0[partNdx][channelNdx]*(64-w) + m_c1[partNdx][channelNdx]*w + 32) >> 6));
+		}
+	}
+private:
+	deUint16 pack (int partNdx, int channelNdx, deUint32 c) const
+	{
+		return m_isLNS[partNdx][channelNdx] ? lnsToHalf(c) : unorm16ToHalf(c);
+	}
+	deUint16	m_c0[4][4];
+	deUint16	m_c1[4][4];
+	bool		m_isLNS[4][4];
+	int			m_ccs;
+#if ASTC_DECOMP_SSE2
+	__m128i		m_planeMask;
+#endif
+};
+template<int BlockWidth, int BlockHeight, int BlockDepth, typename Texel>
+DecompressResult setTexelColorsHDR (Texel* dst, ColorEndpointPair* colorEndpoints, const TexelWeightPlanes<BlockWidth*BlockHeight*BlockDepth>& texelWeights, int ccs, deUint32 partitionIndexSeed,
+																		int numPartitions, const deUint32* colorEndpointModes)
+{
+	enum
+	{
+		NUM_TEXELS	= BlockWidth*BlockHeight*BlockDepth
+	};
+	const HDRInterpolator<Texel> interpolator(colorEndpoints, colorEndpointModes, numPartitions, ccs);
+	if (numPartitions == 1)
+	{
+		if (ccs < 0)
+			interpolateTexels<NUM_TEXELS, true, false>(dst, interpolator, texelWeights, nullptr);
+		else
+			interpolateTexels<NUM_TEXELS, true, true>(dst, interpolator, texelWeights, nullptr);
+		return DECOMPRESS_RESULT_VALID_BLOCK;
+	}
+	deUint8 texelPartitions[NUM_TEXELS];
+	computeTexelPartitions<BlockWidth, BlockHeight, BlockDepth>(texelPartitions, partitionIndexSeed, numPartitions);
+	if (ccs < 0)
+		interpolateTexels<NUM_TEXELS, false, false>(dst, interpolator, texelWeights, texelPartitions);
+	else
+		interpolateTexels<NUM_TEXELS, false, true>(dst, interpolator, texelWeights, texelPartitions);
+	return DECOMPRESS_RESULT_VALID_BLOCK;
 }
-DecompressResult decompressBlock (void* dst, const Block128& blockData, int blockWidth, int blockHeight, bool isSRGB, bool isLDR)
+// All the state decompressBlock derives from a block's header (block mode, partition count and
+// color endpoint modes) for a given footprint. Blocks of a texture mostly share a handful of
+// these, so they are cached and the common case goes straight to data extraction.
+struct ASTCDecodePlan
 {
-			DE_ASSERT(isLDR || !isSRGB);
-	// Decode block mode.
-	const ASTCBlockMode blockMode = getASTCBlockMode(blockData.getBits(0, 10));
-	// Check for block mode errors.
-	if (blockMode.isError)
+	deUint32	key;						//!< Header bits the plan was built from, see computeDecodePlanKey.
+	int			blockWidth;					//!< 0 if the plan is unused.
+	int			blockHeight;
+	int			blockDepth;
+	bool		isError;
+	// \note Following fields only relevant if !isError.
+	int			numWeights;
+	int			numWeightDataBits;
+	int			numPartitions;
+	int			extraCemBitsStart;
+	int			numBitsForColorEndpoints;
+	int			numColorEndpointValues;
+	ISEParams	colorEndpointISEParams;
+	deUint32	colorEndpointModes[4];
+	ASTCDecodePlan (void)
+			: key						(0)
+			, blockWidth				(0)
+			, blockHeight				(0)
+			, blockDepth				(0)
+			, isError					(true)
+			, numWeights				(0)
+			, numWeightDataBits			(0)
+			, numPartitions				(0)
+			, extraCemBitsStart			(0)
+			, numBitsForColorEndpoints	(0)
+			, numColorEndpointValues	(0)
+			, colorEndpointISEParams	(ISEMODE_LAST, -1)
 	{
-		setASTCErrorColorBlock(dst, blockWidth, blockHeight, isSRGB);
-		return DECOMPRESS_RESULT_ERROR;
 	}
-	// Separate path for void-extent.
-	if (blockMode.isVoidExtent)
-		return decodeVoidExtentBlock(dst, blockData, blockWidth, blockHeight, isSRGB, isLDR);
+};
+// Packs every header bit a plan depends on: block mode and partition count [0,12], then either
+// the single CEM [13,16] or the multi-partition CEM [23,28] plus any extra CEM bits below the weights.
+deUint32 computeDecodePlanKey (const Block128& blockData, bool is3D)
+{
+	const deUint32	modeBits		= blockData.getBits(0, 12);
+	const int		numPartitions	= (int)getBits(modeBits, 11, 12) + 1;
+	if (numPartitions == 1)
+		return modeBits | (blockData.getBits(13, 16) << 13);
+	deUint32 key = modeBits | (blockData.getBits(23, 28) << 13);
+	const int numWeightDataBits = s_decodeTables.numWeightDataBits[is3D ? 1 : 0][modeBits & 0x7ff];
+	// Blocks with too many weight bits are errors whatever their extra CEM bits say.
+	if (blockData.getBits(23, 24) != 0 && numWeightDataBits <= 96)
+	{
+		const int extraCemBitsStart = 127 - numWeightDataBits - (numPartitions == 4 ? 7 : numPartitions == 3 ? 4 : 1);
+		key |= blockData.getBits(extraCemBitsStart, extraCemBitsStart + 3*numPartitions - 5) << 19;
+	}
+	return key;
+}
+void computeDecodePlan (ASTCDecodePlan& plan, deUint32 key, const Block128& blockData, const ASTCBlockMode& blockMode, int blockWidth, int blockHeight, int blockDepth)
+{
+	plan.key			= key;
+	plan.blockWidth		= blockWidth;
+	plan.blockHeight	= blockHeight;
+	plan.blockDepth		= blockDepth;
+	plan.isError		= true;
 	// Compute weight grid values.
 	const int numWeights			= computeNumWeights(blockMode);
 	const int numWeightDataBits		= computeNumRequiredBits(blockMode.weightISEParams, numWeights);
@@ -1475,11 +2082,9 @@ DecompressResult decompressBlock (void* dst, const Block128& blockData, int bloc
 			numWeightDataBits < 24						||
 			blockMode.weightGridWidth > blockWidth		||
 			blockMode.weightGridHeight > blockHeight	||
+			blockMode.weightGridDepth > blockDepth		||
 			(numPartitions == 4 && blockMode.isDualPlane))
-	{
-		setASTCErrorColorBlock(dst, blockWidth, blockHeight, isSRGB);
-		return DECOMPRESS_RESULT_ERROR;
-	}
+		return;
 	// Compute number of bits available for color endpoint data.
 	const bool	isSingleUniqueCem			= numPartitions == 1 || blockData.getBits(23, 24) == 0;
 	const int	numConfigDataBits			= (numPartitions == 1 ? 17 : isSingleUniqueCem ? 29 : 25 + 3*numPartitions) +
@@ -1491,84 +2096,553 @@ DecompressResult decompressBlock (void* dst, const Block128& blockData, int bloc
 																																																																	: numPartitions == 2	? 1
 																																																																												: 0);
 	// Decode color endpoint modes.
-	deUint32 colorEndpointModes[4];
-	decodeColorEndpointModes(&colorEndpointModes[0], blockData, numPartitions, extraCemBitsStart);
-	const int numColorEndpointValues = computeNumColorEndpointValues(colorEndpointModes, numPartitions);
+	decodeColorEndpointModes(&plan.colorEndpointModes[0], blockData, numPartitions, extraCemBitsStart);
+	const int numColorEndpointValues = computeNumColorEndpointValues(plan.colorEndpointModes, numPartitions);
 	// Check for errors in color endpoint value count.
 	if (numColorEndpointValues > 18 || numBitsForColorEndpoints < (int)deDivRoundUp32(13*numColorEndpointValues, 5))
+		return;
+	plan.isError					= false;
+	plan.numWeights					= numWeights;
+	plan.numWeightDataBits			= numWeightDataBits;
+	plan.numPartitions				= numPartitions;
+	plan.extraCemBitsStart			= extraCemBitsStart;
+	plan.numBitsForColorEndpoints	= numBitsForColorEndpoints;
+	plan.numColorEndpointValues		= numColorEndpointValues;
+	plan.colorEndpointISEParams		= computeMaximumRangeISEParams(numBitsForColorEndpoints, numColorEndpointValues);
+}
+// Small direct mapped cache of decode plans. One per thread, so workers never share or lock.
+class ASTCDecodePlanCache
+{
+public:
+	const ASTCDecodePlan& get (const Block128& blockData, const ASTCBlockMode& blockMode, int blockWidth, int blockHeight, int blockDepth)
 	{
-		setASTCErrorColorBlock(dst, blockWidth, blockHeight, isSRGB);
-		return DECOMPRESS_RESULT_ERROR;
+		const deUint32	key		= computeDecodePlanKey(blockData, blockDepth > 1);
+		ASTCDecodePlan&	plan	= m_plans[(key * 2654435761u) >> (32 - LOG2_NUM_PLANS)];
+		if (plan.key != key || plan.blockWidth != blockWidth || plan.blockHeight != blockHeight || plan.blockDepth != blockDepth)
+			computeDecodePlan(plan, key, blockData, blockMode, blockWidth, blockHeight, blockDepth);
+		return plan;
 	}
+private:
+	enum
+	{
+		LOG2_NUM_PLANS	= 6
+	};
+	ASTCDecodePlan m_plans[1 << LOG2_NUM_PLANS];
+};
+static thread_local ASTCDecodePlanCache s_decodePlanCache;
+// Everything up to the texel colors is shared by the LDR and HDR profiles.
+template<int BlockWidth, int BlockHeight, int BlockDepth>
+struct DecodedBlock
+{
+	ColorEndpointPair										colorEndpoints[4];
+	TexelWeightPlanes<BlockWidth*BlockHeight*BlockDepth>	texelWeights;
+	const ASTCDecodePlan*						plan;
+	int											ccs;
+	deUint32									partitionIndexSeed;
+};
+enum BlockType
+{
+	BLOCKTYPE_ERROR = 0,
+	BLOCKTYPE_VOID_EXTENT,
+	BLOCKTYPE_NORMAL
+};
+template<int BlockWidth, int BlockHeight, int BlockDepth>
+BlockType decodeBlock (DecodedBlock<BlockWidth, BlockHeight, BlockDepth>& dst, const Block128& blockData)
+{
+	// Decode block mode.
+	const ASTCBlockMode& blockMode = getASTCBlockMode(blockData.getBits(0, 10), BlockDepth > 1);
+	// Check for block mode errors.
+	if (blockMode.isError)
+		return BLOCKTYPE_ERROR;
+	// Separate path for void-extent.
+	if (blockMode.isVoidExtent)
+		return BLOCKTYPE_VOID_EXTENT;
+	// Everything else that only depends on the header comes from the plan cache.
+	const ASTCDecodePlan& plan = s_decodePlanCache.get(blockData, blockMode, BlockWidth, BlockHeight, BlockDepth);
+	if (plan.isError)
+		return BLOCKTYPE_ERROR;
 	// Compute color endpoints.
-	ColorEndpointPair colorEndpoints[4];
-	computeColorEndpoints(&colorEndpoints[0], blockData, &colorEndpointModes[0], numPartitions, numColorEndpointValues,
-												computeMaximumRangeISEParams(numBitsForColorEndpoints, numColorEndpointValues), numBitsForColorEndpoints);
+	computeColorEndpoints(&dst.colorEndpoints[0], blockData, &plan.colorEndpointModes[0], plan.numPartitions, plan.numColorEndpointValues,
+												plan.colorEndpointISEParams, plan.numBitsForColorEndpoints);
 	// Compute texel weights.
-	TexelWeightPair texelWeights[MAX_BLOCK_WIDTH*MAX_BLOCK_HEIGHT];
-	computeTexelWeights(&texelWeights[0], blockData, blockWidth, blockHeight, blockMode);
-	// Set texel colors.
-	const int		ccs						= blockMode.isDualPlane ? (int)blockData.getBits(extraCemBitsStart-2, extraCemBitsStart-1) : -1;
-	const deUint32	partitionIndexSeed		= numPartitions > 1 ? blockData.getBits(13, 22) : (deUint32)-1;
-	return setTexelColors(dst, &colorEndpoints[0], &texelWeights[0], ccs, partitionIndexSeed, numPartitions, blockWidth, blockHeight, isSRGB, isLDR, &colorEndpointModes[0]);
+	computeTexelWeights<BlockWidth, BlockHeight, BlockDepth>(dst.texelWeights, blockData, blockMode, plan.numWeights, plan.numWeightDataBits);
+	dst.plan				= &plan;
+	dst.ccs					= blockMode.isDualPlane ? (int)blockData.getBits(plan.extraCemBitsStart-2, plan.extraCemBitsStart-1) : -1;
+	dst.partitionIndexSeed	= plan.numPartitions > 1 ? blockData.getBits(13, 22) : (deUint32)-1;
+	return BLOCKTYPE_NORMAL;
+}
+// LDR profile, packed BGRA8 or RGBA float or half output.
+template<int BlockWidth, int BlockHeight, int BlockDepth, bool IsSRGB, typename Texel>
+DecompressResult decompressBlock (Texel* dst, const Block128& blockData)
+{
+	DecodedBlock<BlockWidth, BlockHeight, BlockDepth> block;
+	switch (decodeBlock<BlockWidth, BlockHeight, BlockDepth>(block, blockData))
+	{
+	case BLOCKTYPE_ERROR:
+		setASTCErrorColorBlock<BlockWidth, BlockHeight, BlockDepth, IsSRGB>(dst);
+		return DECOMPRESS_RESULT_ERROR;
+	case BLOCKTYPE_VOID_EXTENT:
+		return decodeVoidExtentBlock<BlockWidth, BlockHeight, BlockDepth, IsSRGB>(dst, blockData, true);
+	default:
+		break;
+	}
+	return setTexelColors<BlockWidth, BlockHeight, BlockDepth, IsSRGB>(dst, &block.colorEndpoints[0], block.texelWeights, block.ccs, block.partitionIndexSeed,
+																												 block.plan->numPartitions, &block.plan->colorEndpointModes[0]);
+}
+// HDR profile, RGBA half or float output.
+template<int BlockWidth, int BlockHeight, int BlockDepth, typename Texel>
+DecompressResult decompressBlockHDR (Texel* dst, const Block128& blockData)
+{
+	DecodedBlock<BlockWidth, BlockHeight, BlockDepth> block;
+	switch (decodeBlock<BlockWidth, BlockHeight, BlockDepth>(block, blockData))
+	{
+	case BLOCKTYPE_ERROR:
+		setASTCErrorColorBlockHDR<BlockWidth, BlockHeight, BlockDepth>(dst);
+		return DECOMPRESS_RESULT_ERROR;
+	case BLOCKTYPE_VOID_EXTENT:
+		return decodeVoidExtentBlockHDR<BlockWidth, BlockHeight, BlockDepth>(dst, blockData);
+	default:
+		break;
+	}
+	return setTexelColorsHDR<BlockWidth, BlockHeight, BlockDepth>(dst, &block.colorEndpoints[0], block.texelWeights, block.ccs, block.partitionIndexSeed,
+																										block.plan->numPartitions, &block.plan->colorEndpointModes[0]);
+}
+
+// Batch decode of runs of 2D LDR blocks. A strip's blocks are sorted by partition count, dual plane and
+// weight grid size, so each group shares one weight infill table and one specialisation of the texel
+// kernel. Grid weights of BATCH_LANES blocks are infilled together, structure of arrays, a lane per block.
+enum
+{
+	BATCH_LANES			= 8,
+	BATCH_STRIP_BLOCKS	= 256
+};
+// The 4 grid weights and filter weights of each texel for one grid size, see interpolateWeightPlane.
+template<int NumTexels>
+struct WeightInfillTable
+{
+	deUint8 index[NumTexels][4];	//!< & 0x3f, out of bounds taps always have a 0 weight.
+	deUint8 weight[NumTexels][4];
+};
+template<int BlockWidth, int BlockHeight>
+void computeWeightInfillTable (WeightInfillTable<BlockWidth*BlockHeight>& dst, int gridWidth, int gridHeight)
+{
+	const deUint32	scaleX				= (1024 + BlockWidth/2) / (BlockWidth-1);
+	const deUint32	scaleY				= (1024 + BlockHeight/2) / (BlockHeight-1);
+	for (int texelY = 0; texelY < BlockHeight; texelY++)
+	{
+		const deUint32 gY	= (scaleY*texelY*(gridHeight-1) + 32) >> 6;
+		const deUint32 jY	= gY >> 4;
+		const deUint32 fY	= gY & 0xf;
+		for (int texelX = 0; texelX < BlockWidth; texelX++)
+		{
+			const deUint32	gX			= (scaleX*texelX*(gridWidth-1) + 32) >> 6;
+			const deUint32	jX			= gX >> 4;
+			const deUint32	fX			= gX & 0xf;
+			const deUint32	w11			= (fX*fY + 8) >> 4;
+			const deUint32	i00			= jY*gridWidth + jX;
+			const int		texelNdx	= texelY*BlockWidth + texelX;
+			dst.index[texelNdx][0]	= (deUint8)(i00 & 0x3f);
+			dst.index[texelNdx][1]	= (deUint8)((i00 + 1) & 0x3f);
+			dst.index[texelNdx][2]	= (deUint8)((i00 + gridWidth) & 0x3f);
+			dst.index[texelNdx][3]	= (deUint8)((i00 + gridWidth + 1) & 0x3f);
+			dst.weight[texelNdx][0]	= (deUint8)(16 - fX - fY + w11);
+			dst.weight[texelNdx][1]	= (deUint8)(fX - w11);
+			dst.weight[texelNdx][2]	= (deUint8)(fY - w11);
+			dst.weight[texelNdx][3]	= (deUint8)w11;
+		}
+	}
+}
+// Unquantized grid weights of a batch, [plane][grid weight][lane]. Entries past the grid stay 0, like the
+// poison values of unquantizeWeights they are only ever read with a 0 filter weight.
+struct BatchGridWeights
+{
+	deUint16 w[2][64][BATCH_LANES];
+};
+template<int NumTexels>
+void infillBatchWeightPlane (deUint8 (*dst)[BATCH_LANES], const deUint16 (&gridWeights)[64][BATCH_LANES], const WeightInfillTable<NumTexels>& table)
+{
+	for (int texelNdx = 0; texelNdx < NumTexels; texelNdx++)
+	{
+		const deUint8* const	index	= table.index[texelNdx];
+		const deUint8* const	weight	= table.weight[texelNdx];
+#if ASTC_DECOMP_SSE2
+		// at most 64 * 16 + 8, so 16 bit lanes
+		__m128i sum = _mm_set1_epi16(8);
+		for (int tapNdx = 0; tapNdx < 4; tapNdx++)
+			sum = _mm_add_epi16(sum, _mm_mullo_epi16(_mm_loadu_si128((const __m128i*)gridWeights[index[tapNdx]]), _mm_set1_epi16(weight[tapNdx])));
+		sum = _mm_srli_epi16(sum, 4);
+		_mm_storel_epi64((__m128i*)dst[texelNdx], _mm_packus_epi16(sum, sum));
+#else
+		for (int laneNdx = 0; laneNdx < BATCH_LANES; laneNdx++)
+			dst[texelNdx][laneNdx] = (deUint8)((gridWeights[index[0]][laneNdx]*weight[0] + gridWeights[index[1]][laneNdx]*weight[1] +
+																					gridWeights[index[2]][laneNdx]*weight[2] + gridWeights[index[3]][laneNdx]*weight[3] + 8) >> 4);
+#endif
+	}
+}
+// Direct mapped cache of texel partition maps, blocks of a texture reuse a few partition seeds.
+template<int BlockWidth, int BlockHeight>
+class PartitionMapCache
+{
+public:
+	PartitionMapCache (void)
+	{
+		for (int i = 0; i < NUM_MAPS; i++)
+			m_keys[i] = ~0u;
+	}
+	const deUint8* get (deUint32 partitionIndexSeed, int numPartitions)
+	{
+		const deUint32	key		= partitionIndexSeed | ((deUint32)numPartitions << 10);
+		const int		slot	= (int)((partitionIndexSeed ^ (partitionIndexSeed >> 4)) & (NUM_MAPS - 1));
+		if (m_keys[slot] != key)
+		{
+			m_keys[slot] = key;
+			computeTexelPartitions<BlockWidth, BlockHeight, 1>(m_maps[slot], partitionIndexSeed, numPartitions);
+		}
+		return m_maps[slot];
+	}
+private:
+	enum
+	{
+		NUM_MAPS	= 16
+	};
+	deUint32	m_keys[NUM_MAPS];
+	deUint8		m_maps[NUM_MAPS][BlockWidth*BlockHeight];
+};
+// What a batch lane keeps of decodeBlock until its weights are infilled.
+struct BatchLane
+{
+	deUint32*			dst;
+	ColorEndpointPair	colorEndpoints[4];
+	int					ccs;
+	deUint32			partitionIndexSeed;
+	int					numPartitions;
+};
+template<int BlockWidth, int BlockHeight, bool IsSRGB, bool IsSinglePartition, bool IsDualPlane>
+void flushBatch (const BatchLane* lanes, int numLanes, const BatchGridWeights& gridWeights, const WeightInfillTable<BlockWidth*BlockHeight>& table,
+								 PartitionMapCache<BlockWidth, BlockHeight>& partitionMaps)
+{
+	enum
+	{
+		NUM_TEXELS	= BlockWidth*BlockHeight
+	};
+	deUint8 infilled[2][NUM_TEXELS][BATCH_LANES];
+	infillBatchWeightPlane<NUM_TEXELS>(infilled[0], gridWeights.w[0], table);
+	if (IsDualPlane)
+		infillBatchWeightPlane<NUM_TEXELS>(infilled[1], gridWeights.w[1], table);
+	for (int laneNdx = 0; laneNdx < numLanes; laneNdx++)
+	{
+		const BatchLane&				lane = lanes[laneNdx];
+		TexelWeightPlanes<NUM_TEXELS>	texelWeights;
+		for (int texelNdx = 0; texelNdx < NUM_TEXELS; texelNdx++)
+		{
+			texelWeights.w[0][texelNdx] = infilled[0][texelNdx][laneNdx];
+			if (IsDualPlane)
+				texelWeights.w[1][texelNdx] = infilled[1][texelNdx][laneNdx];
+		}
+		const deUint8* texelPartitions = IsSinglePartition ? nullptr : partitionMaps.get(lane.partitionIndexSeed, lane.numPartitions);
+		const LDRInterpolator<IsSRGB>	interpolator(lane.colorEndpoints, lane.numPartitions, lane.ccs);
+		interpolateTexels<NUM_TEXELS, IsSinglePartition, IsDualPlane>(lane.dst, interpolator, texelWeights, texelPartitions);
+	}
+}
+// Blocks of one group, sortedBlocks entries hold the strip block index in their low 8 bits.
+template<int BlockWidth, int BlockHeight, bool IsSRGB, bool IsSinglePartition, bool IsDualPlane>
+void decompressBlockGroup (deUint8* output, const deUint8* input, const deUint32* sortedBlocks, int numBlocks,
+													 PartitionMapCache<BlockWidth, BlockHeight>& partitionMaps)
+{
+	enum
+	{
+		NUM_TEXELS	= BlockWidth*BlockHeight
+	};
+	const ASTCBlockMode&				groupMode = getASTCBlockMode(Block128(input + (sortedBlocks[0] & 0xff)*16).getBits(0, 10), false);
+	WeightInfillTable<NUM_TEXELS>	table;
+	computeWeightInfillTable<BlockWidth, BlockHeight>(table, groupMode.weightGridWidth, groupMode.weightGridHeight);
+	const int							numGridWeights	= groupMode.weightGridWidth*groupMode.weightGridHeight;
+	BatchGridWeights					gridWeights;
+	memset(&gridWeights, 0, sizeof(gridWeights));
+	BatchLane							lanes[BATCH_LANES];
+	int									numLanes		= 0;
+	for (int blockNdx = 0; blockNdx < numBlocks; blockNdx++)
+	{
+		const deUint32			stripNdx	= sortedBlocks[blockNdx] & 0xff;
+		const Block128			blockData	(input + stripNdx*16);
+		deUint32* const			dst			= (deUint32*)(output + stripNdx*NUM_TEXELS*sizeof(deUint32));
+		const ASTCBlockMode&	blockMode	= getASTCBlockMode(blockData.getBits(0, 10), false);
+		const ASTCDecodePlan&	plan		= s_decodePlanCache.get(blockData, blockMode, BlockWidth, BlockHeight, 1);
+		bool					isError		= plan.isError;
+		for (int i = 0; !isError && i < plan.numPartitions; i++)
+			isError = isColorEndpointModeHDR(plan.colorEndpointModes[i]);
+		if (isError)
+		{
+			setASTCErrorColorBlock<BlockWidth, BlockHeight, 1, IsSRGB>(dst);
+			continue;
+		}
+		BatchLane& lane = lanes[numLanes];
+		computeColorEndpoints(&lane.colorEndpoints[0], blockData, &plan.colorEndpointModes[0], plan.numPartitions, plan.numColorEndpointValues,
+													plan.colorEndpointISEParams, plan.numBitsForColorEndpoints);
+		ISEDecodedResult weightGrid[64];
+		{
+			BitAccessStream dataStream(blockData, 127, plan.numWeightDataBits, false);
+			decodeISE(&weightGrid[0], plan.numWeights, dataStream, blockMode.weightISEParams);
+		}
+		deUint32 unquantizedWeights[64];
+		unquantizeWeights(&unquantizedWeights[0], &weightGrid[0], blockMode);
+		for (int i = 0; i < numGridWeights; i++)
+		{
+			gridWeights.w[0][i][numLanes] = (deUint16)unquantizedWeights[IsDualPlane ? 2*i : i];
+			if (IsDualPlane)
+				gridWeights.w[1][i][numLanes] = (deUint16)unquantizedWeights[2*i + 1];
+		}
+		lane.dst				= dst;
+		lane.ccs				= IsDualPlane ? (int)blockData.getBits(plan.extraCemBitsStart-2, plan.extraCemBitsStart-1) : -1;
+		lane.partitionIndexSeed	= plan.numPartitions > 1 ? blockData.getBits(13, 22) : (deUint32)-1;
+		lane.numPartitions		= plan.numPartitions;
+		if (++numLanes == BATCH_LANES)
+		{
+			flushBatch<BlockWidth, BlockHeight, IsSRGB, IsSinglePartition, IsDualPlane>(lanes, numLanes, gridWeights, table, partitionMaps);
+			numLanes = 0;
+		}
+	}
+	// spare lanes hold an earlier batch's or zero weights, they are infilled but never stored
+	if (numLanes > 0)
+		flushBatch<BlockWidth, BlockHeight, IsSRGB, IsSinglePartition, IsDualPlane>(lanes, numLanes, gridWeights, table, partitionMaps);
+}
+template<int BlockWidth, int BlockHeight, bool IsSRGB>
+void decompressBlockStrip (deUint8* output, const deUint8* input, int numBlocks)
+{
+	enum
+	{
+		NUM_TEXELS	= BlockWidth*BlockHeight
+	};
+	// group key [0,1] partition count - 1, [2] dual plane, [3,6] grid width, [7,10] grid height, then the block index
+	deUint32	sortedBlocks[BATCH_STRIP_BLOCKS];
+	int			numSorted = 0;
+	for (int blockNdx = 0; blockNdx < numBlocks; blockNdx++)
+	{
+		const Block128			blockData	(input + blockNdx*16);
+		const ASTCBlockMode&	blockMode	= getASTCBlockMode(blockData.getBits(0, 10), false);
+		// error and void extent blocks take the single block path
+		if (blockMode.isError || blockMode.isVoidExtent)
+		{
+			decompressBlock<BlockWidth, BlockHeight, 1, IsSRGB>((deUint32*)(output + blockNdx*NUM_TEXELS*sizeof(deUint32)), blockData);
+			continue;
+		}
+		const deUint32 key = blockData.getBits(11, 12) | ((blockMode.isDualPlane ? 1u : 0u) << 2) |
+				((deUint32)blockMode.weightGridWidth << 3) | ((deUint32)blockMode.weightGridHeight << 7);
+		sortedBlocks[numSorted++] = (key << 8) | (deUint32)blockNdx;
+	}
+	std::sort(sortedBlocks, sortedBlocks + numSorted);
+
+	PartitionMapCache<BlockWidth, BlockHeight> partitionMaps;
+	for (int groupStart = 0; groupStart < numSorted;)
+	{
+		const deUint32	key			= sortedBlocks[groupStart] >> 8;
+		int				groupEnd	= groupStart + 1;
+		while (groupEnd < numSorted && (sortedBlocks[groupEnd] >> 8) == key)
+			groupEnd++;
+		const deUint32*	group		= sortedBlocks + groupStart;
+		const int		groupSize	= groupEnd - groupStart;
+		switch (key & 7)
+		{
+		case 0:	decompressBlockGroup<BlockWidth, BlockHeight, IsSRGB, true, false>(output, input, group, groupSize, partitionMaps); break;
+		case 4:	decompressBlockGroup<BlockWidth, BlockHeight, IsSRGB, true, true>(output, input, group, groupSize, partitionMaps); break;
+		default:
+			if (key & 4)
+				decompressBlockGroup<BlockWidth, BlockHeight, IsSRGB, false, true>(output, input, group, groupSize, partitionMaps);
+			else
+				decompressBlockGroup<BlockWidth, BlockHeight, IsSRGB, false, false>(output, input, group, groupSize, partitionMaps);
+			break;
+		}
+		groupStart = groupEnd;
+	}
 }
 
 } // anonymous
 
-static uint32_t pack32B8(uint8_t b) {
-	return (uint32_t) b;
+} // astc
+} // basisu
+
+// Footprint specialised kernels, ChooseDecompressFunction in imagedecompress.cpp picks these directly.
+// error blocks are written as magenta, so the results are ignored
+template<uint32_t blockX, uint32_t blockY, bool isSRGB>
+void decompressASTC(void const *input, uint8_t *output) {
+	using namespace basisu::astc;
+	const Block128 blockData((uint8_t const*)input);
+	decompressBlock<blockX, blockY, 1, isSRGB>((uint32_t*)output, blockData);
 }
 
-static uint32_t pack32G8(uint8_t g) {
-	return (uint32_t) g << 8;
+// count consecutive blocks into count consecutive decompressed blocks, see decompressBlockStrip
+template<uint32_t blockX, uint32_t blockY, bool isSRGB>
+void decompressASTCBlocks(void const *input, uint32_t count, uint8_t *output) {
+	using namespace basisu::astc;
+	uint8_t const *src = (uint8_t const *) input;
+	while (count > 0) {
+		uint32_t const n = (count < BATCH_STRIP_BLOCKS) ? count : (uint32_t) BATCH_STRIP_BLOCKS;
+		decompressBlockStrip<blockX, blockY, isSRGB>(output, src, (int) n);
+		src += n * 16;
+		output += n * blockX * blockY * sizeof(uint32_t);
+		count -= n;
+	}
 }
 
-static uint32_t pack32R8(uint8_t r) {
-	return (uint32_t) r << 16;
+template<uint32_t blockX, uint32_t blockY>
+void decompressASTCHDR(void const *input, uint8_t *output) {
+	using namespace basisu::astc;
+	const Block128 blockData((uint8_t const*)input);
+	decompressBlockHDR<blockX, blockY, 1>((uint16_t*)output, blockData);
 }
 
-static uint32_t pack32A8(uint8_t a) {
-	return (uint32_t) a << 24;
+template<uint32_t blockX, uint32_t blockY, uint32_t blockZ, bool isSRGB>
+void decompressASTC3D(void const *input, uint8_t *output) {
+	using namespace basisu::astc;
+	const Block128 blockData((uint8_t const*)input);
+	decompressBlock<blockX, blockY, blockZ, isSRGB>((uint32_t*)output, blockData);
 }
 
-static uint32_t pack32RGBA8(uint8_t r, uint8_t g, uint8_t b, uint8_t a) {
-	return pack32R8(r) | pack32G8(g) | pack32B8(b) | pack32A8(a);
+template<uint32_t blockX, uint32_t blockY, uint32_t blockZ>
+void decompressASTCHDR3D(void const *input, uint8_t *output) {
+	using namespace basisu::astc;
+	const Block128 blockData((uint8_t const*)input);
+	decompressBlockHDR<blockX, blockY, blockZ>((uint16_t*)output, blockData);
 }
 
-} // astc
-} // basisu
+#define ASTC_FOOTPRINT(x, y) \
+	template void decompressASTC<x, y, false>(void const *input, uint8_t *output); \
+	template void decompressASTC<x, y, true>(void const *input, uint8_t *output); \
+	template void decompressASTCBlocks<x, y, false>(void const *input, uint32_t count, uint8_t *output); \
+	template void decompressASTCBlocks<x, y, true>(void const *input, uint32_t count, uint8_t *output); \
+	template void decompressASTCHDR<x, y>(void const *input, uint8_t *output);
+ASTC_FOOTPRINT(4, 4)
+ASTC_FOOTPRINT(5, 4)
+ASTC_FOOTPRINT(5, 5)
+ASTC_FOOTPRINT(6, 5)
+ASTC_FOOTPRINT(6, 6)
+ASTC_FOOTPRINT(8, 5)
+ASTC_FOOTPRINT(8, 6)
+ASTC_FOOTPRINT(8, 8)
+ASTC_FOOTPRINT(10, 5)
+ASTC_FOOTPRINT(10, 6)
+ASTC_FOOTPRINT(10, 8)
+ASTC_FOOTPRINT(10, 10)
+ASTC_FOOTPRINT(12, 10)
+ASTC_FOOTPRINT(12, 12)
+#undef ASTC_FOOTPRINT
+
+#define ASTC_FOOTPRINT_3D(x, y, z) \
+	template void decompressASTC3D<x, y, z, false>(void const *input, uint8_t *output); \
+	template void decompressASTC3D<x, y, z, true>(void const *input, uint8_t *output); \
+	template void decompressASTCHDR3D<x, y, z>(void const *input, uint8_t *output);
+ASTC_FOOTPRINT_3D(3, 3, 3)
+ASTC_FOOTPRINT_3D(4, 3, 3)
+ASTC_FOOTPRINT_3D(4, 4, 3)
+ASTC_FOOTPRINT_3D(4, 4, 4)
+ASTC_FOOTPRINT_3D(5, 4, 4)
+ASTC_FOOTPRINT_3D(5, 5, 4)
+ASTC_FOOTPRINT_3D(5, 5, 5)
+ASTC_FOOTPRINT_3D(6, 5, 5)
+ASTC_FOOTPRINT_3D(6, 6, 5)
+ASTC_FOOTPRINT_3D(6, 6, 6)
+#undef ASTC_FOOTPRINT_3D
 
-AL2O3_EXTERN_C void Image_DecompressASTCBlock( const void * input, int blockWidth, int blockHeight, bool isSRGB, uint32_t *pDst)
+#define ASTC_FOOTPRINT_SWITCH(w, h, CALL) \
+	switch((w << 8) | h) { \
+		CALL(4, 4) \
+		CALL(5, 4) \
+		CALL(5, 5) \
+		CALL(6, 5) \
+		CALL(6, 6) \
+		CALL(8, 5) \
+		CALL(8, 6) \
+		CALL(8, 8) \
+		CALL(10, 5) \
+		CALL(10, 6) \
+		CALL(10, 8) \
+		CALL(10, 10) \
+		CALL(12, 10) \
+		CALL(12, 12) \
+		default: ASSERT(false); return; \
+	}
+
+AL2O3_EXTERN_C void Image_DecompressASTCBlock(void const * input, uint32_t blockWidth, uint32_t blockHeight, bool isSRGB, uint8_t* output)
 {
+#define ASTC_LDR_CASE(x, y) \
+	case (x << 8) | y: isSRGB ? decompressASTC<x, y, true>(input, output) : decompressASTC<x, y, false>(input, output); return;
+	ASTC_FOOTPRINT_SWITCH(blockWidth, blockHeight, ASTC_LDR_CASE)
+#undef ASTC_LDR_CASE
+}
+
+AL2O3_EXTERN_C void Image_DecompressASTCBlocks(void const * input, uint32_t blockCount, uint32_t blockWidth, uint32_t blockHeight, bool isSRGB, uint8_t* output)
+{
+#define ASTC_LDR_CASE(x, y) \
+	case (x << 8) | y: isSRGB ? decompressASTCBlocks<x, y, true>(input, blockCount, output) : decompressASTCBlocks<x, y, false>(input, blockCount, output); return;
+	ASTC_FOOTPRINT_SWITCH(blockWidth, blockHeight, ASTC_LDR_CASE)
+#undef ASTC_LDR_CASE
+}
+
+AL2O3_EXTERN_C void Image_DecompressASTCHDRBlock(void const * input, uint32_t blockWidth, uint32_t blockHeight, uint8_t* output)
+{
+#define ASTC_HDR_CASE(x, y) \
+	case (x << 8) | y: decompressASTCHDR<x, y>(input, output); return;
+	ASTC_FOOTPRINT_SWITCH(blockWidth, blockHeight, ASTC_HDR_CASE)
+#undef ASTC_HDR_CASE
+}
+
+// Float and half output written by the kernels. UNORM is the HDR profile decode, the same values as the LDR
+// profile for LDR blocks without the round trip through 8 bits. sRGB is the LDR decode with the colour to linear
+template<uint32_t blockX, uint32_t blockY, typename Texel>
+static void decompressASTCConverted(void const *input, bool isSRGB, Texel *output) {
 	using namespace basisu::astc;
+	const Block128 blockData((uint8_t const*)input);
+	if (isSRGB)
+		decompressBlock<blockX, blockY, 1, true>(output, blockData);
+	else
+		decompressBlockHDR<blockX, blockY, 1>(output, blockData);
+}
 
-	// rg - We only support LDR here, although adding back in HDR would be easy.
-	const bool isLDR = true;
-	uint8_t const* data = (uint8_t const*)input;
+AL2O3_EXTERN_C void Image_DecompressASTCBlockF(void const * input, uint32_t blockWidth, uint32_t blockHeight, bool isSRGB, float* output)
+{
+#define ASTC_F_CASE(x, y) \
+	case (x << 8) | y: decompressASTCConverted<x, y>(input, isSRGB, output); return;
+	ASTC_FOOTPRINT_SWITCH(blockWidth, blockHeight, ASTC_F_CASE)
+#undef ASTC_F_CASE
+}
 
-	float linear[MAX_BLOCK_WIDTH * MAX_BLOCK_HEIGHT * 4];
+AL2O3_EXTERN_C void Image_DecompressASTCBlockH(void const * input, uint32_t blockWidth, uint32_t blockHeight, bool isSRGB, uint16_t* output)
+{
+#define ASTC_H_CASE(x, y) \
+	case (x << 8) | y: decompressASTCConverted<x, y>(input, isSRGB, output); return;
+	ASTC_FOOTPRINT_SWITCH(blockWidth, blockHeight, ASTC_H_CASE)
+#undef ASTC_H_CASE
+}
+#undef ASTC_FOOTPRINT_SWITCH
 
-	const Block128 blockData(data);
-	if (decompressBlock(isSRGB ? (void*)pDst : (void*)& linear[0],
-											blockData, blockWidth, blockHeight, isSRGB, isLDR) != DECOMPRESS_RESULT_VALID_BLOCK)
-	{
-		// TODO make error colour?
-		return;
+#define ASTC_FOOTPRINT_3D_SWITCH(w, h, d, CALL) \
+	switch((w << 16) | (h << 8) | d) { \
+		CALL(3, 3, 3) \
+		CALL(4, 3, 3) \
+		CALL(4, 4, 3) \
+		CALL(4, 4, 4) \
+		CALL(5, 4, 4) \
+		CALL(5, 5, 4) \
+		CALL(5, 5, 5) \
+		CALL(6, 5, 5) \
+		CALL(6, 6, 5) \
+		CALL(6, 6, 6) \
+		default: ASSERT(false); return; \
 	}
 
-	if (!isSRGB)
-	{
-		int pix = 0;
-		for (int i = 0; i < blockHeight; i++)
-		{
-			for (int j = 0; j < blockWidth; j++, pix++)
-			{
-				uint8_t r = (uint8_t)(basisu::clamp<int>((int)(linear[pix * 4 + 0] * 65536.0f + .5f), 0, 65535) >> 8);
-				uint8_t g = (uint8_t)(basisu::clamp<int>((int)(linear[pix * 4 + 1] * 65536.0f + .5f), 0, 65535) >> 8);
-				uint8_t b = (uint8_t)(basisu::clamp<int>((int)(linear[pix * 4 + 2] * 65536.0f + .5f), 0, 65535) >> 8);
-				uint8_t a = (uint8_t)(basisu::clamp<int>((int)(linear[pix * 4 + 3] * 65536.0f + .5f), 0, 65535) >> 8);
-				pDst[pix] = pack32RGBA8(r,g,b,a);
-			}
-		}
-	}
+AL2O3_EXTERN_C void Image_DecompressASTC3DBlock(void const * input, uint32_t blockWidth, uint32_t blockHeight, uint32_t blockDepth, bool isSRGB, uint8_t* output)
+{
+#define ASTC_LDR_CASE(x, y, z) \
+	case (x << 16) | (y << 8) | z: isSRGB ? decompressASTC3D<x, y, z, true>(input, output) : decompressASTC3D<x, y, z, false>(input, output); return;
+	ASTC_FOOTPRINT_3D_SWITCH(blockWidth, blockHeight, blockDepth, ASTC_LDR_CASE)
+#undef ASTC_LDR_CASE
+}
+
+AL2O3_EXTERN_C void Image_DecompressASTCHDR3DBlock(void const * input, uint32_t blockWidth, uint32_t blockHeight, uint32_t blockDepth, uint8_t* output)
+{
+#define ASTC_HDR_CASE(x, y, z) \
+	case (x << 16) | (y << 8) | z: decompressASTCHDR3D<x, y, z>(input, output); return;
+	ASTC_FOOTPRINT_3D_SWITCH(blockWidth, blockHeight, blockDepth, ASTC_HDR_CASE)
+#undef ASTC_HDR_CASE
 }
+#undef ASTC_FOOTPRINT_3D_SWITCH
@@ -0,0 +1,410 @@
+// BC6H (BPTC float) decompression to RGBA half floats, signed and unsigned, all 14 modes.
+// Shares the BPTC partition, anchor and weight tables and the bit reader with bc7decompress.cpp
+
+#include "al2o3_platform/platform.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BC6H_DECOMP_SSE2 1
+#else
+#define BC6H_DECOMP_SSE2 0
+#endif
+
+typedef struct {
+	uint64_t data0;
+	uint64_t data1;
+	int index;
+} detexBlock128;
+
+extern uint32_t detexBlock128ExtractBits(detexBlock128 *block, int nu_bits);
+extern const uint8_t detex_bptc_table_P2[64 * 16];
+extern const uint8_t detex_bptc_table_anchor_index_second_subset[64];
+extern const uint16_t detex_bptc_table_aWeight3[8];
+extern const uint16_t detex_bptc_table_aWeight4[16];
+// in decompressstore.cpp
+extern float HalfToFloat(uint16_t h);
+
+// Endpoint fields, w and x are the first region's endpoints, y and z the second's
+enum {
+	RW, GW, BW,
+	RX, GX, BX,
+	RY, GY, BY,
+	RZ, GZ, BZ,
+};
+
+// count bits from the stream go to field bits [shift, shift + count), reversed fields are single bits
+typedef struct {
+	uint8_t field;
+	uint8_t shift;
+	uint8_t count;
+} BC6HBitRun;
+
+typedef struct {
+	uint8_t nu_regions;
+	uint8_t transformed;
+	uint8_t endpoint_bits;      // precision of w
+	uint8_t delta_bits[3];      // precision of x, y and z per channel
+} BC6HModeInfo;
+
+// modes 1 to 14 in spec order
+static const BC6HModeInfo bc6h_modes[14] = {
+		{2, 1, 10, {5, 5, 5}},
+		{2, 1, 7, {6, 6, 6}},
+		{2, 1, 11, {5, 4, 4}},
+		{2, 1, 11, {4, 5, 4}},
+		{2, 1, 11, {4, 4, 5}},
+		{2, 1, 9, {5, 5, 5}},
+		{2, 1, 8, {6, 5, 5}},
+		{2, 1, 8, {5, 6, 5}},
+		{2, 1, 8, {5, 5, 6}},
+		{2, 0, 6, {6, 6, 6}},
+		{1, 0, 10, {10, 10, 10}},
+		{1, 1, 11, {9, 9, 9}},
+		{1, 1, 12, {8, 8, 8}},
+		{1, 1, 16, {4, 4, 4}},
+};
+
+// 5 bit mode header to mode, -1 is reserved. 2 bit headers (bit 1 clear) are modes 1 and 2
+static const int8_t bc6h_mode_from_header[32] = {
+		0, 1, 2, 10, 0, 1, 3, 11,
+		0, 1, 4, 12, 0, 1, 5, 13,
+		0, 1, 6, -1, 0, 1, 7, -1,
+		0, 1, 8, -1, 0, 1, 9, -1,
+};
+
+// Endpoint bit layout after the mode header, terminated by a 0 count
+static const BC6HBitRun bc6h_mode_layout[14][25] = {
+		{
+				{GY, 4, 1}, {BY, 4, 1}, {BZ, 4, 1}, {RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 5}, {GZ, 4, 1},
+				{GY, 0, 4}, {GX, 0, 5}, {BZ, 0, 1}, {GZ, 0, 4}, {BX, 0, 5}, {BZ, 1, 1}, {BY, 0, 4}, {RY, 0, 5},
+				{BZ, 2, 1}, {RZ, 0, 5}, {BZ, 3, 1}, {0, 0, 0}
+		},
+		{
+				{GY, 5, 1}, {GZ, 4, 1}, {GZ, 5, 1}, {RW, 0, 7}, {BZ, 0, 1}, {BZ, 1, 1}, {BY, 4, 1}, {GW, 0, 7},
+				{BY, 5, 1}, {BZ, 2, 1}, {GY, 4, 1}, {BW, 0, 7}, {BZ, 3, 1}, {BZ, 5, 1}, {BZ, 4, 1}, {RX, 0, 6},
+				{GY, 0, 4}, {GX, 0, 6}, {GZ, 0, 4}, {BX, 0, 6}, {BY, 0, 4}, {RY, 0, 6}, {RZ, 0, 6}, {0, 0, 0}
+		},
+		{
+				{RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 5}, {RW, 10, 1}, {GY, 0, 4}, {GX, 0, 4}, {GW, 10, 1},
+				{BZ, 0, 1}, {GZ, 0, 4}, {BX, 0, 4}, {BW, 10, 1}, {BZ, 1, 1}, {BY, 0, 4}, {RY, 0, 5}, {BZ, 2, 1},
+				{RZ, 0, 5}, {BZ, 3, 1}, {0, 0, 0}
+		},
+		{
+				{RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 4}, {RW, 10, 1}, {GZ, 4, 1}, {GY, 0, 4}, {GX, 0, 5},
+				{GW, 10, 1}, {GZ, 0, 4}, {BX, 0, 4}, {BW, 10, 1}, {BZ, 1, 1}, {BY, 0, 4}, {RY, 0, 4}, {BZ, 0, 1},
+				{BZ, 2, 1}, {RZ, 0, 4}, {GY, 4, 1}, {BZ, 3, 1}, {0, 0, 0}
+		},
+		{
+				{RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 4}, {RW, 10, 1}, {BY, 4, 1}, {GY, 0, 4}, {GX, 0, 4},
+				{GW, 10, 1}, {BZ, 0, 1}, {GZ, 0, 4}, {BX, 0, 5}, {BW, 10, 1}, {BY, 0, 4}, {RY, 0, 4}, {BZ, 1, 1},
+				{BZ, 2, 1}, {RZ, 0, 4}, {BZ, 4, 1}, {BZ, 3, 1}, {0, 0, 0}
+		},
+		{
+				{RW, 0, 9}, {BY, 4, 1}, {GW, 0, 9}, {GY, 4, 1}, {BW, 0, 9}, {BZ, 4, 1}, {RX, 0, 5}, {GZ, 4, 1},
+				{GY, 0, 4}, {GX, 0, 5}, {BZ, 0, 1}, {GZ, 0, 4}, {BX, 0, 5}, {BZ, 1, 1}, {BY, 0, 4}, {RY, 0, 5},
+				{BZ, 2, 1}, {RZ, 0, 5}, {BZ, 3, 1}, {0, 0, 0}
+		},
+		{
+				{RW, 0, 8}, {GZ, 4, 1}, {BY, 4, 1}, {GW, 0, 8}, {BZ, 2, 1}, {GY, 4, 1}, {BW, 0, 8}, {BZ, 3, 1},
+				{BZ, 4, 1}, {RX, 0, 6}, {GY, 0, 4}, {GX, 0, 5}, {BZ, 0, 1}, {GZ, 0, 4}, {BX, 0, 5}, {BZ, 1, 1},
+				{BY, 0, 4}, {RY, 0, 6}, {RZ, 0, 6}, {0, 0, 0}
+		},
+		{
+				{RW, 0, 8}, {BZ, 0, 1}, {BY, 4, 1}, {GW, 0, 8}, {GY, 5, 1}, {GY, 4, 1}, {BW, 0, 8}, {GZ, 5, 1},
+				{BZ, 4, 1}, {RX, 0, 5}, {GZ, 4, 1}, {GY, 0, 4}, {GX, 0, 6}, {GZ, 0, 4}, {BX, 0, 5}, {BZ, 1, 1},
+				{BY, 0, 4}, {RY, 0, 5}, {BZ, 2, 1}, {RZ, 0, 5}, {BZ, 3, 1}, {0, 0, 0}
+		},
+		{
+				{RW, 0, 8}, {BZ, 1, 1}, {BY, 4, 1}, {GW, 0, 8}, {BY, 5, 1}, {GY, 4, 1}, {BW, 0, 8}, {BZ, 5, 1},
+				{BZ, 4, 1}, {RX, 0, 5}, {GZ, 4, 1}, {GY, 0, 4}, {GX, 0, 5}, {BZ, 0, 1}, {GZ, 0, 4}, {BX, 0, 6},
+				{BY, 0, 4}, {RY, 0, 5}, {BZ, 2, 1}, {RZ, 0, 5}, {BZ, 3, 1}, {0, 0, 0}
+		},
+		{
+				{RW, 0, 6}, {GZ, 4, 1}, {BZ, 0, 1}, {BZ, 1, 1}, {BY, 4, 1}, {GW, 0, 6}, {GY, 5, 1}, {BY, 5, 1},
+				{BZ, 2, 1}, {GY, 4, 1}, {BW, 0, 6}, {GZ, 5, 1}, {BZ, 3, 1}, {BZ, 5, 1}, {BZ, 4, 1}, {RX, 0, 6},
+				{GY, 0, 4}, {GX, 0, 6}, {GZ, 0, 4}, {BX, 0, 6}, {BY, 0, 4}, {RY, 0, 6}, {RZ, 0, 6}, {0, 0, 0}
+		},
+		{
+				{RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 10}, {GX, 0, 10}, {BX, 0, 10}, {0, 0, 0}
+		},
+		{
+				{RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 9}, {RW, 10, 1}, {GX, 0, 9}, {GW, 10, 1}, {BX, 0, 9},
+				{BW, 10, 1}, {0, 0, 0}
+		},
+		{
+				{RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10}, {RX, 0, 8}, {RW, 11, 1}, {RW, 10, 1}, {GX, 0, 8}, {GW, 11, 1},
+				{GW, 10, 1}, {BX, 0, 8}, {BW, 11, 1}, {BW, 10, 1}, {0, 0, 0}
+		},
+		{
+				{RW, 0, 10}, {GW, 0, 10}, {BW, 0, 10},
+				{RX, 0, 4}, {RW, 15, 1}, {RW, 14, 1}, {RW, 13, 1}, {RW, 12, 1}, {RW, 11, 1}, {RW, 10, 1},
+				{GX, 0, 4}, {GW, 15, 1}, {GW, 14, 1}, {GW, 13, 1}, {GW, 12, 1}, {GW, 11, 1}, {GW, 10, 1},
+				{BX, 0, 4}, {BW, 15, 1}, {BW, 14, 1}, {BW, 13, 1}, {BW, 12, 1}, {BW, 11, 1}, {BW, 10, 1},
+				{0, 0, 0}
+		},
+};
+
+static AL2O3_FORCE_INLINE int32_t SignExtend(uint32_t value, int bits) {
+	return (int32_t) (value << (32 - bits)) >> (32 - bits);
+}
+
+// endpoint precision to 17 bit signed/16 bit unsigned
+static int32_t Unquantize(int32_t comp, int bits, bool isSigned) {
+	if (!isSigned) {
+		if (bits >= 15)
+			return comp;
+		if (comp == 0)
+			return 0;
+		if (comp == (1 << bits) - 1)
+			return 0xFFFF;
+		return ((comp << 16) + 0x8000) >> bits;
+	}
+
+	// -32768 would finish as -infinity
+	if (bits >= 16)
+		return comp < -0x7FFF ? -0x7FFF : comp;
+	bool const negative = comp < 0;
+	int32_t const magnitude = negative ? -comp : comp;
+	int32_t unq;
+	if (magnitude == 0)
+		unq = 0;
+	else if (magnitude >= (1 << (bits - 1)) - 1)
+		unq = 0x7FFF;
+	else
+		unq = ((magnitude << 15) + 0x4000) >> (bits - 1);
+	return negative ? -unq : unq;
+}
+
+// interpolated value to half bits, scales by 31/32 so the max endpoint becomes the max finite half
+static AL2O3_FORCE_INLINE uint16_t FinishUnquantize(int32_t comp, bool isSigned) {
+	if (!isSigned)
+		return (uint16_t) ((comp * 31) >> 6);
+	if (comp < 0) {
+		// a magnitude that scales to 0 is +0, not -0
+		int32_t const magnitude = ((-comp) * 31) >> 5;
+		return (uint16_t) (magnitude ? (0x8000 | magnitude) : 0);
+	}
+	return (uint16_t) ((comp * 31) >> 5);
+}
+
+// texels are written as halves or, for the float block API, as the floats those halves are
+static AL2O3_FORCE_INLINE void StoreHalf(uint16_t *dst, uint16_t h) {
+	*dst = h;
+}
+
+static AL2O3_FORCE_INLINE void StoreHalf(float *dst, uint16_t h) {
+	*dst = HalfToFloat(h);
+}
+
+template<typename T>
+static void FillBlock(T *pixel_buffer, uint16_t r, uint16_t g, uint16_t b, uint16_t a) {
+	for (int i = 0; i < 16; i++) {
+		StoreHalf(pixel_buffer + i * 4 + 0, r);
+		StoreHalf(pixel_buffer + i * 4 + 1, g);
+		StoreHalf(pixel_buffer + i * 4 + 2, b);
+		StoreHalf(pixel_buffer + i * 4 + 3, a);
+	}
+}
+
+template<typename T>
+static void InterpolateTexels(int32_t const endpoints[4][3],
+															uint8_t const *AL2O3_RESTRICT subset_index,
+															uint8_t const *AL2O3_RESTRICT weights,
+															bool isSigned,
+															T *AL2O3_RESTRICT pixel_buffer) {
+	for (int i = 0; i < 16; i++) {
+		int32_t const *e0 = endpoints[subset_index[i] * 2 + 0];
+		int32_t const *e1 = endpoints[subset_index[i] * 2 + 1];
+		int32_t const w = weights[i];
+		for (int c = 0; c < 3; c++)
+			StoreHalf(pixel_buffer + i * 4 + c, FinishUnquantize((e0[c] * (64 - w) + e1[c] * w + 32) >> 6, isSigned));
+		StoreHalf(pixel_buffer + i * 4 + 3, 0x3C00);
+	}
+}
+
+#if BC6H_DECOMP_SSE2
+// One region blocks, the bulk of most HDR textures. e0 + (d * w + 32) >> 6 with the 17 bit d split into
+// 7 low and 10 high bits, so a single madd of (w, w << 7) gives the full product for 4 texels
+// halves[c][h] is channel c of texels h * 8 to h * 8 + 7, stored interleaved with an alpha of 1
+static AL2O3_FORCE_INLINE void StoreHalvesSSE2(__m128i const halves[3][2], uint16_t *AL2O3_RESTRICT pixel_buffer) {
+	__m128i const alpha = _mm_set1_epi16(0x3C00);
+	__m128i *dst = (__m128i *) pixel_buffer;
+	for (int h = 0; h < 2; h++) {
+		__m128i const rgLo = _mm_unpacklo_epi16(halves[0][h], halves[1][h]);
+		__m128i const rgHi = _mm_unpackhi_epi16(halves[0][h], halves[1][h]);
+		__m128i const baLo = _mm_unpacklo_epi16(halves[2][h], alpha);
+		__m128i const baHi = _mm_unpackhi_epi16(halves[2][h], alpha);
+		_mm_storeu_si128(dst++, _mm_unpacklo_epi32(rgLo, baLo));
+		_mm_storeu_si128(dst++, _mm_unpackhi_epi32(rgLo, baLo));
+		_mm_storeu_si128(dst++, _mm_unpacklo_epi32(rgHi, baHi));
+		_mm_storeu_si128(dst++, _mm_unpackhi_epi32(rgHi, baHi));
+	}
+}
+
+// the halves are finite. Normal halves rebias the exponent from 15 to 127 in the integer domain and denormal
+// halves convert their mantissa to float and scale it by 2^-24, so no float op sees a denormal and a DAZ/FTZ
+// MXCSR can't flush them to 0
+static AL2O3_FORCE_INLINE __m128 HalvesToFloatsSSE2(__m128i halves) {
+	__m128i const magnitude = _mm_and_si128(halves, _mm_set1_epi32(0x7FFF));
+	__m128i const sign = _mm_slli_epi32(_mm_and_si128(halves, _mm_set1_epi32(0x8000)), 16);
+	__m128i const normal = _mm_add_epi32(_mm_slli_epi32(magnitude, 13), _mm_set1_epi32(112 << 23));
+	__m128 const denormal = _mm_mul_ps(_mm_cvtepi32_ps(magnitude), _mm_set1_ps(1.0f / 16777216.0f));
+	__m128 const isDenormal = _mm_castsi128_ps(_mm_cmplt_epi32(magnitude, _mm_set1_epi32(0x400)));
+	__m128 const value = _mm_or_ps(_mm_and_ps(isDenormal, denormal), _mm_andnot_ps(isDenormal, _mm_castsi128_ps(normal)));
+	return _mm_or_ps(value, _mm_castsi128_ps(sign));
+}
+
+static AL2O3_FORCE_INLINE void StoreHalvesSSE2(__m128i const halves[3][2], float *AL2O3_RESTRICT pixel_buffer) {
+	__m128i const zero = _mm_setzero_si128();
+	for (int q = 0; q < 4; q++) {
+		__m128 r = HalvesToFloatsSSE2((q & 1) ? _mm_unpackhi_epi16(halves[0][q >> 1], zero) :
+																	_mm_unpacklo_epi16(halves[0][q >> 1], zero));
+		__m128 g = HalvesToFloatsSSE2((q & 1) ? _mm_unpackhi_epi16(halves[1][q >> 1], zero) :
+																	_mm_unpacklo_epi16(halves[1][q >> 1], zero));
+		__m128 b = HalvesToFloatsSSE2((q & 1) ? _mm_unpackhi_epi16(halves[2][q >> 1], zero) :
+																	_mm_unpacklo_epi16(halves[2][q >> 1], zero));
+		__m128 a = _mm_set1_ps(1.0f);
+		_MM_TRANSPOSE4_PS(r, g, b, a);
+		_mm_storeu_ps(pixel_buffer + q * 16 + 0, r);
+		_mm_storeu_ps(pixel_buffer + q * 16 + 4, g);
+		_mm_storeu_ps(pixel_buffer + q * 16 + 8, b);
+		_mm_storeu_ps(pixel_buffer + q * 16 + 12, a);
+	}
+}
+
+template<typename T>
+static void InterpolateOneRegionTexelsSSE2(int32_t const endpoints[4][3],
+																					 uint8_t const *AL2O3_RESTRICT weights,
+																					 bool isSigned,
+																					 T *AL2O3_RESTRICT pixel_buffer) {
+	__m128i const round = _mm_set1_epi32(32);
+	__m128i w[4];
+	for (int g = 0; g < 4; g++) {
+		uint8_t const *wg = weights + g * 4;
+		w[g] = _mm_setr_epi32(wg[0] | (wg[0] << 23), wg[1] | (wg[1] << 23), wg[2] | (wg[2] << 23), wg[3] | (wg[3] << 23));
+	}
+
+	__m128i halves[3][2];
+	for (int c = 0; c < 3; c++) {
+		int32_t const d = endpoints[1][c] - endpoints[0][c];
+		__m128i const dSplit = _mm_set1_epi32((int32_t) ((uint32_t) (d & 0x7F) | ((uint32_t) (d >> 7) << 16)));
+		__m128i const e0 = _mm_set1_epi32(endpoints[0][c]);
+
+		__m128i value[4];
+		__m128i sign[4];
+		for (int g = 0; g < 4; g++) {
+			__m128i v = _mm_add_epi32(e0, _mm_srai_epi32(_mm_add_epi32(_mm_madd_epi16(w[g], dSplit), round), 6));
+			if (isSigned) {
+				sign[g] = _mm_srai_epi32(v, 31);
+				v = _mm_sub_epi32(_mm_xor_si128(v, sign[g]), sign[g]);
+				value[g] = _mm_srai_epi32(_mm_sub_epi32(_mm_slli_epi32(v, 5), v), 5);
+			} else {
+				value[g] = _mm_srai_epi32(_mm_sub_epi32(_mm_slli_epi32(v, 5), v), 6);
+			}
+		}
+		// magnitudes are <= 0x7BFF so the signed saturating pack is exact
+		halves[c][0] = _mm_packs_epi32(value[0], value[1]);
+		halves[c][1] = _mm_packs_epi32(value[2], value[3]);
+		if (isSigned) {
+			// negative values whose magnitude scales to 0 stay +0
+			__m128i const signBit = _mm_set1_epi16((short) 0x8000);
+			__m128i const zero = _mm_setzero_si128();
+			__m128i const sign0 = _mm_andnot_si128(_mm_cmpeq_epi16(halves[c][0], zero), _mm_packs_epi32(sign[0], sign[1]));
+			__m128i const sign1 = _mm_andnot_si128(_mm_cmpeq_epi16(halves[c][1], zero), _mm_packs_epi32(sign[2], sign[3]));
+			halves[c][0] = _mm_or_si128(halves[c][0], _mm_and_si128(sign0, signBit));
+			halves[c][1] = _mm_or_si128(halves[c][1], _mm_and_si128(sign1, signBit));
+		}
+	}
+
+	StoreHalvesSSE2(halves, pixel_buffer);
+}
+#endif
+
+/* Decompress a 128-bit 4x4 pixel texture block compressed using BPTC float (BC6H) */
+/* to 16 RGBA half or float texels. Reserved modes decode to opaque black and return false. */
+template<typename T>
+static bool DecompressBlockBPTCFloatShared(const uint8_t *AL2O3_RESTRICT bitstring,
+																					 T *AL2O3_RESTRICT pixel_buffer,
+																					 bool isSigned) {
+	detexBlock128 block;
+	block.data0 = *(uint64_t *) &bitstring[0];
+	block.data1 = *(uint64_t *) &bitstring[8];
+	block.index = 0;
+
+	uint32_t header = detexBlock128ExtractBits(&block, 2);
+	if (header & 2)
+		header |= detexBlock128ExtractBits(&block, 3) << 2;
+	int const mode = bc6h_mode_from_header[header];
+	if (mode < 0) {
+		FillBlock(pixel_buffer, 0, 0, 0, 0x3C00);
+		return false;
+	}
+	BC6HModeInfo const *info = &bc6h_modes[mode];
+
+	uint32_t fields[12] = {0};
+	for (BC6HBitRun const *run = bc6h_mode_layout[mode]; run->count != 0; run++)
+		fields[run->field] |= detexBlock128ExtractBits(&block, run->count) << run->shift;
+
+	int const nu_endpoints = info->nu_regions * 2;
+	int const endpoint_bits = info->endpoint_bits;
+	int32_t endpoints[4][3];
+	for (int c = 0; c < 3; c++) {
+		int32_t const w = isSigned ? SignExtend(fields[c], endpoint_bits) : (int32_t) fields[c];
+		endpoints[0][c] = w;
+		for (int e = 1; e < nu_endpoints; e++) {
+			uint32_t const delta = fields[e * 3 + c];
+			if (info->transformed) {
+				// deltas are always signed, the result wraps to the endpoint precision
+				uint32_t const mask = (1u << endpoint_bits) - 1;
+				uint32_t const value = ((uint32_t) w + (uint32_t) SignExtend(delta, info->delta_bits[c])) & mask;
+				endpoints[e][c] = isSigned ? SignExtend(value, endpoint_bits) : (int32_t) value;
+			} else {
+				endpoints[e][c] = isSigned ? SignExtend(delta, info->delta_bits[c]) : (int32_t) delta;
+			}
+		}
+	}
+	for (int e = 0; e < nu_endpoints; e++)
+		for (int c = 0; c < 3; c++)
+			endpoints[e][c] = Unquantize(endpoints[e][c], endpoint_bits, isSigned);
+
+	uint8_t subset_index[16];
+	uint8_t weights[16];
+	if (info->nu_regions == 1) {
+		// 63 index bits at 65, the anchor (texel 0) has an implicit 0 top bit
+		memset(subset_index, 0, sizeof(subset_index));
+		weights[0] = (uint8_t) detex_bptc_table_aWeight4[detexBlock128ExtractBits(&block, 3)];
+		for (int i = 1; i < 16; i++)
+			weights[i] = (uint8_t) detex_bptc_table_aWeight4[detexBlock128ExtractBits(&block, 4)];
+#if BC6H_DECOMP_SSE2
+		InterpolateOneRegionTexelsSSE2(endpoints, weights, isSigned, pixel_buffer);
+		return true;
+#endif
+	} else {
+		// 46 index bits at 82, both anchors have an implicit 0 top bit
+		int const partition_set_id = (int) detexBlock128ExtractBits(&block, 5);
+		int const anchor = detex_bptc_table_anchor_index_second_subset[partition_set_id];
+		for (int i = 0; i < 16; i++) {
+			subset_index[i] = detex_bptc_table_P2[partition_set_id * 16 + i];
+			int const bits = (i == 0 || i == anchor) ? 2 : 3;
+			weights[i] = (uint8_t) detex_bptc_table_aWeight3[detexBlock128ExtractBits(&block, bits)];
+		}
+	}
+
+	InterpolateTexels(endpoints, subset_index, weights, isSigned, pixel_buffer);
+	return true;
+}
+
+bool detexDecompressBlockBPTC_FLOAT(const uint8_t *bitstring, uint8_t *pixel_buffer) {
+	return DecompressBlockBPTCFloatShared(bitstring, (uint16_t *) pixel_buffer, false);
+}
+
+bool detexDecompressBlockBPTC_SIGNED_FLOAT(const uint8_t *bitstring, uint8_t *pixel_buffer) {
+	return DecompressBlockBPTCFloatShared(bitstring, (uint16_t *) pixel_buffer, true);
+}
+
+bool detexDecompressBlockBPTC_FLOAT(const uint8_t *bitstring, float *texels) {
+	return DecompressBlockBPTCFloatShared(bitstring, texels, false);
+}
+
+bool detexDecompressBlockBPTC_SIGNED_FLOAT(const uint8_t *bitstring, float *texels) {
+	return DecompressBlockBPTCFloatShared(bitstring, texels, true);
+}
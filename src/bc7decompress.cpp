@@ -18,6 +18,12 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 // Modified by Deano 2019-09-04 to fit AL2O3 decompress API
 
 #include "al2o3_platform/platform.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BC7_DECOMP_SSE2 1
+#else
+#define BC7_DECOMP_SSE2 0
+#endif
 
 enum {
 	/* For compression formats that have opaque and non-opaque modes, */
@@ -36,27 +42,21 @@ typedef struct {
 	int index;
 } detexBlock128;
 
+// word level, up to 32 bits at a time. Also used by the BC6H decoder
 uint32_t detexBlock128ExtractBits(detexBlock128 *block, int nu_bits) {
-	uint32_t value = 0;
-	for (int i = 0; i < nu_bits; i++) {
-		if (block->index < 64) {
-			int shift = block->index - i;
-			if (shift < 0)
-				value |= (block->data0 & ((uint64_t) 1 << block->index)) << (-shift);
-			else
-				value |= (block->data0 & ((uint64_t) 1 << block->index)) >> shift;
-		} else {
-			int shift = ((block->index - 64) - i);
-			if (shift < 0)
-				value |= (block->data1 & ((uint64_t) 1 << (block->index - 64))) << (-shift);
-			else
-				value |= (block->data1 & ((uint64_t) 1 << (block->index - 64))) >> shift;
-		}
-		block->index++;
-	}
-	//	if (block->index > 128)
-	//		printf("Block overflow (%d)\n", block->index);
-	return value;
+	int const index = block->index;
+	block->index += nu_bits;
+	if (nu_bits == 0 || index >= 128)
+		return 0;
+
+	uint64_t bits;
+	if (index >= 64)
+		bits = block->data1 >> (index - 64);
+	else if (index == 0)
+		bits = block->data0;
+	else
+		bits = (block->data0 >> index) | (block->data1 << (64 - index));
+	return (uint32_t) (bits & (((uint64_t) 1 << nu_bits) - 1));
 }
 
 static AL2O3_FORCE_INLINE uint32_t detexPixel32GetB8(uint32_t pixel) {
@@ -109,7 +109,7 @@ static AL2O3_FORCE_INLINE uint32_t detexGetBits64(uint64_t data, int bit0, int b
 	return (uint32_t) ((data & mask) >> bit0);
 }
 
-const uint8_t detex_bptc_table_P2[64 * 16] = {
+extern const uint8_t detex_bptc_table_P2[64 * 16] = {
 		0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1,
 		0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1,
 		0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1, 0, 1, 1, 1,
@@ -243,7 +243,7 @@ const uint8_t detex_bptc_table_P3[64 * 16] = {
 		0, 1, 1, 1, 2, 0, 1, 1, 2, 2, 0, 1, 2, 2, 2, 0,
 };
 
-const uint8_t detex_bptc_table_anchor_index_second_subset[64] = {
+extern const uint8_t detex_bptc_table_anchor_index_second_subset[64] = {
 		15, 15, 15, 15, 15, 15, 15, 15,
 		15, 15, 15, 15, 15, 15, 15, 15,
 		15, 2, 8, 2, 2, 8, 8, 15,
@@ -280,11 +280,11 @@ const uint16_t detex_bptc_table_aWeight2[4] = {
 		0, 21, 43, 64
 };
 
-const uint16_t detex_bptc_table_aWeight3[8] = {
+extern const uint16_t detex_bptc_table_aWeight3[8] = {
 		0, 9, 18, 27, 37, 46, 55, 64
 };
 
-const uint16_t detex_bptc_table_aWeight4[16] = {
+extern const uint16_t detex_bptc_table_aWeight4[16] = {
 		0, 4, 9, 13, 17, 21, 26, 30,
 		34, 38, 43, 47, 51, 55, 60, 64
 };
@@ -538,12 +538,23 @@ static const uint8_t IB[8] = {3, 3, 2, 2, 2, 2, 4, 2};
 static const uint8_t IB2[8] = {0, 0, 0, 0, 3, 2, 0, 0};
 static const uint8_t mode_has_partition_bits[8] = {1, 1, 1, 1, 0, 0, 0, 1};
 
-/* Decompress a 128-bit 4x4 pixel texture block compressed using BPTC mode 1. */
+// Everything needed to colour a block's texels once its bits are decoded.
+typedef struct {
+	uint8_t endpoint[3 * 2 * 4];  // subset * 8 + endpoint * 4 + component, components are R G B A.
+	uint8_t subset_index[16];
+	uint8_t color_index[16];
+	uint8_t alpha_index[16];
+	int color_index_bitcount;
+	int alpha_index_bitcount;
+	int rotation;
+} detexBPTCBlockParams;
 
-static bool DecompressBlockBPTCMode1(detexBlock128 *AL2O3_RESTRICT block,
-																		 uint8_t *AL2O3_RESTRICT pixel_buffer) {
-	uint64_t data0 = block->data0;
-	uint64_t data1 = block->data1;
+/* Decode the endpoints and indices of a 128-bit BPTC mode 1 block. */
+
+static AL2O3_FORCE_INLINE void ExtractBlockBPTCMode1(const uint8_t *AL2O3_RESTRICT bitstring,
+																										 detexBPTCBlockParams *AL2O3_RESTRICT params) {
+	uint64_t data0 = *(uint64_t *) &bitstring[0];
+	uint64_t data1 = *(uint64_t *) &bitstring[8];
 	int partition_set_id = detexGetBits64(data0, 2, 7);
 	uint8_t endpoint[2 * 2 * 3];  // 2 subsets.
 	endpoint[0] = detexGetBits64(data0, 8, 13);  // red, subset 0, endpoint 0
@@ -578,58 +589,48 @@ static bool DecompressBlockBPTCMode1(detexBlock128 *AL2O3_RESTRICT block,
 	}
 	for (int i = 0; i < 2 * 2; i++) {
 		// Replicate each component's MSB into the LSB.
-		endpoint[i * 3 + 0] |= endpoint[i * 3 + 0] >> 7;
-		endpoint[i * 3 + 1] |= endpoint[i * 3 + 1] >> 7;
-		endpoint[i * 3 + 2] |= endpoint[i * 3 + 2] >> 7;
+		params->endpoint[i * 4 + 0] = endpoint[i * 3 + 0] | (endpoint[i * 3 + 0] >> 7);
+		params->endpoint[i * 4 + 1] = endpoint[i * 3 + 1] | (endpoint[i * 3 + 1] >> 7);
+		params->endpoint[i * 4 + 2] = endpoint[i * 3 + 2] | (endpoint[i * 3 + 2] >> 7);
+		params->endpoint[i * 4 + 3] = 0xFF;
 	}
 
-	uint8_t subset_index[16];
 	for (int i = 0; i < 16; i++)
 		// subset_index[i] is a number from 0 to 1.
-		subset_index[i] = detex_bptc_table_P2[partition_set_id * 16 + i];
+		params->subset_index[i] = detex_bptc_table_P2[partition_set_id * 16 + i];
 	uint8_t anchor_index[2];
 	anchor_index[0] = 0;
 	anchor_index[1] = detex_bptc_table_anchor_index_second_subset[partition_set_id];
-	uint8_t color_index[16];
 	// Extract primary index bits.
 	data1 >>= 18;
 	for (int i = 0; i < 16; i++)
-		if (i == anchor_index[subset_index[i]]) {
+		if (i == anchor_index[params->subset_index[i]]) {
 			// Highest bit is zero.
-			color_index[i] = data1 & 3; // Get two bits.
+			params->color_index[i] = data1 & 3; // Get two bits.
 			data1 >>= 2;
 		} else {
-			color_index[i] = data1 & 7;  // Get three bits.
+			params->color_index[i] = data1 & 7;  // Get three bits.
 			data1 >>= 3;
 		}
-	uint32_t *pixel32_buffer = (uint32_t *) pixel_buffer;
-	for (int i = 0; i < 16; i++) {
-		uint8_t endpoint_start[3];
-		uint8_t endpoint_end[3];
-		for (int j = 0; j < 3; j++) {
-			endpoint_start[j] = endpoint[2 * subset_index[i] * 3 + j];
-			endpoint_end[j] = endpoint[(2 * subset_index[i] + 1) * 3 + j];
-		}
-		uint32_t output;
-		output = detexPack32R8(Interpolate(endpoint_start[0], endpoint_end[0], color_index[i], 3));
-		output |= detexPack32G8(Interpolate(endpoint_start[1], endpoint_end[1], color_index[i], 3));
-		output |= detexPack32B8(Interpolate(endpoint_start[2], endpoint_end[2], color_index[i], 3));
-		output |= detexPack32A8(0xFF);
-		pixel32_buffer[i] = output;
-	}
-	return true;
+	memset(params->alpha_index, 0, sizeof(params->alpha_index));
+	params->color_index_bitcount = 3;
+	params->alpha_index_bitcount = 3;
+	params->rotation = 0;
 }
 
-/* Decompress a 128-bit 4x4 pixel texture block compressed using the BPTC */
-/* (BC7) format. */
-bool detexDecompressBlockBPTC(const uint8_t * bitstring, uint8_t * pixel_buffer) {
+/* Decode the endpoints and indices of a 128-bit BPTC (BC7) block of a */
+/* known valid mode. */
+static AL2O3_FORCE_INLINE void ExtractBlockBPTC(const uint8_t *AL2O3_RESTRICT bitstring, int mode,
+																								detexBPTCBlockParams *AL2O3_RESTRICT params) {
+	if (mode == 1) {
+		ExtractBlockBPTCMode1(bitstring, params);
+		return;
+	}
+
 	detexBlock128 block;
 	block.data0 = *(uint64_t *) &bitstring[0];
 	block.data1 = *(uint64_t *) &bitstring[8];
-	block.index = 0;
-	int mode = ExtractMode(&block);
-	if (mode == 1)
-		return DecompressBlockBPTCMode1(&block, pixel_buffer);
+	block.index = mode + 1;
 
 	int nu_subsets = 1;
 	int partition_set_id = 0;
@@ -637,29 +638,29 @@ bool detexDecompressBlockBPTC(const uint8_t * bitstring, uint8_t * pixel_buffer)
 		nu_subsets = GetNumberOfSubsets(mode);
 		partition_set_id = ExtractPartitionSetID(&block, mode);
 	}
-	int rotation = ExtractRotationBits(&block, mode);
+	params->rotation = ExtractRotationBits(&block, mode);
 	int index_selection_bit = 0;
 	if (mode == 4)
 		index_selection_bit = detexBlock128ExtractBits(&block, 1);
 
-	int alpha_index_bitcount = GetAlphaIndexBitcount(mode, index_selection_bit);
-	int color_index_bitcount = GetColorIndexBitcount(mode, index_selection_bit);
+	params->alpha_index_bitcount = GetAlphaIndexBitcount(mode, index_selection_bit);
+	params->color_index_bitcount = GetColorIndexBitcount(mode, index_selection_bit);
 
-	uint8_t endpoint_array[3 * 2 * 4];  // Max. 3 subsets.
+	uint8_t *endpoint_array = params->endpoint;  // Max. 3 subsets.
 	ExtractEndpoints(mode, nu_subsets, &block, endpoint_array);
 	FullyDecodeEndpoints(endpoint_array, nu_subsets, mode, &block);
 
-	uint8_t subset_index[16];
+	uint8_t *subset_index = params->subset_index;
 	for (int i = 0; i < 16; i++)
 		// subset_index[i] is a number from 0 to 2, or 0 to 1, or 0 depending on the number of subsets.
 		subset_index[i] = GetPartitionIndex(nu_subsets, partition_set_id, i);
 	uint8_t anchor_index[4] = {0, 0, 0, 0};  // Only need max. 3 elements.
 	for (int i = 0; i < nu_subsets; i++)
 		anchor_index[i] = GetAnchorIndex(partition_set_id, i, nu_subsets);
-	uint8_t color_index[16];
-	uint8_t alpha_index[16];
-	memset(color_index, 0, sizeof(color_index));
-	memset(alpha_index, 0, sizeof(alpha_index));
+	uint8_t *color_index = params->color_index;
+	uint8_t *alpha_index = params->alpha_index;
+	memset(color_index, 0, sizeof(params->color_index));
+	memset(alpha_index, 0, sizeof(params->alpha_index));
 	// Extract primary index bits.
 	uint64_t data1;
 	if (block.index >= 64) {
@@ -733,34 +734,305 @@ bool detexDecompressBlockBPTC(const uint8_t * bitstring, uint8_t * pixel_buffer)
 				}
 			}
 	}
+}
+
+static AL2O3_FORCE_INLINE uint32_t InterpolateTexelBPTC(detexBPTCBlockParams const *AL2O3_RESTRICT params, int i) {
+	uint8_t endpoint_start[4];
+	uint8_t endpoint_end[4];
+	for (int j = 0; j < 4; j++) {
+		endpoint_start[j] = params->endpoint[2 * params->subset_index[i] * 4 + j];
+		endpoint_end[j] = params->endpoint[(2 * params->subset_index[i] + 1) * 4 + j];
+	}
 
+	int const color_index = params->color_index[i];
+	int const color_index_bitcount = params->color_index_bitcount;
+	uint32_t output = 0;
+	output = detexPack32R8(Interpolate(endpoint_start[0], endpoint_end[0], color_index, color_index_bitcount));
+	output |= detexPack32G8(Interpolate(endpoint_start[1], endpoint_end[1], color_index, color_index_bitcount));
+	output |= detexPack32B8(Interpolate(endpoint_start[2], endpoint_end[2], color_index, color_index_bitcount));
+	output |= detexPack32A8(Interpolate(endpoint_start[3], endpoint_end[3], params->alpha_index[i],
+																			params->alpha_index_bitcount));
+
+	int const rotation = params->rotation;
+	if (rotation > 0) {
+		if (rotation == 1)
+			output = detexPack32RGBA8(detexPixel32GetA8(output), detexPixel32GetG8(output),
+																detexPixel32GetB8(output), detexPixel32GetR8(output));
+		else if (rotation == 2)
+			output = detexPack32RGBA8(detexPixel32GetR8(output), detexPixel32GetA8(output),
+																detexPixel32GetB8(output), detexPixel32GetG8(output));
+		else // rotation == 3
+			output = detexPack32RGBA8(detexPixel32GetR8(output), detexPixel32GetG8(output),
+																detexPixel32GetA8(output), detexPixel32GetB8(output));
+	}
+	return output;
+}
+
+static void InterpolateBlockBPTC(detexBPTCBlockParams const *AL2O3_RESTRICT params,
+																 uint8_t *AL2O3_RESTRICT pixel_buffer) {
 	uint32_t *pixel32_buffer = (uint32_t *) pixel_buffer;
 	for (int i = 0; i < 16; i++) {
-		uint8_t endpoint_start[4];
-		uint8_t endpoint_end[4];
-		for (int j = 0; j < 4; j++) {
-			endpoint_start[j] = endpoint_array[2 * subset_index[i] * 4 + j];
-			endpoint_end[j] = endpoint_array[(2 * subset_index[i] + 1) * 4 + j];
+		pixel32_buffer[i] = InterpolateTexelBPTC(params, i);
+	}
+}
+
+// float or half RGBA output, each 8 bit channel converted by table as it is written
+template<typename T>
+static void InterpolateBlockBPTC(detexBPTCBlockParams const *AL2O3_RESTRICT params,
+																 T *AL2O3_RESTRICT texels,
+																 T const *colour,
+																 T const *alpha) {
+	for (int i = 0; i < 16; i++) {
+		uint32_t const pixel = InterpolateTexelBPTC(params, i);
+		texels[i * 4 + 0] = colour[detexPixel32GetR8(pixel)];
+		texels[i * 4 + 1] = colour[detexPixel32GetG8(pixel)];
+		texels[i * 4 + 2] = colour[detexPixel32GetB8(pixel)];
+		texels[i * 4 + 3] = alpha[detexPixel32GetA8(pixel)];
+	}
+}
+
+/* Decompress a 128-bit 4x4 pixel texture block compressed using the BPTC */
+/* (BC7) format. Returns false for the reserved mode, which decodes to zeros. */
+bool detexDecompressBlockBPTC(const uint8_t * bitstring, uint8_t * pixel_buffer) {
+	detexBlock128 block;
+	block.data0 = *(uint64_t *) &bitstring[0];
+	block.data1 = *(uint64_t *) &bitstring[8];
+	block.index = 0;
+	int mode = ExtractMode(&block);
+	if (mode < 0) {
+		memset(pixel_buffer, 0, 16 * sizeof(uint32_t));
+		return false;
+	}
+
+	detexBPTCBlockParams params;
+	ExtractBlockBPTC(bitstring, mode, &params);
+	InterpolateBlockBPTC(&params, pixel_buffer);
+	return true;
+}
+
+template<typename T>
+static bool DecompressBlockBPTCConverted(const uint8_t *bitstring, T *texels, T const *colour, T const *alpha) {
+	detexBlock128 block;
+	block.data0 = *(uint64_t *) &bitstring[0];
+	block.data1 = *(uint64_t *) &bitstring[8];
+	block.index = 0;
+	int mode = ExtractMode(&block);
+	if (mode < 0) {
+		memset(texels, 0, 16 * 4 * sizeof(T));
+		return false;
+	}
+
+	detexBPTCBlockParams params;
+	ExtractBlockBPTC(bitstring, mode, &params);
+	InterpolateBlockBPTC(&params, texels, colour, alpha);
+	return true;
+}
+
+bool detexDecompressBlockBPTC(const uint8_t *bitstring, float *texels, float const *colour, float const *alpha) {
+	return DecompressBlockBPTCConverted(bitstring, texels, colour, alpha);
+}
+
+bool detexDecompressBlockBPTC(const uint8_t *bitstring, uint16_t *texels, uint16_t const *colour, uint16_t const *alpha) {
+	return DecompressBlockBPTCConverted(bitstring, texels, colour, alpha);
+}
+
+// Bucketed decode of many blocks. A strip of blocks is sorted into per mode lists so the bit extraction of
+// each list is specialised for its mode, then blocks go through the interpolation a lane each, 16 at a time,
+// in structure of arrays form and the pixels are scattered back to each block's place in the output.
+
+#define DETEX_BPTC_LANES 16
+#define DETEX_BPTC_STRIP_BLOCKS 256
+
+// [...][lane], output bytes are B G R A
+typedef struct {
+	uint8_t endpoint[3][2][4][DETEX_BPTC_LANES];  // subset, start or end, output byte
+	uint8_t alpha_weighted[4][DETEX_BPTC_LANES];  // 0xFF where the output byte uses the alpha weights
+	uint8_t subset[16][DETEX_BPTC_LANES];
+	uint8_t color_weight[16][DETEX_BPTC_LANES];
+	uint8_t alpha_weight[16][DETEX_BPTC_LANES];
+} detexBPTCLanes;
+
+static AL2O3_FORCE_INLINE uint16_t const *GetWeightTable(int indexprecision) {
+	if (indexprecision == 2)
+		return detex_bptc_table_aWeight2;
+	else if (indexprecision == 3)
+		return detex_bptc_table_aWeight3;
+	else // indexprecision == 4
+		return detex_bptc_table_aWeight4;
+}
+
+// rotation is folded in here, the output byte swapped with alpha takes alpha's endpoints and weights
+static AL2O3_FORCE_INLINE void TransposeBlockToLane(detexBPTCBlockParams const *AL2O3_RESTRICT params,
+																										int nu_subsets,
+																										uint32_t lane,
+																										detexBPTCLanes *AL2O3_RESTRICT lanes) {
+	static const int component_of_byte[4] = {2, 1, 0, 3};
+	int source[4] = {0, 1, 2, 3};
+	if (params->rotation > 0) {
+		source[params->rotation - 1] = 3;
+		source[3] = params->rotation - 1;
+	}
+	for (int c = 0; c < 4; c++) {
+		int const component = source[component_of_byte[c]];
+		for (int j = 0; j < nu_subsets; j++) {
+			lanes->endpoint[j][0][c][lane] = params->endpoint[j * 8 + component];
+			lanes->endpoint[j][1][c][lane] = params->endpoint[j * 8 + 4 + component];
 		}
+		lanes->alpha_weighted[c][lane] = (component == 3) ? 0xFF : 0;
+	}
 
-		uint32_t output = 0;
-		output = detexPack32R8(Interpolate(endpoint_start[0], endpoint_end[0], color_index[i], color_index_bitcount));
-		output |= detexPack32G8(Interpolate(endpoint_start[1], endpoint_end[1], color_index[i], color_index_bitcount));
-		output |= detexPack32B8(Interpolate(endpoint_start[2], endpoint_end[2], color_index[i], color_index_bitcount));
-		output |= detexPack32A8(Interpolate(endpoint_start[3], endpoint_end[3], alpha_index[i], alpha_index_bitcount));
-
-		if (rotation > 0) {
-			if (rotation == 1)
-				output = detexPack32RGBA8(detexPixel32GetA8(output), detexPixel32GetG8(output),
-																	detexPixel32GetB8(output), detexPixel32GetR8(output));
-			else if (rotation == 2)
-				output = detexPack32RGBA8(detexPixel32GetR8(output), detexPixel32GetA8(output),
-																	detexPixel32GetB8(output), detexPixel32GetG8(output));
-			else // rotation == 3
-				output = detexPack32RGBA8(detexPixel32GetR8(output), detexPixel32GetG8(output),
-																	detexPixel32GetA8(output), detexPixel32GetB8(output));
+	uint16_t const *color_weight = GetWeightTable(params->color_index_bitcount);
+	uint16_t const *alpha_weight = GetWeightTable(params->alpha_index_bitcount);
+	for (int i = 0; i < 16; i++) {
+		lanes->subset[i][lane] = params->subset_index[i];
+		lanes->color_weight[i][lane] = (uint8_t) color_weight[params->color_index[i]];
+		lanes->alpha_weight[i][lane] = (uint8_t) alpha_weight[params->alpha_index[i]];
+	}
+}
+
+#if BC7_DECOMP_SSE2
+static AL2O3_FORCE_INLINE __m128i SelectBytes(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+static AL2O3_FORCE_INLINE __m128i LoadLanes(uint8_t const *lanes) {
+	return _mm_loadu_si128((__m128i const *) lanes);
+}
+
+template<int nu_subsets>
+static void InterpolateLanesBPTC(detexBPTCLanes const *AL2O3_RESTRICT lanes,
+																 uint32_t pixels[16][DETEX_BPTC_LANES]) {
+	__m128i const zero = _mm_setzero_si128();
+	__m128i const sixtyFour = _mm_set1_epi16(64);
+	__m128i const round = _mm_set1_epi16(32);
+	__m128i alpha_weighted[4];
+	for (int c = 0; c < 4; c++)
+		alpha_weighted[c] = LoadLanes(lanes->alpha_weighted[c]);
+
+	for (int i = 0; i < 16; i++) {
+		__m128i const subset = LoadLanes(lanes->subset[i]);
+		__m128i const in_subset1 = _mm_cmpeq_epi8(subset, _mm_set1_epi8(1));
+		__m128i const in_subset2 = _mm_cmpeq_epi8(subset, _mm_set1_epi8(2));
+		__m128i const color_weight = LoadLanes(lanes->color_weight[i]);
+		__m128i const alpha_weight = LoadLanes(lanes->alpha_weight[i]);
+		__m128i channel[4];
+		for (int c = 0; c < 4; c++) {
+			__m128i e0 = LoadLanes(lanes->endpoint[0][0][c]);
+			__m128i e1 = LoadLanes(lanes->endpoint[0][1][c]);
+			if (nu_subsets > 1) {
+				e0 = SelectBytes(in_subset1, LoadLanes(lanes->endpoint[1][0][c]), e0);
+				e1 = SelectBytes(in_subset1, LoadLanes(lanes->endpoint[1][1][c]), e1);
+			}
+			if (nu_subsets > 2) {
+				e0 = SelectBytes(in_subset2, LoadLanes(lanes->endpoint[2][0][c]), e0);
+				e1 = SelectBytes(in_subset2, LoadLanes(lanes->endpoint[2][1][c]), e1);
+			}
+			__m128i const w = SelectBytes(alpha_weighted[c], alpha_weight, color_weight);
+			__m128i const wlo = _mm_unpacklo_epi8(w, zero);
+			__m128i const whi = _mm_unpackhi_epi8(w, zero);
+			// (64 - w) * e0 + w * e1 + 32 is at most 16352 so stays in 16 bits
+			__m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(e0, zero), _mm_sub_epi16(sixtyFour, wlo)),
+																 _mm_mullo_epi16(_mm_unpacklo_epi8(e1, zero), wlo));
+			__m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(e0, zero), _mm_sub_epi16(sixtyFour, whi)),
+																 _mm_mullo_epi16(_mm_unpackhi_epi8(e1, zero), whi));
+			lo = _mm_srli_epi16(_mm_add_epi16(lo, round), 6);
+			hi = _mm_srli_epi16(_mm_add_epi16(hi, round), 6);
+			channel[c] = _mm_packus_epi16(lo, hi);
 		}
-		pixel32_buffer[i] = output;
+		// interleave the B G R A planes into BGRA pixels, 4 lanes per store
+		__m128i const bglo = _mm_unpacklo_epi8(channel[0], channel[1]);
+		__m128i const bghi = _mm_unpackhi_epi8(channel[0], channel[1]);
+		__m128i const ralo = _mm_unpacklo_epi8(channel[2], channel[3]);
+		__m128i const rahi = _mm_unpackhi_epi8(channel[2], channel[3]);
+		_mm_storeu_si128((__m128i *) &pixels[i][0], _mm_unpacklo_epi16(bglo, ralo));
+		_mm_storeu_si128((__m128i *) &pixels[i][4], _mm_unpackhi_epi16(bglo, ralo));
+		_mm_storeu_si128((__m128i *) &pixels[i][8], _mm_unpacklo_epi16(bghi, rahi));
+		_mm_storeu_si128((__m128i *) &pixels[i][12], _mm_unpackhi_epi16(bghi, rahi));
+	}
+}
+#else
+template<int nu_subsets>
+static void InterpolateLanesBPTC(detexBPTCLanes const *AL2O3_RESTRICT lanes,
+																 uint32_t pixels[16][DETEX_BPTC_LANES]) {
+	for (int i = 0; i < 16; i++) {
+		for (int l = 0; l < DETEX_BPTC_LANES; l++) {
+			int const subset = (nu_subsets > 1) ? lanes->subset[i][l] : 0;
+			uint32_t output = 0;
+			for (int c = 0; c < 4; c++) {
+				int const w = lanes->alpha_weighted[c][l] ? lanes->alpha_weight[i][l] : lanes->color_weight[i][l];
+				int const e0 = lanes->endpoint[subset][0][c][l];
+				int const e1 = lanes->endpoint[subset][1][c][l];
+				output |= (uint32_t) (((64 - w) * e0 + w * e1 + 32) >> 6) << (c * 8);
+			}
+			pixels[i][l] = output;
+		}
+	}
+}
+#endif
+
+template<int mode, int nu_subsets>
+static void DecompressModeBucketBPTC(const uint8_t *AL2O3_RESTRICT bitstrings,
+																		 uint8_t const *AL2O3_RESTRICT bucket,
+																		 uint32_t count,
+																		 uint8_t *AL2O3_RESTRICT pixel_buffers) {
+	// spare lanes of a partial batch are decoded too, so must hold something
+	detexBPTCLanes lanes;
+	memset(&lanes, 0, sizeof(lanes));
+	uint32_t pixels[16][DETEX_BPTC_LANES];
+	for (uint32_t start = 0; start < count; start += DETEX_BPTC_LANES) {
+		uint32_t const n = (count - start < DETEX_BPTC_LANES) ? count - start : DETEX_BPTC_LANES;
+		for (uint32_t l = 0; l < n; l++) {
+			detexBPTCBlockParams params;
+			ExtractBlockBPTC(bitstrings + bucket[start + l] * 16, mode, &params);
+			TransposeBlockToLane(&params, nu_subsets, l, &lanes);
+		}
+
+		InterpolateLanesBPTC<nu_subsets>(&lanes, pixels);
+
+		for (uint32_t l = 0; l < n; l++) {
+			uint32_t *pixel32_buffer = (uint32_t *) (pixel_buffers + bucket[start + l] * 16 * sizeof(uint32_t));
+			for (int i = 0; i < 16; i++)
+				pixel32_buffer[i] = pixels[i][l];
+		}
+	}
+}
+
+typedef void (*detexModeBucketFunc)(const uint8_t *, uint8_t const *, uint32_t, uint8_t *);
+
+static const detexModeBucketFunc mode_bucket_func[8] = {
+		DecompressModeBucketBPTC<0, 3>, DecompressModeBucketBPTC<1, 2>, DecompressModeBucketBPTC<2, 3>,
+		DecompressModeBucketBPTC<3, 2>, DecompressModeBucketBPTC<4, 1>, DecompressModeBucketBPTC<5, 1>,
+		DecompressModeBucketBPTC<6, 1>, DecompressModeBucketBPTC<7, 2>,
+};
+
+/* Decompress count consecutive 128-bit BPTC (BC7) blocks into count 4x4 */
+/* pixel blocks, the same output as detexDecompressBlockBPTC per block. */
+void detexDecompressBlocksBPTC(const uint8_t *AL2O3_RESTRICT bitstrings,
+															 uint32_t count,
+															 uint8_t *AL2O3_RESTRICT pixel_buffers) {
+	while (count > 0) {
+		uint32_t const n = (count < DETEX_BPTC_STRIP_BLOCKS) ? count : DETEX_BPTC_STRIP_BLOCKS;
+
+		// the mode is the lowest set bit of the first byte, bucket 8 is the reserved mode
+		uint8_t bucket[9][DETEX_BPTC_STRIP_BLOCKS];
+		uint32_t bucket_count[9] = {0};
+		for (uint32_t b = 0; b < n; b++) {
+			uint32_t const first = bitstrings[b * 16];
+			int mode = 0;
+			while (mode < 8 && !(first & (1 << mode)))
+				mode++;
+			bucket[mode][bucket_count[mode]++] = (uint8_t) b;
+		}
+
+		for (int mode = 0; mode < 8; mode++) {
+			if (bucket_count[mode])
+				mode_bucket_func[mode](bitstrings, bucket[mode], bucket_count[mode], pixel_buffers);
+		}
+		for (uint32_t b = 0; b < bucket_count[8]; b++)
+			memset(pixel_buffers + bucket[8][b] * 16 * sizeof(uint32_t), 0, 16 * sizeof(uint32_t));
+
+		bitstrings += n * 16;
+		pixel_buffers += n * 16 * sizeof(uint32_t);
+		count -= n;
 	}
-	return true;
 }
@@ -0,0 +1,72 @@
+// Box filtered mip reduction for decoding with a mip chain, each decode tile reduces its own texels while they are
+// in cache and the levels smaller than a tile are reduced afterwards, see DecompressMipTiles.
+
+#include "al2o3_platform/platform.h"
+#include "tiny_imageformat/tinyimageformat_base.h"
+#include "gfx_image/image.h"
+
+// in decompressstore.cpp
+extern float const *SRGBToLinearTable();
+extern uint8_t EncodeLinearToSRGB8(float linear);
+
+static bool MipFormatLayout(TinyImageFormat format, uint32_t *channels, bool *isSRGB) {
+	*isSRGB = false;
+	switch (format) {
+		case TinyImageFormat_R8_UNORM: *channels = 1;
+			return true;
+		case TinyImageFormat_R8G8_UNORM: *channels = 2;
+			return true;
+		case TinyImageFormat_B8G8R8A8_UNORM: *channels = 4;
+			return true;
+		case TinyImageFormat_B8G8R8A8_SRGB: *channels = 4;
+			*isSRGB = true;
+			return true;
+		default: return false;
+	}
+}
+
+bool CanReduceMipFormat(TinyImageFormat format) {
+	uint32_t channels;
+	bool isSRGB;
+	return MipFormatLayout(format, &channels, &isSRGB);
+}
+
+// dst texels [x0, x1) x [y0, y1) of slice w average the 2x2 src texels under them, sRGB colour in linear space.
+// An odd last src row or column is dropped, so every dst texel only reads texels of the src tile above it
+void ReduceMipRegion(Image_ImageHeader const *src,
+										 Image_ImageHeader const *dst,
+										 uint32_t x0,
+										 uint32_t y0,
+										 uint32_t x1,
+										 uint32_t y1,
+										 uint32_t w) {
+	uint32_t channels;
+	bool isSRGB;
+	if (!MipFormatLayout(dst->format, &channels, &isSRGB)) {
+		return;
+	}
+	float const *linear = SRGBToLinearTable();
+	uint8_t const *srcData = (uint8_t const *) Image_RawDataPtr(src);
+	uint8_t *dstData = (uint8_t *) Image_RawDataPtr(dst);
+
+	for (uint32_t y = y0; y < y1; ++y) {
+		uint32_t const sy1 = (2 * y + 1 < src->height) ? 2 * y + 1 : src->height - 1;
+		uint8_t const *row0 = srcData + Image_CalculateIndex(src, 0, 2 * y, 0, w) * channels;
+		uint8_t const *row1 = srcData + Image_CalculateIndex(src, 0, sy1, 0, w) * channels;
+		uint8_t *out = dstData + Image_CalculateIndex(dst, 0, y, 0, w) * channels;
+
+		for (uint32_t x = x0; x < x1; ++x) {
+			uint32_t const sx0 = 2 * x * channels;
+			uint32_t const sx1 = ((2 * x + 1 < src->width) ? 2 * x + 1 : src->width - 1) * channels;
+			for (uint32_t c = 0; c < channels; ++c) {
+				if (isSRGB && c < 3) {
+					float const sum = linear[row0[sx0 + c]] + linear[row0[sx1 + c]] + linear[row1[sx0 + c]] + linear[row1[sx1 + c]];
+					out[x * channels + c] = EncodeLinearToSRGB8(sum * 0.25f);
+				} else {
+					uint32_t const sum = row0[sx0 + c] + row0[sx1 + c] + row1[sx0 + c] + row1[sx1 + c];
+					out[x * channels + c] = (uint8_t) ((sum + 2) >> 2);
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,743 @@
+// Store stage conversions. The block kernels decode to their default format and these write each decoded
+// row of texels into the image's format while the block is still in cache, see WriteDecompressedBlock.
+
+#include "al2o3_platform/platform.h"
+#include "tiny_imageformat/tinyimageformat_base.h"
+#include <math.h>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define STORE_SSE2 1
+#else
+#define STORE_SSE2 0
+#endif
+
+typedef void (*storeFunc)(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount);
+typedef void (*premultiplyFunc)(uint8_t *decoded, uint32_t texelCount);
+
+static AL2O3_FORCE_INLINE uint32_t FloatBits(float f) {
+	uint32_t bits;
+	memcpy(&bits, &f, sizeof(uint32_t));
+	return bits;
+}
+
+static AL2O3_FORCE_INLINE float BitsFloat(uint32_t bits) {
+	float f;
+	memcpy(&f, &bits, sizeof(float));
+	return f;
+}
+
+// round to nearest even, overflow goes to infinity and NaNs stay NaNs
+uint16_t FloatToHalf(float f) {
+	uint32_t const bits = FloatBits(f);
+	uint16_t const sign = (uint16_t) ((bits >> 16) & 0x8000);
+	uint32_t const absBits = bits & 0x7FFFFFFF;
+	if (absBits >= 0x7F800000) {
+		return sign | 0x7C00 | (absBits > 0x7F800000 ? 0x200 : 0);
+	}
+	if (absBits >= 0x477FF000) {
+		return sign | 0x7C00;
+	}
+	if (absBits < 0x38800000) {
+		// subnormal half, let the float adder do the rounding (rounding up to 0x400 is the smallest normal)
+		return sign | (uint16_t) (FloatBits(BitsFloat(absBits) + 0.5f) - 0x3F000000);
+	}
+	uint32_t const rounded = absBits + 0xFFF + ((absBits >> 13) & 1);
+	return sign | (uint16_t) ((rounded - 0x38000000) >> 13);
+}
+
+float HalfToFloat(uint16_t h) {
+	uint32_t const sign = (uint32_t) (h & 0x8000) << 16;
+	uint32_t const exponent = (h >> 10) & 0x1F;
+	uint32_t const mantissa = h & 0x3FF;
+	if (exponent == 0) {
+		// zero or subnormal, mantissa * 2^-24
+		float const f = (float) mantissa * (1.0f / 16777216.0f);
+		return BitsFloat(FloatBits(f) | sign);
+	}
+	if (exponent == 31) {
+		return BitsFloat(sign | 0x7F800000 | (mantissa << 13));
+	}
+	return BitsFloat(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+static double SRGBToLinear(double c) {
+	return c <= 0.04045 ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+}
+
+// every 8 bit sRGB encoded value decoded to linear, as a float and as a half.
+// encodeThreshold[i] is the linear value halfway (in sRGB) between encodings i and i + 1
+struct SRGBLinearTable {
+	float f[256];
+	uint16_t h[256];
+	float encodeThreshold[256];
+	SRGBLinearTable() {
+		for (uint32_t i = 0; i < 256; ++i) {
+			f[i] = (float) SRGBToLinear((double) i / 255.0);
+			h[i] = FloatToHalf(f[i]);
+			encodeThreshold[i] = (i < 255) ? (float) SRGBToLinear(((double) i + 0.5) / 255.0) : INFINITY;
+		}
+	}
+};
+
+static SRGBLinearTable const *SRGBLinear() {
+	static SRGBLinearTable const table;
+	return &table;
+}
+
+static AL2O3_FORCE_INLINE float SNorm8ToFloat(uint8_t v) {
+	float const f = (float) (int8_t) v / 127.0f;
+	return f < -1.0f ? -1.0f : f;
+}
+
+// every 8 bit UNORM and SNORM value as a float and as a half, the same conversions as the stores below.
+// The float and half block decoders convert each decoded channel with these
+struct Norm8Table {
+	float unormF[256];
+	float snormF[256];
+	uint16_t unormH[256];
+	uint16_t snormH[256];
+	Norm8Table() {
+		for (uint32_t i = 0; i < 256; ++i) {
+			unormF[i] = (float) i / 255.0f;
+			snormF[i] = SNorm8ToFloat((uint8_t) i);
+			unormH[i] = FloatToHalf(unormF[i]);
+			snormH[i] = FloatToHalf(snormF[i]);
+		}
+	}
+};
+
+static Norm8Table const *Norm8() {
+	static Norm8Table const table;
+	return &table;
+}
+
+float const *UNorm8ToFloatTable() {
+	return Norm8()->unormF;
+}
+
+float const *SNorm8ToFloatTable() {
+	return Norm8()->snormF;
+}
+
+uint16_t const *UNorm8ToHalfTable() {
+	return Norm8()->unormH;
+}
+
+uint16_t const *SNorm8ToHalfTable() {
+	return Norm8()->snormH;
+}
+
+static AL2O3_FORCE_INLINE float SNorm16ToFloat(uint16_t v) {
+	float const f = (float) (int16_t) v / 32767.0f;
+	return f < -1.0f ? -1.0f : f;
+}
+
+void StoreBGRA8AsRGBA8(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		uint32_t texel;
+		memcpy(&texel, decoded + i * 4, sizeof(uint32_t));
+		texel = (texel & 0xFF00FF00) | ((texel >> 16) & 0xFF) | ((texel & 0xFF) << 16);
+		memcpy(dst + i * 4, &texel, sizeof(uint32_t));
+	}
+}
+
+void StoreBGRA8AsBGRX8(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		uint32_t texel;
+		memcpy(&texel, decoded + i * 4, sizeof(uint32_t));
+		texel |= 0xFF000000;
+		memcpy(dst + i * 4, &texel, sizeof(uint32_t));
+	}
+}
+
+void StoreBGRA8AsRGB8(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		dst[i * 3 + 0] = decoded[i * 4 + 2];
+		dst[i * 3 + 1] = decoded[i * 4 + 1];
+		dst[i * 3 + 2] = decoded[i * 4 + 0];
+	}
+}
+
+void StoreBGRA8AsBGR8(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		dst[i * 3 + 0] = decoded[i * 4 + 0];
+		dst[i * 3 + 1] = decoded[i * 4 + 1];
+		dst[i * 3 + 2] = decoded[i * 4 + 2];
+	}
+}
+
+void StoreBGRA8AsRGBA32F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	float *out = (float *) dst;
+	uint32_t i = 0;
+#if STORE_SSE2
+	__m128i const zero = _mm_setzero_si128();
+	__m128 const scale = _mm_set1_ps(255.0f);
+	for (; i + 4 <= texelCount; i += 4) {
+		__m128i const texels = _mm_loadu_si128((__m128i const *) (decoded + i * 4));
+		__m128i const lo = _mm_unpacklo_epi8(texels, zero);
+		__m128i const hi = _mm_unpackhi_epi8(texels, zero);
+		__m128i const bgra[4] = {
+				_mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero),
+				_mm_unpacklo_epi16(hi, zero), _mm_unpackhi_epi16(hi, zero),
+		};
+		for (uint32_t j = 0; j < 4; ++j) {
+			__m128 const f = _mm_div_ps(_mm_cvtepi32_ps(bgra[j]), scale);
+			_mm_storeu_ps(out + (i + j) * 4, _mm_shuffle_ps(f, f, _MM_SHUFFLE(3, 0, 1, 2)));
+		}
+	}
+#endif
+	for (; i < texelCount; ++i) {
+		out[i * 4 + 0] = (float) decoded[i * 4 + 2] / 255.0f;
+		out[i * 4 + 1] = (float) decoded[i * 4 + 1] / 255.0f;
+		out[i * 4 + 2] = (float) decoded[i * 4 + 0] / 255.0f;
+		out[i * 4 + 3] = (float) decoded[i * 4 + 3] / 255.0f;
+	}
+}
+
+void StoreBGRA8AsRGBA16F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	uint16_t const *half = UNorm8ToHalfTable();
+	uint16_t *out = (uint16_t *) dst;
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		out[i * 4 + 0] = half[decoded[i * 4 + 2]];
+		out[i * 4 + 1] = half[decoded[i * 4 + 1]];
+		out[i * 4 + 2] = half[decoded[i * 4 + 0]];
+		out[i * 4 + 3] = half[decoded[i * 4 + 3]];
+	}
+}
+
+// alpha isn't sRGB encoded so converts like UNORM
+void StoreSRGBA8AsLinearRGBA32F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	float const *linear = SRGBLinear()->f;
+	float *out = (float *) dst;
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		out[i * 4 + 0] = linear[decoded[i * 4 + 2]];
+		out[i * 4 + 1] = linear[decoded[i * 4 + 1]];
+		out[i * 4 + 2] = linear[decoded[i * 4 + 0]];
+		out[i * 4 + 3] = (float) decoded[i * 4 + 3] / 255.0f;
+	}
+}
+
+void StoreSRGBA8AsLinearRGBA16F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	uint16_t const *linear = SRGBLinear()->h;
+	uint16_t const *half = UNorm8ToHalfTable();
+	uint16_t *out = (uint16_t *) dst;
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		out[i * 4 + 0] = linear[decoded[i * 4 + 2]];
+		out[i * 4 + 1] = linear[decoded[i * 4 + 1]];
+		out[i * 4 + 2] = linear[decoded[i * 4 + 0]];
+		out[i * 4 + 3] = half[decoded[i * 4 + 3]];
+	}
+}
+
+// linear to the nearest 8 bit sRGB encoding, a binary search of the encode thresholds
+static AL2O3_FORCE_INLINE uint8_t LinearToSRGB8(SRGBLinearTable const *table, float linear) {
+	uint32_t v = 0;
+	for (uint32_t step = 128; step; step >>= 1) {
+		if (linear >= table->encodeThreshold[v + step - 1]) {
+			v += step;
+		}
+	}
+	return (uint8_t) v;
+}
+
+// for the mip reduction in decompressmips.cpp and the float and half block decoders
+float const *SRGBToLinearTable() {
+	return SRGBLinear()->f;
+}
+
+uint16_t const *SRGBToLinearHalfTable() {
+	return SRGBLinear()->h;
+}
+
+uint8_t EncodeLinearToSRGB8(float linear) {
+	return LinearToSRGB8(SRGBLinear(), linear);
+}
+
+void StoreBGRA8AsPremultipliedRGBA32F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	float *out = (float *) dst;
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		float const alpha = (float) decoded[i * 4 + 3] / 255.0f;
+		out[i * 4 + 0] = (float) decoded[i * 4 + 2] / 255.0f * alpha;
+		out[i * 4 + 1] = (float) decoded[i * 4 + 1] / 255.0f * alpha;
+		out[i * 4 + 2] = (float) decoded[i * 4 + 0] / 255.0f * alpha;
+		out[i * 4 + 3] = alpha;
+	}
+}
+
+void StoreBGRA8AsPremultipliedRGBA16F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	uint16_t const *half = UNorm8ToHalfTable();
+	uint16_t *out = (uint16_t *) dst;
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		float const alpha = (float) decoded[i * 4 + 3] / 255.0f;
+		out[i * 4 + 0] = FloatToHalf((float) decoded[i * 4 + 2] / 255.0f * alpha);
+		out[i * 4 + 1] = FloatToHalf((float) decoded[i * 4 + 1] / 255.0f * alpha);
+		out[i * 4 + 2] = FloatToHalf((float) decoded[i * 4 + 0] / 255.0f * alpha);
+		out[i * 4 + 3] = half[decoded[i * 4 + 3]];
+	}
+}
+
+void StoreSRGBA8AsPremultipliedLinearRGBA32F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	float const *linear = SRGBLinear()->f;
+	float *out = (float *) dst;
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		float const alpha = (float) decoded[i * 4 + 3] / 255.0f;
+		out[i * 4 + 0] = linear[decoded[i * 4 + 2]] * alpha;
+		out[i * 4 + 1] = linear[decoded[i * 4 + 1]] * alpha;
+		out[i * 4 + 2] = linear[decoded[i * 4 + 0]] * alpha;
+		out[i * 4 + 3] = alpha;
+	}
+}
+
+void StoreSRGBA8AsPremultipliedLinearRGBA16F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	float const *linear = SRGBLinear()->f;
+	uint16_t const *half = UNorm8ToHalfTable();
+	uint16_t *out = (uint16_t *) dst;
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		float const alpha = (float) decoded[i * 4 + 3] / 255.0f;
+		out[i * 4 + 0] = FloatToHalf(linear[decoded[i * 4 + 2]] * alpha);
+		out[i * 4 + 1] = FloatToHalf(linear[decoded[i * 4 + 1]] * alpha);
+		out[i * 4 + 2] = FloatToHalf(linear[decoded[i * 4 + 0]] * alpha);
+		out[i * 4 + 3] = half[decoded[i * 4 + 3]];
+	}
+}
+
+// 8 and 16 bit single and dual channel formats convert component by component
+static void UNorm8AsF32(uint8_t const *decoded, float *out, uint32_t count) {
+	uint32_t i = 0;
+#if STORE_SSE2
+	__m128i const zero = _mm_setzero_si128();
+	__m128 const scale = _mm_set1_ps(255.0f);
+	for (; i + 16 <= count; i += 16) {
+		__m128i const v = _mm_loadu_si128((__m128i const *) (decoded + i));
+		__m128i const lo = _mm_unpacklo_epi8(v, zero);
+		__m128i const hi = _mm_unpackhi_epi8(v, zero);
+		_mm_storeu_ps(out + i + 0, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(lo, zero)), scale));
+		_mm_storeu_ps(out + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(lo, zero)), scale));
+		_mm_storeu_ps(out + i + 8, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(hi, zero)), scale));
+		_mm_storeu_ps(out + i + 12, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(hi, zero)), scale));
+	}
+#endif
+	for (; i < count; ++i) {
+		out[i] = (float) decoded[i] / 255.0f;
+	}
+}
+
+static void SNorm8AsF32(uint8_t const *decoded, float *out, uint32_t count) {
+	for (uint32_t i = 0; i < count; ++i) {
+		out[i] = SNorm8ToFloat(decoded[i]);
+	}
+}
+
+static void UNorm16AsF32(uint8_t const *decoded, float *out, uint32_t count) {
+	uint16_t const *in = (uint16_t const *) decoded;
+	uint32_t i = 0;
+#if STORE_SSE2
+	__m128i const zero = _mm_setzero_si128();
+	__m128 const scale = _mm_set1_ps(65535.0f);
+	for (; i + 8 <= count; i += 8) {
+		__m128i const v = _mm_loadu_si128((__m128i const *) (in + i));
+		_mm_storeu_ps(out + i + 0, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpacklo_epi16(v, zero)), scale));
+		_mm_storeu_ps(out + i + 4, _mm_div_ps(_mm_cvtepi32_ps(_mm_unpackhi_epi16(v, zero)), scale));
+	}
+#endif
+	for (; i < count; ++i) {
+		out[i] = (float) in[i] / 65535.0f;
+	}
+}
+
+static void SNorm16AsF32(uint8_t const *decoded, float *out, uint32_t count) {
+	uint16_t const *in = (uint16_t const *) decoded;
+	for (uint32_t i = 0; i < count; ++i) {
+		out[i] = SNorm16ToFloat(in[i]);
+	}
+}
+
+static void UNorm8AsF16(uint8_t const *decoded, uint16_t *out, uint32_t count) {
+	uint16_t const *half = UNorm8ToHalfTable();
+	for (uint32_t i = 0; i < count; ++i) {
+		out[i] = half[decoded[i]];
+	}
+}
+
+static void SNorm8AsF16(uint8_t const *decoded, uint16_t *out, uint32_t count) {
+	for (uint32_t i = 0; i < count; ++i) {
+		out[i] = FloatToHalf(SNorm8ToFloat(decoded[i]));
+	}
+}
+
+static void UNorm16AsF16(uint8_t const *decoded, uint16_t *out, uint32_t count) {
+	uint16_t const *in = (uint16_t const *) decoded;
+	for (uint32_t i = 0; i < count; ++i) {
+		out[i] = FloatToHalf((float) in[i] / 65535.0f);
+	}
+}
+
+static void SNorm16AsF16(uint8_t const *decoded, uint16_t *out, uint32_t count) {
+	uint16_t const *in = (uint16_t const *) decoded;
+	for (uint32_t i = 0; i < count; ++i) {
+		out[i] = FloatToHalf(SNorm16ToFloat(in[i]));
+	}
+}
+
+void StoreR8AsR32F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	UNorm8AsF32(decoded, (float *) dst, texelCount);
+}
+
+void StoreR8G8AsR32G32F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	UNorm8AsF32(decoded, (float *) dst, texelCount * 2);
+}
+
+void StoreR8SNormAsR32F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	SNorm8AsF32(decoded, (float *) dst, texelCount);
+}
+
+void StoreR8G8SNormAsR32G32F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	SNorm8AsF32(decoded, (float *) dst, texelCount * 2);
+}
+
+void StoreR16AsR32F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	UNorm16AsF32(decoded, (float *) dst, texelCount);
+}
+
+void StoreR16G16AsR32G32F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	UNorm16AsF32(decoded, (float *) dst, texelCount * 2);
+}
+
+void StoreR16SNormAsR32F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	SNorm16AsF32(decoded, (float *) dst, texelCount);
+}
+
+void StoreR16G16SNormAsR32G32F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	SNorm16AsF32(decoded, (float *) dst, texelCount * 2);
+}
+
+static void StoreR8AsR16F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	UNorm8AsF16(decoded, (uint16_t *) dst, texelCount);
+}
+
+static void StoreR8G8AsR16G16F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	UNorm8AsF16(decoded, (uint16_t *) dst, texelCount * 2);
+}
+
+static void StoreR8SNormAsR16F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	SNorm8AsF16(decoded, (uint16_t *) dst, texelCount);
+}
+
+static void StoreR8G8SNormAsR16G16F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	SNorm8AsF16(decoded, (uint16_t *) dst, texelCount * 2);
+}
+
+static void StoreR16AsR16F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	UNorm16AsF16(decoded, (uint16_t *) dst, texelCount);
+}
+
+static void StoreR16G16AsR16G16F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	UNorm16AsF16(decoded, (uint16_t *) dst, texelCount * 2);
+}
+
+static void StoreR16SNormAsR16F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	SNorm16AsF16(decoded, (uint16_t *) dst, texelCount);
+}
+
+static void StoreR16G16SNormAsR16G16F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	SNorm16AsF16(decoded, (uint16_t *) dst, texelCount * 2);
+}
+
+void StoreRGBA16FAsRGBA32F(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	uint16_t const *in = (uint16_t const *) decoded;
+	float *out = (float *) dst;
+	for (uint32_t i = 0; i < texelCount * 4; ++i) {
+		out[i] = HalfToFloat(in[i]);
+	}
+}
+
+// dstFormats that are decodedFormat with its channels reordered, dropped or converted to float, sRGB to float is linear
+storeFunc ChooseStoreFunction(TinyImageFormat decodedFormat, TinyImageFormat dstFormat) {
+	switch (decodedFormat) {
+		case TinyImageFormat_B8G8R8A8_UNORM:
+			switch (dstFormat) {
+				case TinyImageFormat_R8G8B8A8_UNORM: return StoreBGRA8AsRGBA8;
+				case TinyImageFormat_B8G8R8X8_UNORM: return StoreBGRA8AsBGRX8;
+				case TinyImageFormat_R8G8B8_UNORM: return StoreBGRA8AsRGB8;
+				case TinyImageFormat_B8G8R8_UNORM: return StoreBGRA8AsBGR8;
+				case TinyImageFormat_R32G32B32A32_SFLOAT: return StoreBGRA8AsRGBA32F;
+				case TinyImageFormat_R16G16B16A16_SFLOAT: return StoreBGRA8AsRGBA16F;
+				default: return nullptr;
+			}
+		case TinyImageFormat_B8G8R8A8_SRGB:
+			switch (dstFormat) {
+				case TinyImageFormat_R8G8B8A8_SRGB: return StoreBGRA8AsRGBA8;
+				case TinyImageFormat_R8G8B8_SRGB: return StoreBGRA8AsRGB8;
+				case TinyImageFormat_B8G8R8_SRGB: return StoreBGRA8AsBGR8;
+				case TinyImageFormat_R32G32B32A32_SFLOAT: return StoreSRGBA8AsLinearRGBA32F;
+				case TinyImageFormat_R16G16B16A16_SFLOAT: return StoreSRGBA8AsLinearRGBA16F;
+				default: return nullptr;
+			}
+		case TinyImageFormat_R8_UNORM:
+			switch (dstFormat) {
+				case TinyImageFormat_R32_SFLOAT: return StoreR8AsR32F;
+				case TinyImageFormat_R16_SFLOAT: return StoreR8AsR16F;
+				default: return nullptr;
+			}
+		case TinyImageFormat_R8_SNORM:
+			switch (dstFormat) {
+				case TinyImageFormat_R32_SFLOAT: return StoreR8SNormAsR32F;
+				case TinyImageFormat_R16_SFLOAT: return StoreR8SNormAsR16F;
+				default: return nullptr;
+			}
+		case TinyImageFormat_R8G8_UNORM:
+			switch (dstFormat) {
+				case TinyImageFormat_R32G32_SFLOAT: return StoreR8G8AsR32G32F;
+				case TinyImageFormat_R16G16_SFLOAT: return StoreR8G8AsR16G16F;
+				default: return nullptr;
+			}
+		case TinyImageFormat_R8G8_SNORM:
+			switch (dstFormat) {
+				case TinyImageFormat_R32G32_SFLOAT: return StoreR8G8SNormAsR32G32F;
+				case TinyImageFormat_R16G16_SFLOAT: return StoreR8G8SNormAsR16G16F;
+				default: return nullptr;
+			}
+		case TinyImageFormat_R16_UNORM:
+			switch (dstFormat) {
+				case TinyImageFormat_R32_SFLOAT: return StoreR16AsR32F;
+				case TinyImageFormat_R16_SFLOAT: return StoreR16AsR16F;
+				default: return nullptr;
+			}
+		case TinyImageFormat_R16_SNORM:
+			switch (dstFormat) {
+				case TinyImageFormat_R32_SFLOAT: return StoreR16SNormAsR32F;
+				case TinyImageFormat_R16_SFLOAT: return StoreR16SNormAsR16F;
+				default: return nullptr;
+			}
+		case TinyImageFormat_R16G16_UNORM:
+			switch (dstFormat) {
+				case TinyImageFormat_R32G32_SFLOAT: return StoreR16G16AsR32G32F;
+				case TinyImageFormat_R16G16_SFLOAT: return StoreR16G16AsR16G16F;
+				default: return nullptr;
+			}
+		case TinyImageFormat_R16G16_SNORM:
+			switch (dstFormat) {
+				case TinyImageFormat_R32G32_SFLOAT: return StoreR16G16SNormAsR32G32F;
+				case TinyImageFormat_R16G16_SFLOAT: return StoreR16G16SNormAsR16G16F;
+				default: return nullptr;
+			}
+		case TinyImageFormat_R16G16B16A16_SFLOAT:
+			switch (dstFormat) {
+				case TinyImageFormat_R32G32B32A32_SFLOAT: return StoreRGBA16FAsRGBA32F;
+				default: return nullptr;
+			}
+		default: return nullptr;
+	}
+}
+
+// float and half outputs premultiply after converting, so the colour isn't rounded to 8 bits first
+storeFunc ChoosePremultipliedStoreFunction(TinyImageFormat decodedFormat, TinyImageFormat dstFormat) {
+	switch (decodedFormat) {
+		case TinyImageFormat_B8G8R8A8_UNORM:
+			switch (dstFormat) {
+				case TinyImageFormat_R32G32B32A32_SFLOAT: return StoreBGRA8AsPremultipliedRGBA32F;
+				case TinyImageFormat_R16G16B16A16_SFLOAT: return StoreBGRA8AsPremultipliedRGBA16F;
+				default: return nullptr;
+			}
+		case TinyImageFormat_B8G8R8A8_SRGB:
+			switch (dstFormat) {
+				case TinyImageFormat_R32G32B32A32_SFLOAT: return StoreSRGBA8AsPremultipliedLinearRGBA32F;
+				case TinyImageFormat_R16G16B16A16_SFLOAT: return StoreSRGBA8AsPremultipliedLinearRGBA16F;
+				default: return nullptr;
+			}
+		default: return nullptr;
+	}
+}
+
+// colour * alpha / 255 rounded to nearest, alpha multiplies by 255 so it's unchanged
+void PremultiplyBGRA8(uint8_t *decoded, uint32_t texelCount) {
+	uint32_t i = 0;
+#if STORE_SSE2
+	__m128i const zero = _mm_setzero_si128();
+	__m128i const alphaLanes = _mm_set_epi16(-1, 0, 0, 0, -1, 0, 0, 0);
+	__m128i const alphaScale = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+	__m128i const half = _mm_set1_epi16(128);
+	for (; i + 4 <= texelCount; i += 4) {
+		__m128i const texels = _mm_loadu_si128((__m128i const *) (decoded + i * 4));
+		__m128i halves[2] = { _mm_unpacklo_epi8(texels, zero), _mm_unpackhi_epi8(texels, zero) };
+		for (uint32_t j = 0; j < 2; ++j) {
+			__m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(halves[j], _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+			alpha = _mm_or_si128(_mm_andnot_si128(alphaLanes, alpha), alphaScale);
+			__m128i const t = _mm_add_epi16(_mm_mullo_epi16(halves[j], alpha), half);
+			halves[j] = _mm_srli_epi16(_mm_add_epi16(t, _mm_srli_epi16(t, 8)), 8);
+		}
+		_mm_storeu_si128((__m128i *) (decoded + i * 4), _mm_packus_epi16(halves[0], halves[1]));
+	}
+#endif
+	for (; i < texelCount; ++i) {
+		uint32_t const alpha = decoded[i * 4 + 3];
+		for (uint32_t c = 0; c < 3; ++c) {
+			uint32_t const t = decoded[i * 4 + c] * alpha + 128;
+			decoded[i * 4 + c] = (uint8_t) ((t + (t >> 8)) >> 8);
+		}
+	}
+}
+
+// sRGB colour is premultiplied in linear space and encoded back to the nearest sRGB value
+void PremultiplySRGBA8(uint8_t *decoded, uint32_t texelCount) {
+	SRGBLinearTable const *table = SRGBLinear();
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		uint32_t const alpha = decoded[i * 4 + 3];
+		if (alpha == 255) {
+			continue;
+		}
+		float const scale = (float) alpha / 255.0f;
+		for (uint32_t c = 0; c < 3; ++c) {
+			decoded[i * 4 + c] = LinearToSRGB8(table, table->f[decoded[i * 4 + c]] * scale);
+		}
+	}
+}
+
+void PremultiplyRGBA16F(uint8_t *decoded, uint32_t texelCount) {
+	uint16_t *texels = (uint16_t *) decoded;
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		float const alpha = HalfToFloat(texels[i * 4 + 3]);
+		for (uint32_t c = 0; c < 3; ++c) {
+			texels[i * 4 + c] = FloatToHalf(HalfToFloat(texels[i * 4 + c]) * alpha);
+		}
+	}
+}
+
+// the in place premultiply for a decoded format, nullptr if it has no alpha
+premultiplyFunc ChoosePremultiplyFunction(TinyImageFormat decodedFormat) {
+	switch (decodedFormat) {
+		case TinyImageFormat_B8G8R8A8_UNORM: return PremultiplyBGRA8;
+		case TinyImageFormat_B8G8R8A8_SRGB: return PremultiplySRGBA8;
+		case TinyImageFormat_R16G16B16A16_SFLOAT: return PremultiplyRGBA16F;
+		default: return nullptr;
+	}
+}
+
+// normal maps store X and Y, Z is rebuilt as the texels are stored
+enum NormalSource {
+	NormalSourceRG8,
+	NormalSourceRG8SNorm,
+	NormalSourceRG16,
+	NormalSourceRG16SNorm,
+	NormalSourceDXT5nm, // BGRA8 with X in alpha and Y in green
+};
+
+enum NormalDest {
+	NormalDestRGB8,
+	NormalDestRGBA8,
+	NormalDestRGB16,
+	NormalDestRGB32F,
+};
+
+template<NormalSource Source>
+static AL2O3_FORCE_INLINE void ReadNormalXY(uint8_t const *decoded, uint32_t i, float *x, float *y) {
+	uint16_t const *decoded16 = (uint16_t const *) decoded;
+	switch (Source) {
+		case NormalSourceRG8: *x = (float) decoded[i * 2 + 0] * (2.0f / 255.0f) - 1.0f;
+			*y = (float) decoded[i * 2 + 1] * (2.0f / 255.0f) - 1.0f;
+			break;
+		case NormalSourceRG8SNorm: *x = SNorm8ToFloat(decoded[i * 2 + 0]);
+			*y = SNorm8ToFloat(decoded[i * 2 + 1]);
+			break;
+		case NormalSourceRG16: *x = (float) decoded16[i * 2 + 0] * (2.0f / 65535.0f) - 1.0f;
+			*y = (float) decoded16[i * 2 + 1] * (2.0f / 65535.0f) - 1.0f;
+			break;
+		case NormalSourceRG16SNorm: *x = SNorm16ToFloat(decoded16[i * 2 + 0]);
+			*y = SNorm16ToFloat(decoded16[i * 2 + 1]);
+			break;
+		case NormalSourceDXT5nm: *x = (float) decoded[i * 4 + 3] * (2.0f / 255.0f) - 1.0f;
+			*y = (float) decoded[i * 4 + 1] * (2.0f / 255.0f) - 1.0f;
+			break;
+	}
+}
+
+// -1 to 1 as n * 0.5 + 0.5 rounded to the nearest 8 or 16 bit UNORM
+static AL2O3_FORCE_INLINE uint8_t EncodeNormalUNorm8(float n) {
+	n = (n < -1.0f) ? -1.0f : ((n > 1.0f) ? 1.0f : n);
+	return (uint8_t) (n * 127.5f + 128.0f);
+}
+
+static AL2O3_FORCE_INLINE uint16_t EncodeNormalUNorm16(float n) {
+	n = (n < -1.0f) ? -1.0f : ((n > 1.0f) ? 1.0f : n);
+	return (uint16_t) (n * 32767.5f + 32768.0f);
+}
+
+template<NormalSource Source, NormalDest Dest>
+static void StoreNormal(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		float x, y;
+		ReadNormalXY<Source>(decoded, i, &x, &y);
+		float const zz = 1.0f - x * x - y * y;
+		float const z = (zz > 0.0f) ? sqrtf(zz) : 0.0f;
+		switch (Dest) {
+			case NormalDestRGB8: dst[i * 3 + 0] = EncodeNormalUNorm8(x);
+				dst[i * 3 + 1] = EncodeNormalUNorm8(y);
+				dst[i * 3 + 2] = EncodeNormalUNorm8(z);
+				break;
+			case NormalDestRGBA8: dst[i * 4 + 0] = EncodeNormalUNorm8(x);
+				dst[i * 4 + 1] = EncodeNormalUNorm8(y);
+				dst[i * 4 + 2] = EncodeNormalUNorm8(z);
+				dst[i * 4 + 3] = 0xFF;
+				break;
+			case NormalDestRGB16: {
+				uint16_t *out = (uint16_t *) dst;
+				out[i * 3 + 0] = EncodeNormalUNorm16(x);
+				out[i * 3 + 1] = EncodeNormalUNorm16(y);
+				out[i * 3 + 2] = EncodeNormalUNorm16(z);
+				break;
+			}
+			case NormalDestRGB32F: {
+				float *out = (float *) dst;
+				out[i * 3 + 0] = x;
+				out[i * 3 + 1] = y;
+				out[i * 3 + 2] = z;
+				break;
+			}
+		}
+	}
+}
+
+template<NormalSource Source>
+static storeFunc ChooseNormalStoreDest(TinyImageFormat dstFormat) {
+	switch (dstFormat) {
+		case TinyImageFormat_R8G8B8_UNORM: return StoreNormal<Source, NormalDestRGB8>;
+		case TinyImageFormat_R8G8B8A8_UNORM: return StoreNormal<Source, NormalDestRGBA8>;
+		case TinyImageFormat_R16G16B16_UNORM: return StoreNormal<Source, NormalDestRGB16>;
+		case TinyImageFormat_R32G32B32_SFLOAT: return StoreNormal<Source, NormalDestRGB32F>;
+		default: return nullptr;
+	}
+}
+
+// decodedFormat B8G8R8A8_UNORM is taken as DXT5nm
+storeFunc ChooseNormalStoreFunction(TinyImageFormat decodedFormat, TinyImageFormat dstFormat) {
+	switch (decodedFormat) {
+		case TinyImageFormat_R8G8_UNORM: return ChooseNormalStoreDest<NormalSourceRG8>(dstFormat);
+		case TinyImageFormat_R8G8_SNORM: return ChooseNormalStoreDest<NormalSourceRG8SNorm>(dstFormat);
+		case TinyImageFormat_R16G16_UNORM: return ChooseNormalStoreDest<NormalSourceRG16>(dstFormat);
+		case TinyImageFormat_R16G16_SNORM: return ChooseNormalStoreDest<NormalSourceRG16SNorm>(dstFormat);
+		case TinyImageFormat_B8G8R8A8_UNORM: return ChooseNormalStoreDest<NormalSourceDXT5nm>(dstFormat);
+		default: return nullptr;
+	}
+}
+
+// a single channel of 8 bit texels to R8
+template<uint32_t Offset>
+static void StoreChannelOfBGRA8(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount) {
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		dst[i] = decoded[i * 4 + Offset];
+	}
+}
+
+// channel is a TinyImageFormat_LogicalChannel, nullptr when decodedFormat isn't 8 bit BGRA
+storeFunc ChooseChannelStoreFunction(TinyImageFormat decodedFormat, uint32_t channel) {
+	if (decodedFormat != TinyImageFormat_B8G8R8A8_UNORM && decodedFormat != TinyImageFormat_B8G8R8A8_SRGB) {
+		return nullptr;
+	}
+	switch (channel) {
+		case TinyImageFormat_LC_Red: return StoreChannelOfBGRA8<2>;
+		case TinyImageFormat_LC_Green: return StoreChannelOfBGRA8<1>;
+		case TinyImageFormat_LC_Blue: return StoreChannelOfBGRA8<0>;
+		case TinyImageFormat_LC_Alpha: return StoreChannelOfBGRA8<3>;
+		default: return nullptr;
+	}
+}
@@ -20,8 +20,12 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 
 extern "C" const uint8_t detex_clamp0to255_table[767];
 extern bool detexDecompressBlockETC2(const uint8_t * AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer);
+extern bool detexDecompressBlockETC2(const uint8_t *bitstring, float *texels, float const *colour, float const *alpha);
+extern bool detexDecompressBlockETC2(const uint8_t *bitstring, uint16_t *texels, uint16_t const *colour, uint16_t const *alpha);
+// in decompressstore.cpp
+extern uint16_t FloatToHalf(float f);
 
-#define DETEX_PIXEL32_ALPHA_BYTE_OFFSET 4
+#define DETEX_PIXEL32_ALPHA_BYTE_OFFSET 3
 
 /* Clamp an integer value in the range -255 to 511 to the the range 0 to 255. */
 static AL2O3_FORCE_INLINE uint8_t detexClamp0To255(int x) {
@@ -53,12 +57,28 @@ static AL2O3_FORCE_INLINE int modifier_times_multiplier(int modifier, int multip
 
 static AL2O3_FORCE_INLINE void ProcessPixelEAC(uint8_t i, uint64_t pixels,
 																							const int8_t * AL2O3_RESTRICT modifier_table, int base_codeword, int multiplier,
-																							uint8_t * AL2O3_RESTRICT pixel_buffer) {
+																							uint8_t * AL2O3_RESTRICT pixel_buffer, uint32_t pixel_pitch) {
 	int modifier = modifier_table[(pixels >> (45 - i * 3)) & 7];
-	pixel_buffer[((i & 3) * 4 + ((i & 12) >> 2)) * 4 + DETEX_PIXEL32_ALPHA_BYTE_OFFSET] =
+	pixel_buffer[((i & 3) * 4 + ((i & 12) >> 2)) * pixel_pitch] =
 			detexClamp0To255(base_codeword + modifier_times_multiplier(modifier, multiplier));
 }
 
+/* Decode the 64-bit EAC alpha half of an ETC2_EAC block, texels pixel_pitch bytes */
+/* apart. */
+static void DecodeBlockEACAlpha(const uint8_t * AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer,
+																uint32_t pixel_pitch) {
+	int base_codeword = bitstring[0];
+	const int8_t *modifier_table = eac_modifier_table[(bitstring[1] & 0x0F)];
+	int multiplier = (bitstring[1] & 0xF0) >> 4;
+
+	uint64_t pixels = ((uint64_t)bitstring[2] << 40) | ((uint64_t)bitstring[3] << 32) |
+			((uint64_t)bitstring[4] << 24)
+			| ((uint64_t)bitstring[5] << 16) | ((uint64_t)bitstring[6] << 8) | bitstring[7];
+	for (uint8_t i = 0; i < 16; i++) {
+		ProcessPixelEAC(i, pixels, modifier_table, base_codeword, multiplier, pixel_buffer, pixel_pitch);
+	}
+}
+
 /* Decompress a 128-bit 4x4 pixel texture block compressed using the ETC2_EAC */
 /* format. */
 bool detexDecompressBlockETC2_EAC(const uint8_t * AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer) {
@@ -66,32 +86,54 @@ bool detexDecompressBlockETC2_EAC(const uint8_t * AL2O3_RESTRICT bitstring, uint
 	if (!r)
 		return false;
 	// Decode the alpha part.
+	DecodeBlockEACAlpha(bitstring, pixel_buffer + DETEX_PIXEL32_ALPHA_BYTE_OFFSET, 4);
+	return true;
+}
+
+// As DecodeBlockEACAlpha to float or half texels, the 8 alpha values are converted by table once
+template<typename T>
+static void DecodeBlockEACAlpha(const uint8_t * AL2O3_RESTRICT bitstring, T * AL2O3_RESTRICT texels,
+																uint32_t texel_pitch, T const *table) {
 	int base_codeword = bitstring[0];
 	const int8_t *modifier_table = eac_modifier_table[(bitstring[1] & 0x0F)];
 	int multiplier = (bitstring[1] & 0xF0) >> 4;
+	T values[8];
+	for (int i = 0; i < 8; i++) {
+		values[i] = table[detexClamp0To255(base_codeword + modifier_times_multiplier(modifier_table[i], multiplier))];
+	}
 
 	uint64_t pixels = ((uint64_t)bitstring[2] << 40) | ((uint64_t)bitstring[3] << 32) |
 			((uint64_t)bitstring[4] << 24)
 			| ((uint64_t)bitstring[5] << 16) | ((uint64_t)bitstring[6] << 8) | bitstring[7];
-	ProcessPixelEAC(0, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(1, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(2, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(3, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(4, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(5, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(6, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(7, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(8, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(9, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(10, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(11, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(12, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(13, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(14, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
-	ProcessPixelEAC(15, pixels, modifier_table, base_codeword, multiplier, pixel_buffer);
+	for (uint8_t i = 0; i < 16; i++) {
+		texels[((i & 3) * 4 + ((i & 12) >> 2)) * texel_pitch] = values[(pixels >> (45 - i * 3)) & 7];
+	}
+}
+
+template<typename T>
+static bool DecompressBlockETC2_EACConverted(const uint8_t * AL2O3_RESTRICT bitstring, T * AL2O3_RESTRICT texels,
+																						 T const *colour, T const *alpha) {
+	bool r = detexDecompressBlockETC2(&bitstring[8], texels, colour, alpha);
+	if (!r)
+		return false;
+	DecodeBlockEACAlpha(bitstring, texels + 3, 4, alpha);
 	return true;
 }
 
+bool detexDecompressBlockETC2_EAC(const uint8_t *bitstring, float *texels, float const *colour, float const *alpha) {
+	return DecompressBlockETC2_EACConverted(bitstring, texels, colour, alpha);
+}
+
+bool detexDecompressBlockETC2_EAC(const uint8_t *bitstring, uint16_t *texels, uint16_t const *colour, uint16_t const *alpha) {
+	return DecompressBlockETC2_EACConverted(bitstring, texels, colour, alpha);
+}
+
+/* Decompress only the alpha of an ETC2_EAC block to 16 bytes, the colour half */
+/* is not read. */
+void detexDecompressBlockETC2_EAC_ALPHA(const uint8_t * AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer) {
+	DecodeBlockEACAlpha(bitstring, pixel_buffer, 1);
+}
+
 static AL2O3_FORCE_INLINE int Clamp0To2047(int x) {
 	if (x < 0)
 		return 0;
@@ -124,6 +166,55 @@ static AL2O3_FORCE_INLINE void DecodeBlockEAC11Bit(uint64_t qword, int shift, in
 	}
 }
 
+// As DecodeBlockEAC11Bit but each value is rounded to 8 bits and stored in byte channel of
+// every channels bytes, for R8 (channels 1) and R8G8 (channels 2) output.
+static AL2O3_FORCE_INLINE void DecodeBlockEAC11BitTo8Bit(uint64_t qword, int channels, int channel,
+																												uint8_t * AL2O3_RESTRICT pixel_buffer) {
+	int base_codeword_times_8_plus_4 = ((qword & 0xFF00000000000000) >> (56 - 3)) | 0x4;
+	int modifier_index = (qword & 0x000F000000000000) >> 48;
+	const int8_t *modifier_table = eac_modifier_table[modifier_index];
+	int multiplier_times_8 = (qword & 0x00F0000000000000) >> (52 - 3);
+	if (multiplier_times_8 == 0)
+		multiplier_times_8 = 1;
+	for (int i = 0; i < 16; i++) {
+		int pixel_index = (qword & (0x0000E00000000000 >> (i * 3))) >> (45 - i * 3);
+		int modifier = modifier_table[pixel_index];
+		uint32_t value = Clamp0To2047(base_codeword_times_8_plus_4 +
+				modifier * multiplier_times_8);
+		pixel_buffer[((i & 3) * 4 + ((i & 12) >> 2)) * channels + channel] = (uint8_t) ((value * 255 + 1023) / 2047);
+	}
+}
+
+static AL2O3_FORCE_INLINE void ConvertTexel(float f, float *out) {
+	*out = f;
+}
+
+static AL2O3_FORCE_INLINE void ConvertTexel(float f, uint16_t *out) {
+	*out = FloatToHalf(f);
+}
+
+// As DecodeBlockEAC11Bit to float or half UNORM, channel of every channels values. A block has only 8
+// values so each is converted once
+template<typename T>
+static AL2O3_FORCE_INLINE void DecodeBlockEAC11BitConverted(uint64_t qword, int channels, int channel,
+																														T * AL2O3_RESTRICT texels) {
+	int base_codeword_times_8_plus_4 = ((qword & 0xFF00000000000000) >> (56 - 3)) | 0x4;
+	int modifier_index = (qword & 0x000F000000000000) >> 48;
+	const int8_t *modifier_table = eac_modifier_table[modifier_index];
+	int multiplier_times_8 = (qword & 0x00F0000000000000) >> (52 - 3);
+	if (multiplier_times_8 == 0)
+		multiplier_times_8 = 1;
+	T values[8];
+	for (int i = 0; i < 8; i++) {
+		uint32_t value = Clamp0To2047(base_codeword_times_8_plus_4 + modifier_table[i] * multiplier_times_8);
+		ConvertTexel((float) ((value << 5) | (value >> 6)) / 65535.0f, &values[i]);
+	}
+	for (int i = 0; i < 16; i++) {
+		int pixel_index = (qword & (0x0000E00000000000 >> (i * 3))) >> (45 - i * 3);
+		texels[((i & 3) * 4 + ((i & 12) >> 2)) * channels + channel] = values[pixel_index];
+	}
+}
+
 /* Decompress a 64-bit 4x4 pixel texture block compressed using the */
 /* EAC_R11 format. */
 bool detexDecompressBlockEAC_R11(const uint8_t * AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer) {
@@ -151,6 +242,66 @@ bool detexDecompressBlockEAC_RG11(const uint8_t * AL2O3_RESTRICT bitstring, uint
 	return true;
 }
 
+/* Decompress EAC_R11 and EAC_RG11 blocks to 8-bit R8 and R8G8 texels. */
+void detexDecompressBlockEAC_R11_8(const uint8_t * AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer) {
+	uint64_t qword = ((uint64_t)bitstring[0] << 56) | ((uint64_t)bitstring[1] << 48) |
+			((uint64_t)bitstring[2] << 40) |
+			((uint64_t)bitstring[3] << 32) | ((uint64_t)bitstring[4] << 24) |
+			((uint64_t)bitstring[5] << 16) | ((uint64_t)bitstring[6] << 8) | bitstring[7];
+	DecodeBlockEAC11BitTo8Bit(qword, 1, 0, pixel_buffer);
+}
+
+void detexDecompressBlockEAC_RG11_8(const uint8_t * AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer) {
+	uint64_t red_qword = ((uint64_t)bitstring[0] << 56) | ((uint64_t)bitstring[1] << 48) |
+			((uint64_t)bitstring[2] << 40) |
+			((uint64_t)bitstring[3] << 32) | ((uint64_t)bitstring[4] << 24) |
+			((uint64_t)bitstring[5] << 16) | ((uint64_t)bitstring[6] << 8) | bitstring[7];
+	DecodeBlockEAC11BitTo8Bit(red_qword, 2, 0, pixel_buffer);
+	uint64_t green_qword = ((uint64_t)bitstring[8] << 56) | ((uint64_t)bitstring[9] << 48) |
+			((uint64_t)bitstring[10] << 40) |
+			((uint64_t)bitstring[11] << 32) | ((uint64_t)bitstring[12] << 24) |
+			((uint64_t)bitstring[13] << 16) | ((uint64_t)bitstring[14] << 8) | bitstring[15];
+	DecodeBlockEAC11BitTo8Bit(green_qword, 2, 1, pixel_buffer);
+}
+
+void detexDecompressBlockEAC_R11_F32(const uint8_t * AL2O3_RESTRICT bitstring, float * AL2O3_RESTRICT texels) {
+	uint64_t qword = ((uint64_t)bitstring[0] << 56) | ((uint64_t)bitstring[1] << 48) |
+			((uint64_t)bitstring[2] << 40) |
+			((uint64_t)bitstring[3] << 32) | ((uint64_t)bitstring[4] << 24) |
+			((uint64_t)bitstring[5] << 16) | ((uint64_t)bitstring[6] << 8) | bitstring[7];
+	DecodeBlockEAC11BitConverted(qword, 1, 0, texels);
+}
+
+void detexDecompressBlockEAC_R11_F16(const uint8_t * AL2O3_RESTRICT bitstring, uint16_t * AL2O3_RESTRICT texels) {
+	uint64_t qword = ((uint64_t)bitstring[0] << 56) | ((uint64_t)bitstring[1] << 48) |
+			((uint64_t)bitstring[2] << 40) |
+			((uint64_t)bitstring[3] << 32) | ((uint64_t)bitstring[4] << 24) |
+			((uint64_t)bitstring[5] << 16) | ((uint64_t)bitstring[6] << 8) | bitstring[7];
+	DecodeBlockEAC11BitConverted(qword, 1, 0, texels);
+}
+
+template<typename T>
+static void DecompressBlockEAC_RG11Converted(const uint8_t * AL2O3_RESTRICT bitstring, T * AL2O3_RESTRICT texels) {
+	uint64_t red_qword = ((uint64_t)bitstring[0] << 56) | ((uint64_t)bitstring[1] << 48) |
+			((uint64_t)bitstring[2] << 40) |
+			((uint64_t)bitstring[3] << 32) | ((uint64_t)bitstring[4] << 24) |
+			((uint64_t)bitstring[5] << 16) | ((uint64_t)bitstring[6] << 8) | bitstring[7];
+	DecodeBlockEAC11BitConverted(red_qword, 2, 0, texels);
+	uint64_t green_qword = ((uint64_t)bitstring[8] << 56) | ((uint64_t)bitstring[9] << 48) |
+			((uint64_t)bitstring[10] << 40) |
+			((uint64_t)bitstring[11] << 32) | ((uint64_t)bitstring[12] << 24) |
+			((uint64_t)bitstring[13] << 16) | ((uint64_t)bitstring[14] << 8) | bitstring[15];
+	DecodeBlockEAC11BitConverted(green_qword, 2, 1, texels);
+}
+
+void detexDecompressBlockEAC_RG11_F32(const uint8_t * AL2O3_RESTRICT bitstring, float * AL2O3_RESTRICT texels) {
+	DecompressBlockEAC_RG11Converted(bitstring, texels);
+}
+
+void detexDecompressBlockEAC_RG11_F16(const uint8_t * AL2O3_RESTRICT bitstring, uint16_t * AL2O3_RESTRICT texels) {
+	DecompressBlockEAC_RG11Converted(bitstring, texels);
+}
+
 static AL2O3_FORCE_INLINE int ClampMinus1023To1023(int x) {
 	if (x < - 1023)
 		return - 1023;
@@ -176,8 +327,8 @@ static AL2O3_FORCE_INLINE bool DecodeBlockEACSigned11Bit(uint64_t qword, int shi
 																												uint8_t *pixel_buffer) {
 	int base_codeword = (int8_t)((qword & 0xFF00000000000000) >> 56);	// Signed 8 bits.
 	if (base_codeword == - 128)
-		// Not allowed in encoding. Decoder should handle it but we don't do that yet.
-		return false;
+		// Not allowed in encoding, decoded as -127 (as BC4/BC5 SNORM endpoints are).
+		base_codeword = - 127;
 	int base_codeword_times_8 = base_codeword << 3;				// Arithmetic shift.
 	int modifier_index = (qword & 0x000F000000000000) >> 48;
 	const int8_t *modifier_table = eac_modifier_table[modifier_index];
@@ -196,6 +347,56 @@ static AL2O3_FORCE_INLINE bool DecodeBlockEACSigned11Bit(uint64_t qword, int shi
 	return true;
 }
 
+// As DecodeBlockEACSigned11Bit but each value is rounded to an 8 bit SNORM and stored in byte
+// channel of every channels bytes.
+static AL2O3_FORCE_INLINE void DecodeBlockEACSigned11BitTo8Bit(uint64_t qword, int channels, int channel,
+																															uint8_t *pixel_buffer) {
+	int base_codeword = (int8_t)((qword & 0xFF00000000000000) >> 56);	// Signed 8 bits.
+	if (base_codeword == - 128)
+		base_codeword = - 127;
+	int base_codeword_times_8 = base_codeword << 3;				// Arithmetic shift.
+	int modifier_index = (qword & 0x000F000000000000) >> 48;
+	const int8_t *modifier_table = eac_modifier_table[modifier_index];
+	int multiplier_times_8 = (qword & 0x00F0000000000000) >> (52 - 3);
+	if (multiplier_times_8 == 0)
+		multiplier_times_8 = 1;
+	for (int i = 0; i < 16; i++) {
+		int pixel_index = (qword & (0x0000E00000000000 >> (i * 3))) >> (45 - i * 3);
+		int modifier = modifier_table[pixel_index];
+		int value = ClampMinus1023To1023(base_codeword_times_8 +
+				modifier * multiplier_times_8) * 127;
+		// round half away from zero
+		value = (value >= 0 ? value + 511 : value - 511) / 1023;
+		pixel_buffer[((i & 3) * 4 + ((i & 12) >> 2)) * channels + channel] = (uint8_t) (int8_t) value;
+	}
+}
+
+// As DecodeBlockEACSigned11Bit to float or half SNORM, channel of every channels values, each of the 8
+// values converted once.
+template<typename T>
+static AL2O3_FORCE_INLINE void DecodeBlockEACSigned11BitConverted(uint64_t qword, int channels, int channel,
+																																	T *texels) {
+	int base_codeword = (int8_t)((qword & 0xFF00000000000000) >> 56);	// Signed 8 bits.
+	if (base_codeword == - 128)
+		base_codeword = - 127;
+	int base_codeword_times_8 = base_codeword << 3;				// Arithmetic shift.
+	int modifier_index = (qword & 0x000F000000000000) >> 48;
+	const int8_t *modifier_table = eac_modifier_table[modifier_index];
+	int multiplier_times_8 = (qword & 0x00F0000000000000) >> (52 - 3);
+	if (multiplier_times_8 == 0)
+		multiplier_times_8 = 1;
+	T values[8];
+	for (int i = 0; i < 8; i++) {
+		int value = ClampMinus1023To1023(base_codeword_times_8 + modifier_table[i] * multiplier_times_8);
+		float const f = (float) (int16_t) ReplicateSigned11BitsTo16Bits(value) / 32767.0f;
+		ConvertTexel(f < -1.0f ? -1.0f : f, &values[i]);
+	}
+	for (int i = 0; i < 16; i++) {
+		int pixel_index = (qword & (0x0000E00000000000 >> (i * 3))) >> (45 - i * 3);
+		texels[((i & 3) * 4 + ((i & 12) >> 2)) * channels + channel] = values[pixel_index];
+	}
+}
+
 /* Decompress a 64-bit 4x4 pixel texture block compressed using the */
 /* EAC_SIGNED_R11 format. */
 bool detexDecompressBlockEAC_SIGNED_R11(const uint8_t *AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer) {
@@ -223,6 +424,67 @@ bool detexDecompressBlockEAC_SIGNED_RG11(const uint8_t *AL2O3_RESTRICT bitstring
 	return DecodeBlockEACSigned11Bit(green_qword, 1, 1, pixel_buffer);
 }
 
+/* Decompress EAC_SIGNED_R11 and EAC_SIGNED_RG11 blocks to 8-bit R8 and R8G8 SNORM */
+/* texels. */
+void detexDecompressBlockEAC_SIGNED_R11_8(const uint8_t *AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer) {
+	uint64_t qword = ((uint64_t)bitstring[0] << 56) | ((uint64_t)bitstring[1] << 48) |
+			((uint64_t)bitstring[2] << 40) |
+			((uint64_t)bitstring[3] << 32) | ((uint64_t)bitstring[4] << 24) |
+			((uint64_t)bitstring[5] << 16) | ((uint64_t)bitstring[6] << 8) | bitstring[7];
+	DecodeBlockEACSigned11BitTo8Bit(qword, 1, 0, pixel_buffer);
+}
+
+void detexDecompressBlockEAC_SIGNED_RG11_8(const uint8_t *AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer) {
+	uint64_t red_qword = ((uint64_t)bitstring[0] << 56) | ((uint64_t)bitstring[1] << 48) |
+			((uint64_t)bitstring[2] << 40) |
+			((uint64_t)bitstring[3] << 32) | ((uint64_t)bitstring[4] << 24) |
+			((uint64_t)bitstring[5] << 16) | ((uint64_t)bitstring[6] << 8) | bitstring[7];
+	DecodeBlockEACSigned11BitTo8Bit(red_qword, 2, 0, pixel_buffer);
+	uint64_t green_qword = ((uint64_t)bitstring[8] << 56) | ((uint64_t)bitstring[9] << 48) |
+			((uint64_t)bitstring[10] << 40) |
+			((uint64_t)bitstring[11] << 32) | ((uint64_t)bitstring[12] << 24) |
+			((uint64_t)bitstring[13] << 16) | ((uint64_t)bitstring[14] << 8) | bitstring[15];
+	DecodeBlockEACSigned11BitTo8Bit(green_qword, 2, 1, pixel_buffer);
+}
+
+void detexDecompressBlockEAC_SIGNED_R11_F32(const uint8_t *AL2O3_RESTRICT bitstring, float * AL2O3_RESTRICT texels) {
+	uint64_t qword = ((uint64_t)bitstring[0] << 56) | ((uint64_t)bitstring[1] << 48) |
+			((uint64_t)bitstring[2] << 40) |
+			((uint64_t)bitstring[3] << 32) | ((uint64_t)bitstring[4] << 24) |
+			((uint64_t)bitstring[5] << 16) | ((uint64_t)bitstring[6] << 8) | bitstring[7];
+	DecodeBlockEACSigned11BitConverted(qword, 1, 0, texels);
+}
+
+void detexDecompressBlockEAC_SIGNED_R11_F16(const uint8_t *AL2O3_RESTRICT bitstring, uint16_t * AL2O3_RESTRICT texels) {
+	uint64_t qword = ((uint64_t)bitstring[0] << 56) | ((uint64_t)bitstring[1] << 48) |
+			((uint64_t)bitstring[2] << 40) |
+			((uint64_t)bitstring[3] << 32) | ((uint64_t)bitstring[4] << 24) |
+			((uint64_t)bitstring[5] << 16) | ((uint64_t)bitstring[6] << 8) | bitstring[7];
+	DecodeBlockEACSigned11BitConverted(qword, 1, 0, texels);
+}
+
+template<typename T>
+static void DecompressBlockEAC_SIGNED_RG11Converted(const uint8_t *AL2O3_RESTRICT bitstring, T * AL2O3_RESTRICT texels) {
+	uint64_t red_qword = ((uint64_t)bitstring[0] << 56) | ((uint64_t)bitstring[1] << 48) |
+			((uint64_t)bitstring[2] << 40) |
+			((uint64_t)bitstring[3] << 32) | ((uint64_t)bitstring[4] << 24) |
+			((uint64_t)bitstring[5] << 16) | ((uint64_t)bitstring[6] << 8) | bitstring[7];
+	DecodeBlockEACSigned11BitConverted(red_qword, 2, 0, texels);
+	uint64_t green_qword = ((uint64_t)bitstring[8] << 56) | ((uint64_t)bitstring[9] << 48) |
+			((uint64_t)bitstring[10] << 40) |
+			((uint64_t)bitstring[11] << 32) | ((uint64_t)bitstring[12] << 24) |
+			((uint64_t)bitstring[13] << 16) | ((uint64_t)bitstring[14] << 8) | bitstring[15];
+	DecodeBlockEACSigned11BitConverted(green_qword, 2, 1, texels);
+}
+
+void detexDecompressBlockEAC_SIGNED_RG11_F32(const uint8_t *AL2O3_RESTRICT bitstring, float * AL2O3_RESTRICT texels) {
+	DecompressBlockEAC_SIGNED_RG11Converted(bitstring, texels);
+}
+
+void detexDecompressBlockEAC_SIGNED_RG11_F16(const uint8_t *AL2O3_RESTRICT bitstring, uint16_t * AL2O3_RESTRICT texels) {
+	DecompressBlockEAC_SIGNED_RG11Converted(bitstring, texels);
+}
+
 AL2O3_EXTERN_C void Image_DecompressEACSigned11Block(void const *AL2O3_RESTRICT input, uint8_t output[4 * 4 * sizeof(int16_t)]) {
 	detexDecompressBlockEAC_SIGNED_R11((uint8_t const*)input,output);
 }
@@ -21,6 +21,9 @@ OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 #include "al2o3_platform/platform.h"
 
 extern "C" const uint8_t detex_clamp0to255_table[767];
+extern bool detexDecompressBlockETC1(const uint8_t * AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer);
+extern bool detexDecompressBlockETC1(const uint8_t *bitstring, float *texels, float const *colour, float const *alpha);
+extern bool detexDecompressBlockETC1(const uint8_t *bitstring, uint16_t *texels, uint16_t const *colour, uint16_t const *alpha);
 
 /* Clamp an integer value in the range -255 to 511 to the the range 0 to 255. */
 static AL2O3_FORCE_INLINE uint8_t detexClamp0To255(int x) {
@@ -51,21 +54,42 @@ static AL2O3_FORCE_INLINE uint32_t detexPack32RGB8Alpha0xFF(int r, int g, int b)
 	return detexPack32RGBA8(r, g, b, 0xFF);
 }
 
-static const int complement3bitshifted_table[8] = {
-		0, 8, 16, 24, -32, -24, -16, -8
+// where the modes write their texels, each is a packed BGRA8 like the uint8_t kernels output. The converted
+// writer is float or half RGBA, each 8 bit channel converted by table
+struct PackedTexels {
+	uint32_t *texels;
+
+	AL2O3_FORCE_INLINE void Store(int i, uint32_t bgra) const {
+		texels[i] = bgra;
+	}
 };
 
-static const int modifier_table[8][4] = {
-		{ 2, 8, -2, -8 },
-		{ 5, 17, -5, -17 },
-		{ 9, 29, -9, -29 },
-		{ 13, 42, -13, -42 },
-		{ 18, 60, -18, -60 },
-		{ 24, 80, -24, -80 },
-		{ 33, 106, -33, -106 },
-		{ 47, 183, -47, -183 }
+template<typename T>
+struct ConvertedTexels {
+	T *texels;
+	T const *colour;
+	T const *alpha;
+
+	AL2O3_FORCE_INLINE void Store(int i, uint32_t bgra) const {
+		texels[i * 4 + 0] = colour[(bgra >> 16) & 0xFF];
+		texels[i * 4 + 1] = colour[(bgra >> 8) & 0xFF];
+		texels[i * 4 + 2] = colour[bgra & 0xFF];
+		texels[i * 4 + 3] = alpha[bgra >> 24];
+	}
 };
 
+static AL2O3_FORCE_INLINE bool DecompressBlockETC1(const uint8_t * AL2O3_RESTRICT bitstring, PackedTexels texels) {
+	return detexDecompressBlockETC1(bitstring, (uint8_t *) texels.texels);
+}
+
+template<typename T>
+static AL2O3_FORCE_INLINE bool DecompressBlockETC1(const uint8_t * AL2O3_RESTRICT bitstring, ConvertedTexels<T> texels) {
+	return detexDecompressBlockETC1(bitstring, texels.texels, texels.colour, texels.alpha);
+}
+
+static const int complement3bitshifted_table[8] = {
+		0, 8, 16, 24, -32, -24, -16, -8
+};
 
 // This function calculates the 3-bit complement value in the range -4 to 3 of a three bit
 // representation. The result is arithmetically shifted 3 places to the left before returning.
@@ -74,114 +98,10 @@ static AL2O3_FORCE_INLINE int complement3bitshifted(int x) {
 }
 
 
-// Define inline function to speed up ETC1 decoding.
-
-static AL2O3_FORCE_INLINE void ProcessPixelETC1(uint8_t i, uint32_t pixel_index_word,
-																							 uint32_t table_codeword, int * AL2O3_RESTRICT base_color_subblock,
-																							 uint8_t * AL2O3_RESTRICT pixel_buffer) {
-	int pixel_index = ((pixel_index_word & (1 << i)) >> i)
-			| ((pixel_index_word & (0x10000 << i)) >> (16 + i - 1));
-	int r, g, b;
-	int modifier = modifier_table[table_codeword][pixel_index];
-	r = detexClamp0To255(base_color_subblock[0] + modifier);
-	g = detexClamp0To255(base_color_subblock[1] + modifier);
-	b = detexClamp0To255(base_color_subblock[2] + modifier);
-	uint32_t *buffer = (uint32_t *)pixel_buffer;
-	buffer[(i & 3) * 4 + ((i & 12) >> 2)] =
-			detexPack32RGB8Alpha0xFF(r, g, b);
-}
-
-/* Decompress a 64-bit 4x4 pixel texture block compressed using the ETC1 */
-/* format. */
-bool detexDecompressBlockETC1(const uint8_t * AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer) {
-	int differential_mode = bitstring[3] & 2;
-	int flipbit = bitstring[3] & 1;
-	int base_color_subblock1[3];
-	int base_color_subblock2[3];
-	if (differential_mode) {
-		base_color_subblock1[0] = (bitstring[0] & 0xF8);
-		base_color_subblock1[0] |= ((base_color_subblock1[0] & 224) >> 5);
-		base_color_subblock1[1] = (bitstring[1] & 0xF8);
-		base_color_subblock1[1] |= (base_color_subblock1[1] & 224) >> 5;
-		base_color_subblock1[2] = (bitstring[2] & 0xF8);
-		base_color_subblock1[2] |= (base_color_subblock1[2] & 224) >> 5;
-		base_color_subblock2[0] = (bitstring[0] & 0xF8);			// 5 highest order bits.
-		base_color_subblock2[0] += complement3bitshifted(bitstring[0] & 7);	// Add difference.
-		if (base_color_subblock2[0] & 0xFF07)					// Check for overflow.
-			return false;
-		base_color_subblock2[0] |= (base_color_subblock2[0] & 224) >> 5;	// Replicate.
-		base_color_subblock2[1] = (bitstring[1] & 0xF8);
-		base_color_subblock2[1] += complement3bitshifted(bitstring[1] & 7);
-		if (base_color_subblock2[1] & 0xFF07)
-			return false;
-		base_color_subblock2[1] |= (base_color_subblock2[1] & 224) >> 5;
-		base_color_subblock2[2] = (bitstring[2] & 0xF8);
-		base_color_subblock2[2] += complement3bitshifted(bitstring[2] & 7);
-		if (base_color_subblock2[2] & 0xFF07)
-			return false;
-		base_color_subblock2[2] |= (base_color_subblock2[2] & 224) >> 5;
-	}
-	else {
-		base_color_subblock1[0] = (bitstring[0] & 0xF0);
-		base_color_subblock1[0] |= base_color_subblock1[0] >> 4;
-		base_color_subblock1[1] = (bitstring[1] & 0xF0);
-		base_color_subblock1[1] |= base_color_subblock1[1] >> 4;
-		base_color_subblock1[2] = (bitstring[2] & 0xF0);
-		base_color_subblock1[2] |= base_color_subblock1[2] >> 4;
-		base_color_subblock2[0] = (bitstring[0] & 0x0F);
-		base_color_subblock2[0] |= base_color_subblock2[0] << 4;
-		base_color_subblock2[1] = (bitstring[1] & 0x0F);
-		base_color_subblock2[1] |= base_color_subblock2[1] << 4;
-		base_color_subblock2[2] = (bitstring[2] & 0x0F);
-		base_color_subblock2[2] |= base_color_subblock2[2] << 4;
-	}
-	uint32_t table_codeword1 = (bitstring[3] & 224) >> 5;
-	uint32_t table_codeword2 = (bitstring[3] & 28) >> 2;
-	uint32_t pixel_index_word = ((uint32_t)bitstring[4] << 24) | ((uint32_t)bitstring[5] << 16) |
-			((uint32_t)bitstring[6] << 8) | bitstring[7];
-	if (flipbit == 0) {
-		ProcessPixelETC1(0, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(1, pixel_index_word, table_codeword1,base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(2, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(3, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(4, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(5, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(6, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(7, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(8, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC1(9, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC1(10, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC1(11, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC1(12, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC1(13, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC1(14, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC1(15, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-	}
-	else {
-		ProcessPixelETC1(0, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(1, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(2, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC1(3, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC1(4, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(5, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(6, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC1(7, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC1(8, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(9, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(10, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC1(11, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC1(12, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(13, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC1(14, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC1(15, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-	}
-	return true;
-}
-
 static const int etc2_distance_table[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
 
-static void ProcessBlockETC2TMode(const uint8_t * AL2O3_RESTRICT bitstring,
-																		 uint8_t * AL2O3_RESTRICT pixel_buffer) {
+template<typename Texels>
+static void ProcessBlockETC2TMode(const uint8_t * AL2O3_RESTRICT bitstring, Texels texels) {
 	int base_color1_R, base_color1_G, base_color1_B;
 	int base_color2_R, base_color2_G, base_color2_B;
 	int paint_color_R[4], paint_color_G[4], paint_color_B[4];
@@ -216,19 +136,18 @@ static void ProcessBlockETC2TMode(const uint8_t * AL2O3_RESTRICT bitstring,
 
 	uint32_t pixel_index_word = ((uint32_t)bitstring[4] << 24) | ((uint32_t)bitstring[5] << 16) |
 			((uint32_t)bitstring[6] << 8) | bitstring[7];
-	uint32_t *buffer = (uint32_t *)pixel_buffer;
 	for (int i = 0; i < 16; i++) {
 		int pixel_index = ((pixel_index_word & (1 << i)) >> i)			// Least significant bit.
 				| ((pixel_index_word & (0x10000 << i)) >> (16 + i - 1));	// Most significant bit.
 		int r = paint_color_R[pixel_index];
 		int g = paint_color_G[pixel_index];
 		int b = paint_color_B[pixel_index];
-		buffer[(i & 3) * 4 + ((i & 12) >> 2)] = detexPack32RGB8Alpha0xFF(r, g, b);
+		texels.Store((i & 3) * 4 + ((i & 12) >> 2), detexPack32RGB8Alpha0xFF(r, g, b));
 	}
 }
 
-static void ProcessBlockETC2HMode(const uint8_t * AL2O3_RESTRICT bitstring,
-																		 uint8_t * AL2O3_RESTRICT pixel_buffer) {
+template<typename Texels>
+static void ProcessBlockETC2HMode(const uint8_t * AL2O3_RESTRICT bitstring, Texels texels) {
 	int base_color1_R, base_color1_G, base_color1_B;
 	int base_color2_R, base_color2_G, base_color2_B;
 	int paint_color_R[4], paint_color_G[4], paint_color_B[4];
@@ -271,19 +190,18 @@ static void ProcessBlockETC2HMode(const uint8_t * AL2O3_RESTRICT bitstring,
 
 	uint32_t pixel_index_word = ((uint32_t)bitstring[4] << 24) | ((uint32_t)bitstring[5] << 16) |
 			((uint32_t)bitstring[6] << 8) | bitstring[7];
-	uint32_t *buffer = (uint32_t *)pixel_buffer;
 	for (int i = 0; i < 16; i++) {
 		int pixel_index = ((pixel_index_word & (1 << i)) >> i)			// Least significant bit.
 				| ((pixel_index_word & (0x10000 << i)) >> (16 + i - 1));	// Most significant bit.
 		int r = paint_color_R[pixel_index];
 		int g = paint_color_G[pixel_index];
 		int b = paint_color_B[pixel_index];
-		buffer[(i & 3) * 4 + ((i & 12) >> 2)] = detexPack32RGB8Alpha0xFF(r, g, b);
+		texels.Store((i & 3) * 4 + ((i & 12) >> 2), detexPack32RGB8Alpha0xFF(r, g, b));
 	}
 }
 
-static void ProcessBlockETC2PlanarMode(const uint8_t * AL2O3_RESTRICT bitstring,
-																			 uint8_t * AL2O3_RESTRICT pixel_buffer) {
+template<typename Texels>
+static void ProcessBlockETC2PlanarMode(const uint8_t * AL2O3_RESTRICT bitstring, Texels texels) {
 	// Each color O, H and V is in 6-7-6 format.
 	int RO = (bitstring[0] & 0x7E) >> 1;
 	int GO = ((bitstring[0] & 0x1) << 6) | ((bitstring[1] & 0x7E) >> 1);
@@ -304,23 +222,23 @@ static void ProcessBlockETC2PlanarMode(const uint8_t * AL2O3_RESTRICT bitstring,
 	RV = (RV << 2) | ((RV & 0x30) >> 4);
 	GV = (GV << 1) | ((GV & 0x40) >> 6);
 	BV = (BV << 2) | ((BV & 0x30) >> 4);
-	uint32_t *buffer = (uint32_t *)pixel_buffer;
 	for (int y = 0; y < 4; y++)
 		for (int x = 0; x < 4; x++) {
 			int r = detexClamp0To255((x * (RH - RO) + y * (RV - RO) + 4 * RO + 2) >> 2);
 			int g = detexClamp0To255((x * (GH - GO) + y * (GV - GO) + 4 * GO + 2) >> 2);
 			int b = detexClamp0To255((x * (BH - BO) + y * (BV - BO) + 4 * BO + 2) >> 2);
-			buffer[y * 4 + x] = detexPack32RGB8Alpha0xFF(r, g, b);
+			texels.Store(y * 4 + x, detexPack32RGB8Alpha0xFF(r, g, b));
 		}
 }
 
 /* Decompress a 64-bit 4x4 pixel texture block compressed using the ETC2 */
 /* format. */
-bool detexDecompressBlockETC2(const uint8_t * AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer) {
+template<typename Texels>
+static bool DecompressBlockETC2(const uint8_t * AL2O3_RESTRICT bitstring, Texels texels) {
 	// Figure out the mode.
 	if ((bitstring[3] & 2) == 0) {
 		// Individual mode.
-		return detexDecompressBlockETC1(bitstring, pixel_buffer);
+		return DecompressBlockETC1(bitstring, texels);
 	}
 	int R = (bitstring[0] & 0xF8);
 	R += complement3bitshifted(bitstring[0] & 7);
@@ -330,24 +248,24 @@ bool detexDecompressBlockETC2(const uint8_t * AL2O3_RESTRICT bitstring, uint8_t
 	B += complement3bitshifted(bitstring[2] & 7);
 	if (R & 0xFF07) {
 		// T mode.
-		ProcessBlockETC2TMode(bitstring, pixel_buffer);
+		ProcessBlockETC2TMode(bitstring, texels);
 		return true;
 	}
 	else
 	if (G & 0xFF07) {
 		// H mode.
-		ProcessBlockETC2HMode(bitstring, pixel_buffer);
+		ProcessBlockETC2HMode(bitstring, texels);
 		return true;
 	}
 	else
 	if (B & 0xFF07) {
 		// Planar mode.
-		ProcessBlockETC2PlanarMode(bitstring, pixel_buffer);
+		ProcessBlockETC2PlanarMode(bitstring, texels);
 		return true;
 	}
 	else {
 		// Differential mode.
-		return detexDecompressBlockETC1(bitstring,	pixel_buffer);
+		return DecompressBlockETC1(bitstring, texels);
 	}
 }
 
@@ -365,9 +283,10 @@ static const int punchthrough_modifier_table[8][4] = {
 static const uint32_t punchthrough_mask_table[4] = {
 		0xFFFFFFFF, 0xFFFFFFFF, 0x00000000, 0xFFFFFFFF };
 
+template<typename Texels>
 static AL2O3_FORCE_INLINE void ProcessPixelETC2Punchthrough(uint8_t i,
 																													 uint32_t pixel_index_word, uint32_t table_codeword,
-																													 int * AL2O3_RESTRICT base_color_subblock, uint8_t * AL2O3_RESTRICT pixel_buffer) {
+																													 int * AL2O3_RESTRICT base_color_subblock, Texels texels) {
 	int pixel_index = ((pixel_index_word & (1 << i)) >> i)
 			| ((pixel_index_word & (0x10000 << i)) >> (16 + i - 1));
 	int r, g, b;
@@ -376,14 +295,12 @@ static AL2O3_FORCE_INLINE void ProcessPixelETC2Punchthrough(uint8_t i,
 	g = detexClamp0To255(base_color_subblock[1] + modifier);
 	b = detexClamp0To255(base_color_subblock[2] + modifier);
 	uint32_t mask = punchthrough_mask_table[pixel_index];
-	uint32_t *buffer = (uint32_t *)pixel_buffer;
-	buffer[(i & 3) * 4 + ((i & 12) >> 2)] =
-			detexPack32RGB8Alpha0xFF(r, g, b) & mask;
+	texels.Store((i & 3) * 4 + ((i & 12) >> 2), detexPack32RGB8Alpha0xFF(r, g, b) & mask);
 }
 
 
-void ProcessBlockETC2PunchthroughDifferentialMode(const uint8_t * AL2O3_RESTRICT bitstring,
-																									uint8_t * AL2O3_RESTRICT pixel_buffer) {
+template<typename Texels>
+static void ProcessBlockETC2PunchthroughDifferentialMode(const uint8_t * AL2O3_RESTRICT bitstring, Texels texels) {
 	int flipbit = bitstring[3] & 1;
 	int base_color_subblock1[3];
 	int base_color_subblock2[3];
@@ -407,45 +324,45 @@ void ProcessBlockETC2PunchthroughDifferentialMode(const uint8_t * AL2O3_RESTRICT
 	uint32_t pixel_index_word = ((uint32_t)bitstring[4] << 24) | ((uint32_t)bitstring[5] << 16) |
 			((uint32_t)bitstring[6] << 8) | bitstring[7];
 	if (flipbit == 0) {
-		ProcessPixelETC2Punchthrough(0, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(1, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(2, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(3, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(4, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(5, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(6, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(7, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(8, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC2Punchthrough(9, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC2Punchthrough(10, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC2Punchthrough(11, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC2Punchthrough(12, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC2Punchthrough(13, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC2Punchthrough(14, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC2Punchthrough(15, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
+		ProcessPixelETC2Punchthrough(0, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(1, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(2, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(3, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(4, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(5, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(6, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(7, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(8, pixel_index_word, table_codeword2, base_color_subblock2, texels);
+		ProcessPixelETC2Punchthrough(9, pixel_index_word, table_codeword2, base_color_subblock2, texels);
+		ProcessPixelETC2Punchthrough(10, pixel_index_word, table_codeword2, base_color_subblock2, texels);
+		ProcessPixelETC2Punchthrough(11, pixel_index_word, table_codeword2, base_color_subblock2, texels);
+		ProcessPixelETC2Punchthrough(12, pixel_index_word, table_codeword2, base_color_subblock2, texels);
+		ProcessPixelETC2Punchthrough(13, pixel_index_word, table_codeword2, base_color_subblock2, texels);
+		ProcessPixelETC2Punchthrough(14, pixel_index_word, table_codeword2, base_color_subblock2, texels);
+		ProcessPixelETC2Punchthrough(15, pixel_index_word, table_codeword2, base_color_subblock2, texels);
 	}
 	else {
-		ProcessPixelETC2Punchthrough(0, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(1, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(2, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC2Punchthrough(3, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC2Punchthrough(4, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(5, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(6, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC2Punchthrough(7, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC2Punchthrough(8, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(9, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(10, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC2Punchthrough(11, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC2Punchthrough(12, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(13, pixel_index_word, table_codeword1, base_color_subblock1, pixel_buffer);
-		ProcessPixelETC2Punchthrough(14, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
-		ProcessPixelETC2Punchthrough(15, pixel_index_word, table_codeword2, base_color_subblock2, pixel_buffer);
+		ProcessPixelETC2Punchthrough(0, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(1, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(2, pixel_index_word, table_codeword2, base_color_subblock2, texels);
+		ProcessPixelETC2Punchthrough(3, pixel_index_word, table_codeword2, base_color_subblock2, texels);
+		ProcessPixelETC2Punchthrough(4, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(5, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(6, pixel_index_word, table_codeword2, base_color_subblock2, texels);
+		ProcessPixelETC2Punchthrough(7, pixel_index_word, table_codeword2, base_color_subblock2, texels);
+		ProcessPixelETC2Punchthrough(8, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(9, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(10, pixel_index_word, table_codeword2, base_color_subblock2, texels);
+		ProcessPixelETC2Punchthrough(11, pixel_index_word, table_codeword2, base_color_subblock2, texels);
+		ProcessPixelETC2Punchthrough(12, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(13, pixel_index_word, table_codeword1, base_color_subblock1, texels);
+		ProcessPixelETC2Punchthrough(14, pixel_index_word, table_codeword2, base_color_subblock2, texels);
+		ProcessPixelETC2Punchthrough(15, pixel_index_word, table_codeword2, base_color_subblock2, texels);
 	}
 }
 
-static void ProcessBlockETC2PunchthroughTMode(const uint8_t * AL2O3_RESTRICT bitstring,
-																								 uint8_t * AL2O3_RESTRICT pixel_buffer) {
+template<typename Texels>
+static void ProcessBlockETC2PunchthroughTMode(const uint8_t * AL2O3_RESTRICT bitstring, Texels texels) {
 	int base_color1_R, base_color1_G, base_color1_B;
 	int base_color2_R, base_color2_G, base_color2_B;
 	int paint_color_R[4], paint_color_G[4], paint_color_B[4];
@@ -479,7 +396,6 @@ static void ProcessBlockETC2PunchthroughTMode(const uint8_t * AL2O3_RESTRICT bit
 	paint_color_B[3] = detexClamp0To255(base_color2_B - distance);
 	uint32_t pixel_index_word = ((uint32_t)bitstring[4] << 24) | ((uint32_t)bitstring[5] << 16) |
 			((uint32_t)bitstring[6] << 8) | bitstring[7];
-	uint32_t *buffer = (uint32_t *)pixel_buffer;
 	for (int i = 0; i < 16; i++) {
 		int pixel_index = ((pixel_index_word & (1 << i)) >> i)			// Least significant bit.
 				| ((pixel_index_word & (0x10000 << i)) >> (16 + i - 1));	// Most significant bit.
@@ -487,11 +403,11 @@ static void ProcessBlockETC2PunchthroughTMode(const uint8_t * AL2O3_RESTRICT bit
 		int g = paint_color_G[pixel_index];
 		int b = paint_color_B[pixel_index];
 		uint32_t mask = punchthrough_mask_table[pixel_index];
-		buffer[(i & 3) * 4 + ((i & 12) >> 2)] = (detexPack32RGB8Alpha0xFF(r, g, b)) & mask;
+		texels.Store((i & 3) * 4 + ((i & 12) >> 2), (detexPack32RGB8Alpha0xFF(r, g, b)) & mask);
 	}
 }
-static void ProcessBlockETC2PunchthroughHMode(const uint8_t * AL2O3_RESTRICT bitstring,
-																								 uint8_t * AL2O3_RESTRICT pixel_buffer) {
+template<typename Texels>
+static void ProcessBlockETC2PunchthroughHMode(const uint8_t * AL2O3_RESTRICT bitstring, Texels texels) {
 	int base_color1_R, base_color1_G, base_color1_B;
 	int base_color2_R, base_color2_G, base_color2_B;
 	int paint_color_R[4], paint_color_G[4], paint_color_B[4];
@@ -533,7 +449,6 @@ static void ProcessBlockETC2PunchthroughHMode(const uint8_t * AL2O3_RESTRICT bit
 	paint_color_B[3] = detexClamp0To255(base_color2_B - distance);
 	uint32_t pixel_index_word = ((uint32_t)bitstring[4] << 24) | ((uint32_t)bitstring[5] << 16) |
 			((uint32_t)bitstring[6] << 8) | bitstring[7];
-	uint32_t *buffer = (uint32_t *)pixel_buffer;
 	for (int i = 0; i < 16; i++) {
 		int pixel_index = ((pixel_index_word & (1 << i)) >> i)			// Least significant bit.
 				| ((pixel_index_word & (0x10000 << i)) >> (16 + i - 1));	// Most significant bit.
@@ -541,13 +456,14 @@ static void ProcessBlockETC2PunchthroughHMode(const uint8_t * AL2O3_RESTRICT bit
 		int g = paint_color_G[pixel_index];
 		int b = paint_color_B[pixel_index];
 		uint32_t mask = punchthrough_mask_table[pixel_index];
-		buffer[(i & 3) * 4 + ((i & 12) >> 2)] = (detexPack32RGB8Alpha0xFF(r, g, b)) & mask;
+		texels.Store((i & 3) * 4 + ((i & 12) >> 2), (detexPack32RGB8Alpha0xFF(r, g, b)) & mask);
 	}
 }
 
 /* Decompress a 64-bit 4x4 pixel texture block compressed using the */
 /* ETC2_PUNCHTROUGH format. */
-bool detexDecompressBlockETC2_PUNCHTHROUGH(const uint8_t * AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer) {
+template<typename Texels>
+static bool DecompressBlockETC2_PUNCHTHROUGH(const uint8_t * AL2O3_RESTRICT bitstring, Texels texels) {
 	int R = (bitstring[0] & 0xF8);
 	R += complement3bitshifted(bitstring[0] & 7);
 	int G = (bitstring[1] & 0xF8);
@@ -558,40 +474,67 @@ bool detexDecompressBlockETC2_PUNCHTHROUGH(const uint8_t * AL2O3_RESTRICT bitstr
 	if (R & 0xFF07) {
 		// T mode.
 		if (opaque) {
-			ProcessBlockETC2TMode(bitstring, pixel_buffer);
+			ProcessBlockETC2TMode(bitstring, texels);
 			return true;
 		}
 		// T mode with punchthrough alpha.
-		ProcessBlockETC2PunchthroughTMode(bitstring, pixel_buffer);
+		ProcessBlockETC2PunchthroughTMode(bitstring, texels);
 		return true;
 	}
 	else
 	if (G & 0xFF07) {
 		// H mode.
 		if (opaque) {
-			ProcessBlockETC2HMode(bitstring, pixel_buffer);
+			ProcessBlockETC2HMode(bitstring, texels);
 			return true;
 		}
 		// H mode with punchthrough alpha.
-		ProcessBlockETC2PunchthroughHMode(bitstring, pixel_buffer);
+		ProcessBlockETC2PunchthroughHMode(bitstring, texels);
 		return true;
 	}
 	else
 	if (B & 0xFF07) {
 		// Planar mode.
-		ProcessBlockETC2PlanarMode(bitstring, pixel_buffer);
+		ProcessBlockETC2PlanarMode(bitstring, texels);
 		return true;
 	}
 	else {
 		// Differential mode.
 		if (opaque)
-			return detexDecompressBlockETC1(bitstring, pixel_buffer);
+			return DecompressBlockETC1(bitstring, texels);
 		// Differential mode with punchthrough alpha.
-		ProcessBlockETC2PunchthroughDifferentialMode(bitstring, pixel_buffer);
+		ProcessBlockETC2PunchthroughDifferentialMode(bitstring, texels);
 		return true;
 	}
 }
 
+bool detexDecompressBlockETC2(const uint8_t * AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer) {
+	return DecompressBlockETC2(bitstring, PackedTexels{(uint32_t *) pixel_buffer});
+}
+
+bool detexDecompressBlockETC2(const uint8_t *bitstring, float *texels, float const *colour, float const *alpha) {
+	return DecompressBlockETC2(bitstring, ConvertedTexels<float>{texels, colour, alpha});
+}
+
+bool detexDecompressBlockETC2(const uint8_t *bitstring, uint16_t *texels, uint16_t const *colour, uint16_t const *alpha) {
+	return DecompressBlockETC2(bitstring, ConvertedTexels<uint16_t>{texels, colour, alpha});
+}
+
+bool detexDecompressBlockETC2_PUNCHTHROUGH(const uint8_t * AL2O3_RESTRICT bitstring, uint8_t * AL2O3_RESTRICT pixel_buffer) {
+	return DecompressBlockETC2_PUNCHTHROUGH(bitstring, PackedTexels{(uint32_t *) pixel_buffer});
+}
+
+bool detexDecompressBlockETC2_PUNCHTHROUGH(const uint8_t *bitstring, float *texels, float const *colour, float const *alpha) {
+	return DecompressBlockETC2_PUNCHTHROUGH(bitstring, ConvertedTexels<float>{texels, colour, alpha});
+}
+
+bool detexDecompressBlockETC2_PUNCHTHROUGH(const uint8_t *bitstring,
+																					 uint16_t *texels,
+																					 uint16_t const *colour,
+																					 uint16_t const *alpha) {
+	return DecompressBlockETC2_PUNCHTHROUGH(bitstring, ConvertedTexels<uint16_t>{texels, colour, alpha});
+}
+
 AL2O3_EXTERN_C void Image_DecompressETC2PunchThroughBlock(void const *AL2O3_RESTRICT input, uint8_t output[4 * 4 * sizeof(uint32_t)]) {
 	detexDecompressBlockETC2_PUNCHTHROUGH((uint8_t const*) input, output);
 }
@@ -6,8 +6,56 @@
 #include "tiny_imageformat/tinyimageformat_decode.h"
 #include "gfx_image/image.h"
 #include "gfx_imagedecompress/imagedecompress.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define DXTC_DECOMP_SSE2 1
+#else
+#define DXTC_DECOMP_SSE2 0
+#endif
 
 extern bool detexDecompressBlockBPTC(const uint8_t *bitstring, uint8_t *pixel_buffer);
+extern bool detexDecompressBlockBPTC(const uint8_t *bitstring, float *texels, float const *colour, float const *alpha);
+extern bool detexDecompressBlockBPTC(const uint8_t *bitstring, uint16_t *texels, uint16_t const *colour, uint16_t const *alpha);
+extern void detexDecompressBlocksBPTC(const uint8_t *bitstrings, uint32_t count, uint8_t *pixel_buffers);
+extern bool detexDecompressBlockBPTC_FLOAT(const uint8_t *bitstring, uint8_t *pixel_buffer);
+extern bool detexDecompressBlockBPTC_FLOAT(const uint8_t *bitstring, float *texels);
+extern bool detexDecompressBlockBPTC_SIGNED_FLOAT(const uint8_t *bitstring, uint8_t *pixel_buffer);
+extern bool detexDecompressBlockBPTC_SIGNED_FLOAT(const uint8_t *bitstring, float *texels);
+extern bool IsPVRTC1Format(TinyImageFormat format);
+extern bool detexDecompressBlockETC2(const uint8_t *bitstring, float *texels, float const *colour, float const *alpha);
+extern bool detexDecompressBlockETC2(const uint8_t *bitstring, uint16_t *texels, uint16_t const *colour, uint16_t const *alpha);
+extern bool detexDecompressBlockETC2_PUNCHTHROUGH(const uint8_t *bitstring, float *texels, float const *colour, float const *alpha);
+extern bool detexDecompressBlockETC2_PUNCHTHROUGH(const uint8_t *bitstring,
+																									uint16_t *texels,
+																									uint16_t const *colour,
+																									uint16_t const *alpha);
+extern bool detexDecompressBlockETC2_EAC(const uint8_t *bitstring, float *texels, float const *colour, float const *alpha);
+extern bool detexDecompressBlockETC2_EAC(const uint8_t *bitstring, uint16_t *texels, uint16_t const *colour, uint16_t const *alpha);
+extern void detexDecompressBlockETC2_EAC_ALPHA(const uint8_t *bitstring, uint8_t *pixel_buffer);
+extern void detexDecompressBlockEAC_R11_8(const uint8_t *bitstring, uint8_t *pixel_buffer);
+extern void detexDecompressBlockEAC_RG11_8(const uint8_t *bitstring, uint8_t *pixel_buffer);
+extern void detexDecompressBlockEAC_SIGNED_R11_8(const uint8_t *bitstring, uint8_t *pixel_buffer);
+extern void detexDecompressBlockEAC_SIGNED_RG11_8(const uint8_t *bitstring, uint8_t *pixel_buffer);
+extern void detexDecompressBlockEAC_R11_F32(const uint8_t *bitstring, float *texels);
+extern void detexDecompressBlockEAC_RG11_F32(const uint8_t *bitstring, float *texels);
+extern void detexDecompressBlockEAC_SIGNED_R11_F32(const uint8_t *bitstring, float *texels);
+extern void detexDecompressBlockEAC_SIGNED_RG11_F32(const uint8_t *bitstring, float *texels);
+extern void detexDecompressBlockEAC_R11_F16(const uint8_t *bitstring, uint16_t *texels);
+extern void detexDecompressBlockEAC_RG11_F16(const uint8_t *bitstring, uint16_t *texels);
+extern void detexDecompressBlockEAC_SIGNED_R11_F16(const uint8_t *bitstring, uint16_t *texels);
+extern void detexDecompressBlockEAC_SIGNED_RG11_F16(const uint8_t *bitstring, uint16_t *texels);
+// in decompressstore.cpp, every 8 bit UNORM, SNORM and sRGB value as a float and as a half
+extern float const *UNorm8ToFloatTable();
+extern float const *SNorm8ToFloatTable();
+extern float const *SRGBToLinearTable();
+extern uint16_t const *UNorm8ToHalfTable();
+extern uint16_t const *SNorm8ToHalfTable();
+extern uint16_t const *SRGBToLinearHalfTable();
+extern uint32_t PVRTCWindowRowCount(Image_ImageHeader const *src);
+extern void DecompressPVRTCWindowRows(Image_ImageHeader const *src,
+																			Image_ImageHeader const *dst,
+																			uint32_t start,
+																			uint32_t end);
 
 void GetCompressedAlphaRamp(uint8_t alpha[8]) {
 	if (alpha[0] > alpha[1]) {
@@ -49,6 +97,186 @@ void DecompressDXTCAlphaBlock(uint64_t const compressedBlock, uint8_t *out, uint
 	}
 }
 
+// float and half output, each entry of the ramp is converted by table once
+template<typename T>
+static void DecompressDXTCAlphaBlock(uint64_t const compressedBlock, T *out, uint32_t pixelPitch, T const *table) {
+	uint8_t alpha[8];
+
+	alpha[0] = (uint8_t) (compressedBlock & 0xff);
+	alpha[1] = (uint8_t) ((compressedBlock >> 8) & 0xff);
+	GetCompressedAlphaRamp(alpha);
+
+	T ramp[8];
+	for (int i = 0; i < 8; i++) {
+		ramp[i] = table[alpha[i]];
+	}
+	for (int i = 0; i < 4 * 4; i++) {
+		uint32_t const index = (compressedBlock >> (16 + (i * BLOCK_ALPHA_PIXEL_BPP))) & BLOCK_ALPHA_PIXEL_MASK;
+		*out = ramp[index];
+		out += pixelPitch;
+	}
+}
+
+// BC4/5 SNORM endpoints are signed and -128 decodes as -127. Interpolating the endpoints offset by 127 rounds
+// exactly as the signed interpolation would, so the signed ramp is the unsigned arithmetic on 0 to 254
+static AL2O3_FORCE_INLINE uint8_t OffsetSignedEndpoint(uint8_t endpoint) {
+	int const v = (int8_t) endpoint;
+	return (uint8_t) ((v < -127 ? -127 : v) + 127);
+}
+
+// alpha[0] and alpha[1] are the encoded signed endpoints, the ramp is returned as int8 bit patterns
+void GetCompressedSignedAlphaRamp(uint8_t alpha[8]) {
+	// the mode is chosen by the encoded values, before -128 is clamped
+	bool const eightAlpha = (int8_t) alpha[0] > (int8_t) alpha[1];
+	uint32_t const a0 = OffsetSignedEndpoint(alpha[0]);
+	uint32_t const a1 = OffsetSignedEndpoint(alpha[1]);
+	uint32_t ramp[8] = { a0, a1 };
+	if (eightAlpha) {
+		for (uint32_t i = 1; i < 7; ++i) {
+			ramp[i + 1] = ((7 - i) * a0 + i * a1 + 3) / 7;
+		}
+	} else {
+		for (uint32_t i = 1; i < 5; ++i) {
+			ramp[i + 1] = ((5 - i) * a0 + i * a1 + 2) / 5;
+		}
+		ramp[6] = 0;    // -1.0
+		ramp[7] = 254;  // +1.0
+	}
+	for (uint32_t i = 0; i < 8; ++i) {
+		alpha[i] = (uint8_t) ((int) ramp[i] - 127);
+	}
+}
+
+void DecompressDXTCSignedAlphaBlock(uint64_t const compressedBlock, uint8_t *out, uint32_t pixelPitch) {
+	uint8_t alpha[8];
+
+	alpha[0] = (uint8_t) (compressedBlock & 0xff);
+	alpha[1] = (uint8_t) ((compressedBlock >> 8) & 0xff);
+	GetCompressedSignedAlphaRamp(alpha);
+
+	for (int i = 0; i < 4 * 4; i++) {
+		uint32_t const index = (compressedBlock >> (16 + (i * BLOCK_ALPHA_PIXEL_BPP))) & BLOCK_ALPHA_PIXEL_MASK;
+		*out = alpha[index];
+		out += pixelPitch;
+	}
+}
+
+template<typename T>
+static void DecompressDXTCSignedAlphaBlock(uint64_t const compressedBlock, T *out, uint32_t pixelPitch, T const *table) {
+	uint8_t alpha[8];
+
+	alpha[0] = (uint8_t) (compressedBlock & 0xff);
+	alpha[1] = (uint8_t) ((compressedBlock >> 8) & 0xff);
+	GetCompressedSignedAlphaRamp(alpha);
+
+	T ramp[8];
+	for (int i = 0; i < 8; i++) {
+		ramp[i] = table[alpha[i]];
+	}
+	for (int i = 0; i < 4 * 4; i++) {
+		uint32_t const index = (compressedBlock >> (16 + (i * BLOCK_ALPHA_PIXEL_BPP))) & BLOCK_ALPHA_PIXEL_MASK;
+		*out = ramp[index];
+		out += pixelPitch;
+	}
+}
+
+#if DXTC_DECOMP_SSE2
+// the ramps of 8 alpha blocks side by side, entry k of block lane is ramps[k * 8 + lane].
+// n / 7 and n / 5 are exact as (n * 9363) >> 16 and (n * 13108) >> 16 for every n the ramps produce
+template<bool IsSigned>
+static void GetCompressedAlphaRamps8(uint64_t const blocks[8], uint8_t ramps[8 * 8]) {
+	uint16_t endpoint0[8], endpoint1[8], eightAlpha[8];
+	for (uint32_t lane = 0; lane < 8; ++lane) {
+		uint8_t const a0 = (uint8_t) (blocks[lane] & 0xff);
+		uint8_t const a1 = (uint8_t) ((blocks[lane] >> 8) & 0xff);
+		if (IsSigned) {
+			endpoint0[lane] = OffsetSignedEndpoint(a0);
+			endpoint1[lane] = OffsetSignedEndpoint(a1);
+			eightAlpha[lane] = (int8_t) a0 > (int8_t) a1 ? 0xFFFF : 0;
+		} else {
+			endpoint0[lane] = a0;
+			endpoint1[lane] = a1;
+			eightAlpha[lane] = a0 > a1 ? 0xFFFF : 0;
+		}
+	}
+	__m128i const a0 = _mm_loadu_si128((__m128i const *) endpoint0);
+	__m128i const a1 = _mm_loadu_si128((__m128i const *) endpoint1);
+	__m128i const eight = _mm_loadu_si128((__m128i const *) eightAlpha);
+	__m128i const sevenths = _mm_set1_epi16(9363);
+	__m128i const fifths = _mm_set1_epi16(13108);
+
+	__m128i entry[8];
+	entry[0] = a0;
+	entry[1] = a1;
+	for (int i = 1; i < 7; ++i) {
+		__m128i const n7 = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(a0, _mm_set1_epi16((short) (7 - i))),
+																									 _mm_mullo_epi16(a1, _mm_set1_epi16((short) i))),
+																		 _mm_set1_epi16(3));
+		__m128i const q7 = _mm_mulhi_epu16(n7, sevenths);
+		__m128i q5;
+		if (i < 5) {
+			__m128i const n5 = _mm_add_epi16(_mm_add_epi16(_mm_mullo_epi16(a0, _mm_set1_epi16((short) (5 - i))),
+																										 _mm_mullo_epi16(a1, _mm_set1_epi16((short) i))),
+																			 _mm_set1_epi16(2));
+			q5 = _mm_mulhi_epu16(n5, fifths);
+		} else {
+			q5 = _mm_set1_epi16((short) (i == 5 ? 0 : (IsSigned ? 254 : 255)));
+		}
+		entry[i + 1] = _mm_or_si128(_mm_and_si128(eight, q7), _mm_andnot_si128(eight, q5));
+	}
+
+	for (uint32_t k = 0; k < 8; k += 2) {
+		__m128i packed;
+		if (IsSigned) {
+			__m128i const bias = _mm_set1_epi16(127);
+			packed = _mm_packs_epi16(_mm_sub_epi16(entry[k], bias), _mm_sub_epi16(entry[k + 1], bias));
+		} else {
+			packed = _mm_packus_epi16(entry[k], entry[k + 1]);
+		}
+		_mm_storeu_si128((__m128i *) (ramps + k * 8), packed);
+	}
+}
+#endif
+
+// strip decoder for BC4 (Channels 1) and BC5 (Channels 2), every block is Channels alpha blocks starting at
+// word FirstWord of BlockStride 8 byte words, so BC3 alpha alone is Channels 1 BlockStride 2 and BC5 green alone
+// is Channels 1 BlockStride 2 FirstWord 1
+template<bool IsSigned, uint32_t Channels, uint32_t BlockStride = Channels, uint32_t FirstWord = 0>
+static void DecompressDXTCAlphaBlocks(void const *input, uint32_t blockCount, uint8_t *output) {
+	uint64_t const *words = (uint64_t const *) input;
+	uint32_t const alphaBlockCount = blockCount * Channels;
+#if DXTC_DECOMP_SSE2
+	for (uint32_t b = 0; b < alphaBlockCount; b += 8) {
+		uint32_t const count = (alphaBlockCount - b < 8) ? alphaBlockCount - b : 8;
+		uint64_t group[8] = {};
+		for (uint32_t lane = 0; lane < count; ++lane) {
+			group[lane] = words[((b + lane) / Channels) * BlockStride + FirstWord + (b + lane) % Channels];
+		}
+		uint8_t ramps[8 * 8];
+		GetCompressedAlphaRamps8<IsSigned>(group, ramps);
+
+		for (uint32_t lane = 0; lane < count; ++lane) {
+			uint32_t const alphaBlock = b + lane;
+			uint8_t *out = output + (alphaBlock / Channels) * 4 * 4 * Channels + (alphaBlock % Channels);
+			uint64_t const indices = group[lane] >> 16;
+			for (uint32_t i = 0; i < 4 * 4; ++i) {
+				out[i * Channels] = ramps[((indices >> (i * BLOCK_ALPHA_PIXEL_BPP)) & BLOCK_ALPHA_PIXEL_MASK) * 8 + lane];
+			}
+		}
+	}
+#else
+	for (uint32_t b = 0; b < alphaBlockCount; ++b) {
+		uint8_t *out = output + (b / Channels) * 4 * 4 * Channels + (b % Channels);
+		uint64_t const alphaBlock = words[(b / Channels) * BlockStride + FirstWord + b % Channels];
+		if (IsSigned) {
+			DecompressDXTCSignedAlphaBlock(alphaBlock, out, Channels);
+		} else {
+			DecompressDXTCAlphaBlock(alphaBlock, out, Channels);
+		}
+	}
+#endif
+}
+
 void DecompressExplicitAlphaBlock(uint64_t const compressedBlock, uint8_t *outRGBA, uint32_t pixelPitch) {
 	for (int i = 0; i < 4 * 4; i++) {
 		uint8_t cAlpha = (uint8_t) ((compressedBlock >> (i * EXPLICIT_ALPHA_PIXEL_BPP)) & EXPLICIT_ALPHA_PIXEL_MASK);
@@ -57,9 +285,17 @@ void DecompressExplicitAlphaBlock(uint64_t const compressedBlock, uint8_t *outRG
 	}
 }
 
-// This function decompresses a DXT colour block
-// The block is decompressed to 8 bits per channel
-void DecompressRGBBlock(uint64_t const compressedBlock, uint32_t *outRGBA, bool bBC1) {
+template<typename T>
+static void DecompressExplicitAlphaBlock(uint64_t const compressedBlock, T *outRGBA, uint32_t pixelPitch, T const *table) {
+	for (int i = 0; i < 4 * 4; i++) {
+		uint8_t cAlpha = (uint8_t) ((compressedBlock >> (i * EXPLICIT_ALPHA_PIXEL_BPP)) & EXPLICIT_ALPHA_PIXEL_MASK);
+		*outRGBA = table[(cAlpha << EXPLICIT_ALPHA_PIXEL_BPP) | cAlpha];
+		outRGBA += pixelPitch;
+	}
+}
+
+// the 4 colours of a DXT colour block as 8 bits per channel BGRA
+static AL2O3_FORCE_INLINE void GetRGBBlockPalette(uint64_t const compressedBlock, uint32_t c[4], bool bBC1) {
 	// 2 565 colours are in the 1st 32 bits
 	uint32_t n0 = compressedBlock & 0xffff;
 	uint32_t n1 = (compressedBlock >> 16) & 0xffff;
@@ -79,7 +315,6 @@ void DecompressRGBBlock(uint64_t const compressedBlock, uint32_t *outRGBA, bool
 	b1 += (b1 >> 5);
 
 	// compute the 4 colours to interpolate between
-	uint32_t c[4];
 	c[0] = 0xff000000 | (r0 << 16) | (g0 << 8) | b0;
 	c[1] = 0xff000000 | (r1 << 16) | (g1 << 8) | b1;
 	if (!bBC1 || n0 > n1) {
@@ -89,12 +324,73 @@ void DecompressRGBBlock(uint64_t const compressedBlock, uint32_t *outRGBA, bool
 		c[2] = 0xff000000 | (((r0 + r1) / 2) << 16) | (((g0 + g1) / 2) << 8) | (((b0 + b1) / 2));
 		c[3] = 0x00000000;
 	}
+}
+
+// This function decompresses a DXT colour block
+// The block is decompressed to 8 bits per channel
+void DecompressRGBBlock(uint64_t const compressedBlock, uint32_t *outRGBA, bool bBC1) {
+	uint32_t c[4];
+	GetRGBBlockPalette(compressedBlock, c, bBC1);
 
 	for (int i = 0; i < 16; i++) {
 		outRGBA[i] = c[(compressedBlock >> (32 + (2 * i))) & 3];
 	}
 }
 
+// float and half output as RGBA, the palette is converted by table once and each texel is a copy of its entry
+template<typename T>
+static void DecompressRGBBlock(uint64_t const compressedBlock, T *outRGBA, bool bBC1, T const *colour, T const *alpha) {
+	uint32_t c[4];
+	GetRGBBlockPalette(compressedBlock, c, bBC1);
+
+	T palette[4][4];
+	for (int i = 0; i < 4; i++) {
+		palette[i][0] = colour[(c[i] >> 16) & 0xff];
+		palette[i][1] = colour[(c[i] >> 8) & 0xff];
+		palette[i][2] = colour[c[i] & 0xff];
+		palette[i][3] = alpha[c[i] >> 24];
+	}
+	for (int i = 0; i < 16; i++) {
+		memcpy(outRGBA + i * 4, palette[(compressedBlock >> (32 + (2 * i))) & 3], sizeof(palette[0]));
+	}
+}
+
+// BC1 to B5G6R5 (its endpoint layout), the endpoints are copied and the interpolated colours rounded back to 565
+static void DecompressDXBC1BlockTo565(void const *input, uint8_t output[4 * 4 * sizeof(uint16_t)]) {
+	uint64_t const compressedBlock = *(uint64_t const *) input;
+	uint32_t c[4];
+	GetRGBBlockPalette(compressedBlock, c, true);
+
+	uint16_t palette[4];
+	palette[0] = (uint16_t) (compressedBlock & 0xffff);
+	palette[1] = (uint16_t) ((compressedBlock >> 16) & 0xffff);
+	for (int i = 2; i < 4; i++) {
+		uint32_t const r = (c[i] >> 16) & 0xff;
+		uint32_t const g = (c[i] >> 8) & 0xff;
+		uint32_t const b = c[i] & 0xff;
+		palette[i] = (uint16_t) ((((r * 31 + 127) / 255) << 11) | (((g * 63 + 127) / 255) << 5) | ((b * 31 + 127) / 255));
+	}
+
+	uint16_t *out = (uint16_t *) output;
+	for (int i = 0; i < 16; i++) {
+		out[i] = palette[(compressedBlock >> (32 + (2 * i))) & 3];
+	}
+}
+
+// BC1 to R8G8B8, transparent texels are black
+static void DecompressDXBC1BlockToRGB8(void const *input, uint8_t output[4 * 4 * 3]) {
+	uint64_t const compressedBlock = *(uint64_t const *) input;
+	uint32_t c[4];
+	GetRGBBlockPalette(compressedBlock, c, true);
+
+	for (int i = 0; i < 16; i++) {
+		uint32_t const colour = c[(compressedBlock >> (32 + (2 * i))) & 3];
+		output[i * 3 + 0] = (uint8_t) (colour >> 16);
+		output[i * 3 + 1] = (uint8_t) (colour >> 8);
+		output[i * 3 + 2] = (uint8_t) colour;
+	}
+}
+
 AL2O3_EXTERN_C void Image_DecompressDXBCRGBSingleModeBlock(void const *input, uint32_t output[4 * 4]) {
 	DecompressRGBBlock(*(uint64_t const *) input, output, false);
 }
@@ -137,64 +433,321 @@ AL2O3_EXTERN_C void Image_DecompressDXBC5Block(void const *input, uint8_t output
 	DecompressDXTCAlphaBlock(((uint64_t const *) input)[1], ((uint8_t *) output) + 1, 2);
 }
 
+AL2O3_EXTERN_C void Image_DecompressDXBC4SNormBlock(void const *input, uint8_t output[4 * 4]) {
+	DecompressDXTCSignedAlphaBlock(*((uint64_t const *) input), output, 1);
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC5SNormBlock(void const *input, uint8_t output[4 * 4 * 2]) {
+	DecompressDXTCSignedAlphaBlock(((uint64_t const *) input)[0], ((uint8_t *) output) + 0, 2);
+	DecompressDXTCSignedAlphaBlock(((uint64_t const *) input)[1], ((uint8_t *) output) + 1, 2);
+}
+
+// alpha only decoders to 16 R8 texels, the colour half of the block is never read or is only tested for the mode
+static void DecompressDXBC1AlphaBlock(void const *input, uint8_t output[4 * 4]) {
+	uint64_t const compressedBlock = *(uint64_t const *) input;
+	uint32_t const n0 = compressedBlock & 0xffff;
+	uint32_t const n1 = (compressedBlock >> 16) & 0xffff;
+	// only index 3 of a 3 colour block is transparent, the palette isn't needed
+	if (n0 > n1) {
+		memset(output, 0xFF, 4 * 4);
+		return;
+	}
+	for (int i = 0; i < 16; i++) {
+		output[i] = (((compressedBlock >> (32 + (2 * i))) & 3) == 3) ? 0 : 0xFF;
+	}
+}
+
+static void DecompressDXBC2AlphaBlock(void const *input, uint8_t output[4 * 4]) {
+	DecompressExplicitAlphaBlock(((uint64_t const *) input)[0], output, 1);
+}
+
+static void DecompressDXBC3AlphaBlock(void const *input, uint8_t output[4 * 4]) {
+	DecompressDXTCAlphaBlock(((uint64_t const *) input)[0], output, 1);
+}
+
+static void DecompressETC2EACAlphaBlock(void const *input, uint8_t output[4 * 4]) {
+	detexDecompressBlockETC2_EAC_ALPHA((uint8_t const *) input, output);
+}
+
+// EAC R11 and RG11 rounded to 8 bits as they are decoded
+static void DecompressEAC11BlockTo8(void const *input, uint8_t output[4 * 4]) {
+	detexDecompressBlockEAC_R11_8((uint8_t const *) input, output);
+}
+
+static void DecompressEACDual11BlockTo8(void const *input, uint8_t output[4 * 4 * 2]) {
+	detexDecompressBlockEAC_RG11_8((uint8_t const *) input, output);
+}
+
+// RG11 is an R11 block for red followed by one for green, so red alone is the R11 decoder
+static void DecompressEACDual11GreenBlockTo8(void const *input, uint8_t output[4 * 4]) {
+	detexDecompressBlockEAC_R11_8((uint8_t const *) input + 8, output);
+}
+
+static void DecompressEACSigned11BlockTo8(void const *input, uint8_t output[4 * 4]) {
+	detexDecompressBlockEAC_SIGNED_R11_8((uint8_t const *) input, output);
+}
+
+static void DecompressEACDualSigned11BlockTo8(void const *input, uint8_t output[4 * 4 * 2]) {
+	detexDecompressBlockEAC_SIGNED_RG11_8((uint8_t const *) input, output);
+}
+
+static void DecompressEACDualSigned11GreenBlockTo8(void const *input, uint8_t output[4 * 4]) {
+	detexDecompressBlockEAC_SIGNED_R11_8((uint8_t const *) input + 8, output);
+}
+
+// one channel of BC5 (Word 0 red, 1 green) to 16 R8 texels
+template<bool IsSigned, uint32_t Word>
+static void DecompressDXBC5ChannelBlock(void const *input, uint8_t output[4 * 4]) {
+	if (IsSigned) {
+		DecompressDXTCSignedAlphaBlock(((uint64_t const *) input)[Word], output, 1);
+	} else {
+		DecompressDXTCAlphaBlock(((uint64_t const *) input)[Word], output, 1);
+	}
+}
+
+static void DecompressOpaqueAlphaBlock(void const *, uint8_t output[4 * 4]) {
+	memset(output, 0xFF, 4 * 4);
+}
+
 AL2O3_EXTERN_C void Image_DecompressDXBC7Block(void const *input, uint8_t output[4 * 4 * sizeof(uint32_t)]) {
 	Image_DecompressDXBCMultiModeLDRBlock((uint64_t const *) input, (uint32_t *) output);
 }
 
+AL2O3_EXTERN_C void Image_DecompressDXBC7Blocks(void const *input, uint32_t blockCount, uint8_t *output) {
+	detexDecompressBlocksBPTC((uint8_t const *) input, blockCount, output);
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC6HUFloatBlock(void const *input, uint8_t output[4 * 4 * 4 * sizeof(uint16_t)]) {
+	detexDecompressBlockBPTC_FLOAT((uint8_t const *) input, output);
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC6HSFloatBlock(void const *input, uint8_t output[4 * 4 * 4 * sizeof(uint16_t)]) {
+	detexDecompressBlockBPTC_SIGNED_FLOAT((uint8_t const *) input, output);
+}
+
+// float and half blocks, the kernels convert each decoded channel by table as they write it. The BC1-5
+// palettes and ramps are converted once per block
+template<typename T>
+static void DecompressDXBC2BlockConverted(void const *input, T *output, T const *colour, T const *alpha) {
+	DecompressRGBBlock(((uint64_t const *) input)[1], output, false, colour, alpha);
+	DecompressExplicitAlphaBlock(((uint64_t const *) input)[0], output + 3, 4, alpha);
+}
+
+template<typename T>
+static void DecompressDXBC3BlockConverted(void const *input, T *output, T const *colour, T const *alpha) {
+	DecompressRGBBlock(((uint64_t const *) input)[1], output, false, colour, alpha);
+	DecompressDXTCAlphaBlock(((uint64_t const *) input)[0], output + 3, 4, alpha);
+}
+
+template<typename T>
+static void DecompressDXBC5BlockConverted(void const *input, T *output, T const *table) {
+	DecompressDXTCAlphaBlock(((uint64_t const *) input)[0], output + 0, 2, table);
+	DecompressDXTCAlphaBlock(((uint64_t const *) input)[1], output + 1, 2, table);
+}
+
+template<typename T>
+static void DecompressDXBC5SNormBlockConverted(void const *input, T *output, T const *table) {
+	DecompressDXTCSignedAlphaBlock(((uint64_t const *) input)[0], output + 0, 2, table);
+	DecompressDXTCSignedAlphaBlock(((uint64_t const *) input)[1], output + 1, 2, table);
+}
+
 AL2O3_EXTERN_C void Image_DecompressDXBC1BlockF(void const *input, float output[4 * 4 * 4]) {
-	uint8_t packed[4 * 4 * sizeof(uint32_t)];
-	Image_DecompressDXBC1Block(input, packed);
-	TinyImageFormat_DecodeInput in = {};
-	in.pixel = packed;
-	TinyImageFormat_DecodeLogicalPixelsF(TinyImageFormat_B8G8R8A8_UNORM, &in, 16, output);
+	DecompressRGBBlock(*(uint64_t const *) input, output, true, UNorm8ToFloatTable(), UNorm8ToFloatTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC1SRGBBlockF(void const *input, float output[4 * 4 * 4]) {
+	DecompressRGBBlock(*(uint64_t const *) input, output, true, SRGBToLinearTable(), UNorm8ToFloatTable());
 }
 
 AL2O3_EXTERN_C void Image_DecompressDXBC2BlockF(void const *input, float output[4 * 4 * 4]) {
-	uint8_t packed[4 * 4 * sizeof(uint32_t)];
-	Image_DecompressDXBC2Block(input, packed);
-	TinyImageFormat_DecodeInput in = {};
-	in.pixel = packed;
-	TinyImageFormat_DecodeLogicalPixelsF(TinyImageFormat_B8G8R8A8_UNORM, &in, 16, output);
+	DecompressDXBC2BlockConverted(input, output, UNorm8ToFloatTable(), UNorm8ToFloatTable());
 }
 
+AL2O3_EXTERN_C void Image_DecompressDXBC2SRGBBlockF(void const *input, float output[4 * 4 * 4]) {
+	DecompressDXBC2BlockConverted(input, output, SRGBToLinearTable(), UNorm8ToFloatTable());
+}
 
 AL2O3_EXTERN_C void Image_DecompressDXBC3BlockF(void const *input, float output[4 * 4 * 4]) {
-	uint8_t packed[4 * 4 * sizeof(uint32_t)];
-	Image_DecompressDXBC3Block(input, packed);
-	TinyImageFormat_DecodeInput in = {};
-	in.pixel = packed;
-	TinyImageFormat_DecodeLogicalPixelsF(TinyImageFormat_B8G8R8A8_UNORM, &in, 16, output);
+	DecompressDXBC3BlockConverted(input, output, UNorm8ToFloatTable(), UNorm8ToFloatTable());
 }
 
+AL2O3_EXTERN_C void Image_DecompressDXBC3SRGBBlockF(void const *input, float output[4 * 4 * 4]) {
+	DecompressDXBC3BlockConverted(input, output, SRGBToLinearTable(), UNorm8ToFloatTable());
+}
 
 AL2O3_EXTERN_C void Image_DecompressDXBC4BlockF(void const *input, float output[4 * 4]) {
-	uint8_t packed[4 * 4];
-	Image_DecompressDXBC4Block(input, packed);
-	for (uint32_t i = 0; i < 4 * 4; ++i) {
-		output[i] = ((float) packed[i]) / 255.0f;
-	}
+	DecompressDXTCAlphaBlock(*(uint64_t const *) input, output, 1, UNorm8ToFloatTable());
 }
 
 AL2O3_EXTERN_C void Image_DecompressDXBC5BlockF(void const *input, float output[4 * 4 * 2]) {
-	uint8_t packed[4 * 4 * 2];
-	Image_DecompressDXBC5Block(input, packed);
-	for (uint32_t i = 0; i < 4 * 4 * 2; ++i) {
-		output[i] = ((float) packed[i]) / 255.0f;
-	}
+	DecompressDXBC5BlockConverted(input, output, UNorm8ToFloatTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC4SNormBlockF(void const *input, float output[4 * 4]) {
+	DecompressDXTCSignedAlphaBlock(*(uint64_t const *) input, output, 1, SNorm8ToFloatTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC5SNormBlockF(void const *input, float output[4 * 4 * 2]) {
+	DecompressDXBC5SNormBlockConverted(input, output, SNorm8ToFloatTable());
 }
 
 AL2O3_EXTERN_C void Image_DecompressDXBC7BlockF(void const *input, float output[4 * 4 * 4]) {
-	uint8_t packed[4 * 4 * sizeof(uint32_t)];
+	detexDecompressBlockBPTC((uint8_t const *) input, output, UNorm8ToFloatTable(), UNorm8ToFloatTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC7SRGBBlockF(void const *input, float output[4 * 4 * 4]) {
+	detexDecompressBlockBPTC((uint8_t const *) input, output, SRGBToLinearTable(), UNorm8ToFloatTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC6HUFloatBlockF(void const *input, float output[4 * 4 * 4]) {
+	detexDecompressBlockBPTC_FLOAT((uint8_t const *) input, output);
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC6HSFloatBlockF(void const *input, float output[4 * 4 * 4]) {
+	detexDecompressBlockBPTC_SIGNED_FLOAT((uint8_t const *) input, output);
+}
+
+AL2O3_EXTERN_C void Image_DecompressETC2BlockF(void const *input, float output[4 * 4 * 4]) {
+	detexDecompressBlockETC2((uint8_t const *) input, output, UNorm8ToFloatTable(), UNorm8ToFloatTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressETC2SRGBBlockF(void const *input, float output[4 * 4 * 4]) {
+	detexDecompressBlockETC2((uint8_t const *) input, output, SRGBToLinearTable(), UNorm8ToFloatTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressETC2PunchThroughBlockF(void const *input, float output[4 * 4 * 4]) {
+	detexDecompressBlockETC2_PUNCHTHROUGH((uint8_t const *) input, output, UNorm8ToFloatTable(), UNorm8ToFloatTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressETC2PunchThroughSRGBBlockF(void const *input, float output[4 * 4 * 4]) {
+	detexDecompressBlockETC2_PUNCHTHROUGH((uint8_t const *) input, output, SRGBToLinearTable(), UNorm8ToFloatTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressETC2EACBlockF(void const *input, float output[4 * 4 * 4]) {
+	detexDecompressBlockETC2_EAC((uint8_t const *) input, output, UNorm8ToFloatTable(), UNorm8ToFloatTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressETC2EACSRGBBlockF(void const *input, float output[4 * 4 * 4]) {
+	detexDecompressBlockETC2_EAC((uint8_t const *) input, output, SRGBToLinearTable(), UNorm8ToFloatTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressEAC11BlockF(void const *input, float output[4 * 4]) {
+	detexDecompressBlockEAC_R11_F32((uint8_t const *) input, output);
+}
+
+AL2O3_EXTERN_C void Image_DecompressEACSigned11BlockF(void const *input, float output[4 * 4]) {
+	detexDecompressBlockEAC_SIGNED_R11_F32((uint8_t const *) input, output);
+}
+
+AL2O3_EXTERN_C void Image_DecompressEACDual11BlockF(void const *input, float output[4 * 4 * 2]) {
+	detexDecompressBlockEAC_RG11_F32((uint8_t const *) input, output);
+}
+
+AL2O3_EXTERN_C void Image_DecompressEACDualSigned11BlockF(void const *input, float output[4 * 4 * 2]) {
+	detexDecompressBlockEAC_SIGNED_RG11_F32((uint8_t const *) input, output);
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC1BlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	DecompressRGBBlock(*(uint64_t const *) input, output, true, UNorm8ToHalfTable(), UNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC1SRGBBlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	DecompressRGBBlock(*(uint64_t const *) input, output, true, SRGBToLinearHalfTable(), UNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC2BlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	DecompressDXBC2BlockConverted(input, output, UNorm8ToHalfTable(), UNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC2SRGBBlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	DecompressDXBC2BlockConverted(input, output, SRGBToLinearHalfTable(), UNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC3BlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	DecompressDXBC3BlockConverted(input, output, UNorm8ToHalfTable(), UNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC3SRGBBlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	DecompressDXBC3BlockConverted(input, output, SRGBToLinearHalfTable(), UNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC4BlockH(void const *input, uint16_t output[4 * 4]) {
+	DecompressDXTCAlphaBlock(*(uint64_t const *) input, output, 1, UNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC5BlockH(void const *input, uint16_t output[4 * 4 * 2]) {
+	DecompressDXBC5BlockConverted(input, output, UNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC4SNormBlockH(void const *input, uint16_t output[4 * 4]) {
+	DecompressDXTCSignedAlphaBlock(*(uint64_t const *) input, output, 1, SNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC5SNormBlockH(void const *input, uint16_t output[4 * 4 * 2]) {
+	DecompressDXBC5SNormBlockConverted(input, output, SNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC7BlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	detexDecompressBlockBPTC((uint8_t const *) input, output, UNorm8ToHalfTable(), UNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC7SRGBBlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	detexDecompressBlockBPTC((uint8_t const *) input, output, SRGBToLinearHalfTable(), UNorm8ToHalfTable());
+}
+
+// BC6H decodes to halves natively
+AL2O3_EXTERN_C void Image_DecompressDXBC6HUFloatBlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	detexDecompressBlockBPTC_FLOAT((uint8_t const *) input, (uint8_t *) output);
+}
+
+AL2O3_EXTERN_C void Image_DecompressDXBC6HSFloatBlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	detexDecompressBlockBPTC_SIGNED_FLOAT((uint8_t const *) input, (uint8_t *) output);
+}
+
+AL2O3_EXTERN_C void Image_DecompressETC2BlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	detexDecompressBlockETC2((uint8_t const *) input, output, UNorm8ToHalfTable(), UNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressETC2SRGBBlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	detexDecompressBlockETC2((uint8_t const *) input, output, SRGBToLinearHalfTable(), UNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressETC2PunchThroughBlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	detexDecompressBlockETC2_PUNCHTHROUGH((uint8_t const *) input, output, UNorm8ToHalfTable(), UNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressETC2PunchThroughSRGBBlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	detexDecompressBlockETC2_PUNCHTHROUGH((uint8_t const *) input, output, SRGBToLinearHalfTable(), UNorm8ToHalfTable());
+}
 
-	Image_DecompressDXBC7Block(input, packed);
-	TinyImageFormat_DecodeInput in = {};
-	in.pixel = packed;
-	TinyImageFormat_DecodeLogicalPixelsF(TinyImageFormat_B8G8R8A8_UNORM, &in, 16, output);
+AL2O3_EXTERN_C void Image_DecompressETC2EACBlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	detexDecompressBlockETC2_EAC((uint8_t const *) input, output, UNorm8ToHalfTable(), UNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressETC2EACSRGBBlockH(void const *input, uint16_t output[4 * 4 * 4]) {
+	detexDecompressBlockETC2_EAC((uint8_t const *) input, output, SRGBToLinearHalfTable(), UNorm8ToHalfTable());
+}
+
+AL2O3_EXTERN_C void Image_DecompressEAC11BlockH(void const *input, uint16_t output[4 * 4]) {
+	detexDecompressBlockEAC_R11_F16((uint8_t const *) input, output);
+}
+
+AL2O3_EXTERN_C void Image_DecompressEACSigned11BlockH(void const *input, uint16_t output[4 * 4]) {
+	detexDecompressBlockEAC_SIGNED_R11_F16((uint8_t const *) input, output);
+}
+
+AL2O3_EXTERN_C void Image_DecompressEACDual11BlockH(void const *input, uint16_t output[4 * 4 * 2]) {
+	detexDecompressBlockEAC_RG11_F16((uint8_t const *) input, output);
+}
+
+AL2O3_EXTERN_C void Image_DecompressEACDualSigned11BlockH(void const *input, uint16_t output[4 * 4 * 2]) {
+	detexDecompressBlockEAC_SIGNED_RG11_F16((uint8_t const *) input, output);
 }
 
 static void ReadNxNBlock(Image_ImageHeader const *src,
 												 uint32_t x,
 												 uint32_t y,
+												 uint32_t z,
 												 uint32_t w,
 												 uint32_t maxBlockByteCount,
 												 void *dstBlockData) {
@@ -202,15 +755,22 @@ static void ReadNxNBlock(Image_ImageHeader const *src,
 	ASSERT(blockSize <= maxBlockByteCount);
 	uint8_t *srcData = (uint8_t *) Image_RawDataPtr(src);
 
-	size_t const blockIndex = Image_GetBlockIndex(src, x, y, 0, w);
+	size_t const blockIndex = Image_GetBlockIndex(src, x, y, z, w);
 	uint8_t *const srcPtr = srcData + (blockIndex * blockSize);
 	memcpy(dstBlockData, srcPtr, blockSize);
 }
 
+// specialised per footprint, explicitly instantiated in astcdecompress.cpp
 template<uint32_t blockX, uint32_t blockY, bool isSRGB>
-static void decompressASTC(void const *input, uint8_t *output) {
-	Image_DecompressASTCBlock(input, blockX, blockY, isSRGB, output);
-}
+void decompressASTC(void const *input, uint8_t *output);
+template<uint32_t blockX, uint32_t blockY, bool isSRGB>
+void decompressASTCBlocks(void const *input, uint32_t count, uint8_t *output);
+template<uint32_t blockX, uint32_t blockY>
+void decompressASTCHDR(void const *input, uint8_t *output);
+template<uint32_t blockX, uint32_t blockY, uint32_t blockZ, bool isSRGB>
+void decompressASTC3D(void const *input, uint8_t *output);
+template<uint32_t blockX, uint32_t blockY, uint32_t blockZ>
+void decompressASTCHDR3D(void const *input, uint8_t *output);
 static TinyImageFormat ChooseDstFormatFromCompressedFormat(TinyImageFormat srcFormat) {
 	TinyImageFormat dstFormat = TinyImageFormat_UNDEFINED;
 
@@ -284,14 +844,19 @@ static TinyImageFormat ChooseDstFormatFromCompressedFormat(TinyImageFormat srcFo
 			break;
 
 		case TinyImageFormat_DXBC6H_UFLOAT:
-		case TinyImageFormat_DXBC6H_SFLOAT: break;
+		case TinyImageFormat_DXBC6H_SFLOAT: dstFormat = TinyImageFormat_R16G16B16A16_SFLOAT;
+			break;
 
+		// PVRTC1 is decoded a whole image at a time, see DecompressPVRTC
 		case TinyImageFormat_PVRTC1_2BPP_UNORM:
-		case TinyImageFormat_PVRTC1_4BPP_UNORM:
+		case TinyImageFormat_PVRTC1_4BPP_UNORM: dstFormat = TinyImageFormat_B8G8R8A8_UNORM;
+			break;
+		case TinyImageFormat_PVRTC1_2BPP_SRGB:
+		case TinyImageFormat_PVRTC1_4BPP_SRGB: dstFormat = TinyImageFormat_B8G8R8A8_SRGB;
+			break;
+
 		case TinyImageFormat_PVRTC2_2BPP_UNORM:
 		case TinyImageFormat_PVRTC2_4BPP_UNORM:
-		case TinyImageFormat_PVRTC1_2BPP_SRGB:
-		case TinyImageFormat_PVRTC1_4BPP_SRGB:
 		case TinyImageFormat_PVRTC2_2BPP_SRGB:
 		case TinyImageFormat_PVRTC2_4BPP_SRGB: break;
 
@@ -301,8 +866,114 @@ static TinyImageFormat ChooseDstFormatFromCompressedFormat(TinyImageFormat srcFo
 	return dstFormat;
 }
 typedef void (*decompressFunc)(void const *input, uint8_t output[4 * 4 * sizeof(uint32_t)]);
+// decodes blockCount consecutive blocks into blockCount consecutive decompressed blocks
+typedef void (*decompressStripFunc)(void const *input, uint32_t blockCount, uint8_t *output);
+// writes a row of texelCount decoded texels to the image in another layout
+typedef void (*storeFunc)(uint8_t const *decoded, uint8_t *dst, uint32_t texelCount);
+// premultiplies texelCount decoded texels by their alpha in place
+typedef void (*premultiplyFunc)(uint8_t *decoded, uint32_t texelCount);
+
+// in decompressstore.cpp, nullptr when dstFormat isn't a conversion of decodedFormat
+extern storeFunc ChooseStoreFunction(TinyImageFormat decodedFormat, TinyImageFormat dstFormat);
+extern storeFunc ChoosePremultipliedStoreFunction(TinyImageFormat decodedFormat, TinyImageFormat dstFormat);
+extern premultiplyFunc ChoosePremultiplyFunction(TinyImageFormat decodedFormat);
+extern storeFunc ChooseNormalStoreFunction(TinyImageFormat decodedFormat, TinyImageFormat dstFormat);
+extern storeFunc ChooseChannelStoreFunction(TinyImageFormat decodedFormat, uint32_t channel);
+// in decompressmips.cpp
+extern bool CanReduceMipFormat(TinyImageFormat format);
+extern void ReduceMipRegion(Image_ImageHeader const *src,
+														Image_ImageHeader const *dst,
+														uint32_t x0,
+														uint32_t y0,
+														uint32_t x1,
+														uint32_t y1,
+														uint32_t w);
+
+// decoders for a non default dstFormat, nullptr if the src can't be decoded to it
+static decompressFunc ChooseConvertingDecompressFunction(TinyImageFormat srcFormat, TinyImageFormat dstFormat) {
+	decompressFunc func = nullptr;
+	switch (dstFormat) {
+		// ASTC HDR profile
+		case TinyImageFormat_R16G16B16A16_SFLOAT:
+			switch (srcFormat) {
+				case TinyImageFormat_ASTC_4x4_UNORM: func = decompressASTCHDR<4, 4>;
+					break;
+				case TinyImageFormat_ASTC_5x4_UNORM: func = decompressASTCHDR<5, 4>;
+					break;
+				case TinyImageFormat_ASTC_5x5_UNORM: func = decompressASTCHDR<5, 5>;
+					break;
+				case TinyImageFormat_ASTC_6x5_UNORM: func = decompressASTCHDR<6, 5>;
+					break;
+				case TinyImageFormat_ASTC_6x6_UNORM: func = decompressASTCHDR<6, 6>;
+					break;
+				case TinyImageFormat_ASTC_8x5_UNORM: func = decompressASTCHDR<8, 5>;
+					break;
+				case TinyImageFormat_ASTC_8x6_UNORM: func = decompressASTCHDR<8, 6>;
+					break;
+				case TinyImageFormat_ASTC_8x8_UNORM: func = decompressASTCHDR<8, 8>;
+					break;
+				case TinyImageFormat_ASTC_10x5_UNORM: func = decompressASTCHDR<10, 5>;
+					break;
+				case TinyImageFormat_ASTC_10x6_UNORM: func = decompressASTCHDR<10, 6>;
+					break;
+				case TinyImageFormat_ASTC_10x8_UNORM: func = decompressASTCHDR<10, 8>;
+					break;
+				case TinyImageFormat_ASTC_10x10_UNORM: func = decompressASTCHDR<10, 10>;
+					break;
+				case TinyImageFormat_ASTC_12x10_UNORM: func = decompressASTCHDR<12, 10>;
+					break;
+				case TinyImageFormat_ASTC_12x12_UNORM: func = decompressASTCHDR<12, 12>;
+					break;
+				default: break;
+			}
+			break;
+		// narrow outputs decoded directly, not converted from the default format
+		case TinyImageFormat_B5G6R5_UNORM:
+			switch (srcFormat) {
+				case TinyImageFormat_DXBC1_RGB_UNORM:
+				case TinyImageFormat_DXBC1_RGBA_UNORM: func = DecompressDXBC1BlockTo565;
+					break;
+				default: break;
+			}
+			break;
+		case TinyImageFormat_R8G8B8_UNORM:
+			switch (srcFormat) {
+				case TinyImageFormat_DXBC1_RGB_UNORM:
+				case TinyImageFormat_DXBC1_RGBA_UNORM: func = DecompressDXBC1BlockToRGB8;
+					break;
+				default: break;
+			}
+			break;
+		case TinyImageFormat_R8G8B8_SRGB:
+			switch (srcFormat) {
+				case TinyImageFormat_DXBC1_RGB_SRGB:
+				case TinyImageFormat_DXBC1_RGBA_SRGB: func = DecompressDXBC1BlockToRGB8;
+					break;
+				default: break;
+			}
+			break;
+		case TinyImageFormat_R8_UNORM:
+			func = (srcFormat == TinyImageFormat_ETC2_EAC_R11_UNORM) ? DecompressEAC11BlockTo8 : nullptr;
+			break;
+		case TinyImageFormat_R8_SNORM:
+			func = (srcFormat == TinyImageFormat_ETC2_EAC_R11_SNORM) ? DecompressEACSigned11BlockTo8 : nullptr;
+			break;
+		case TinyImageFormat_R8G8_UNORM:
+			func = (srcFormat == TinyImageFormat_ETC2_EAC_R11G11_UNORM) ? DecompressEACDual11BlockTo8 : nullptr;
+			break;
+		case TinyImageFormat_R8G8_SNORM:
+			func = (srcFormat == TinyImageFormat_ETC2_EAC_R11G11_SNORM) ? DecompressEACDualSigned11BlockTo8 : nullptr;
+			break;
+		default: break;
+	}
+	return func;
+}
+
+static decompressFunc ChooseDecompressFunction(TinyImageFormat srcFormat, TinyImageFormat dstFormat) {
+	if (dstFormat != ChooseDstFormatFromCompressedFormat(srcFormat)) {
+		return ChooseConvertingDecompressFunction(srcFormat, dstFormat);
+	}
 
-static decompressFunc ChooseDecompressFunction(TinyImageFormat srcFormat) {
 	decompressFunc func = nullptr;
 	switch (srcFormat) {
 		case TinyImageFormat_DXBC1_RGB_UNORM:
@@ -316,15 +987,21 @@ static decompressFunc ChooseDecompressFunction(TinyImageFormat srcFormat) {
 		case TinyImageFormat_DXBC3_UNORM:
 		case TinyImageFormat_DXBC3_SRGB: func = Image_DecompressDXBC3Block;
 			break;
-		case TinyImageFormat_DXBC4_UNORM:
-		case TinyImageFormat_DXBC4_SNORM: func = Image_DecompressDXBC4Block;
+		case TinyImageFormat_DXBC4_UNORM: func = Image_DecompressDXBC4Block;
 			break;
-		case TinyImageFormat_DXBC5_UNORM:
-		case TinyImageFormat_DXBC5_SNORM: func = Image_DecompressDXBC5Block;
+		case TinyImageFormat_DXBC4_SNORM: func = Image_DecompressDXBC4SNormBlock;
+			break;
+		case TinyImageFormat_DXBC5_UNORM: func = Image_DecompressDXBC5Block;
+			break;
+		case TinyImageFormat_DXBC5_SNORM: func = Image_DecompressDXBC5SNormBlock;
 			break;
 		case TinyImageFormat_DXBC7_UNORM:
 		case TinyImageFormat_DXBC7_SRGB: func = Image_DecompressDXBC7Block;
 			break;
+		case TinyImageFormat_DXBC6H_UFLOAT: func = Image_DecompressDXBC6HUFloatBlock;
+			break;
+		case TinyImageFormat_DXBC6H_SFLOAT: func = Image_DecompressDXBC6HSFloatBlock;
+			break;
 		case TinyImageFormat_ASTC_4x4_UNORM: func = decompressASTC<4, 4, false>;
 			break;
 		case TinyImageFormat_ASTC_5x4_UNORM: func = decompressASTC<5, 4, false>;
@@ -402,168 +1079,872 @@ static decompressFunc ChooseDecompressFunction(TinyImageFormat srcFormat) {
 	}
 	return func;
 }
-
-AL2O3_EXTERN_C Image_ImageHeader const *Image_Decompress(Image_ImageHeader const *src) {
-	if (src->depth > 1) {
+// multi block decoders for formats whose blocks vary enough to be worth grouping, only to the default dstFormat
+static decompressStripFunc ChooseDecompressStripFunction(TinyImageFormat srcFormat, TinyImageFormat dstFormat) {
+	if (dstFormat != ChooseDstFormatFromCompressedFormat(srcFormat)) {
 		return nullptr;
 	}
 
-	if (!TinyImageFormat_IsCompressed(src->format)) {
-		return src;
+	switch (srcFormat) {
+		case TinyImageFormat_DXBC4_UNORM: return DecompressDXTCAlphaBlocks<false, 1>;
+		case TinyImageFormat_DXBC4_SNORM: return DecompressDXTCAlphaBlocks<true, 1>;
+		case TinyImageFormat_DXBC5_UNORM: return DecompressDXTCAlphaBlocks<false, 2>;
+		case TinyImageFormat_DXBC5_SNORM: return DecompressDXTCAlphaBlocks<true, 2>;
+		case TinyImageFormat_DXBC7_UNORM:
+		case TinyImageFormat_DXBC7_SRGB: return Image_DecompressDXBC7Blocks;
+		case TinyImageFormat_ASTC_4x4_UNORM: return decompressASTCBlocks<4, 4, false>;
+		case TinyImageFormat_ASTC_5x4_UNORM: return decompressASTCBlocks<5, 4, false>;
+		case TinyImageFormat_ASTC_5x5_UNORM: return decompressASTCBlocks<5, 5, false>;
+		case TinyImageFormat_ASTC_6x5_UNORM: return decompressASTCBlocks<6, 5, false>;
+		case TinyImageFormat_ASTC_6x6_UNORM: return decompressASTCBlocks<6, 6, false>;
+		case TinyImageFormat_ASTC_8x5_UNORM: return decompressASTCBlocks<8, 5, false>;
+		case TinyImageFormat_ASTC_8x6_UNORM: return decompressASTCBlocks<8, 6, false>;
+		case TinyImageFormat_ASTC_8x8_UNORM: return decompressASTCBlocks<8, 8, false>;
+		case TinyImageFormat_ASTC_10x5_UNORM: return decompressASTCBlocks<10, 5, false>;
+		case TinyImageFormat_ASTC_10x6_UNORM: return decompressASTCBlocks<10, 6, false>;
+		case TinyImageFormat_ASTC_10x8_UNORM: return decompressASTCBlocks<10, 8, false>;
+		case TinyImageFormat_ASTC_10x10_UNORM: return decompressASTCBlocks<10, 10, false>;
+		case TinyImageFormat_ASTC_12x10_UNORM: return decompressASTCBlocks<12, 10, false>;
+		case TinyImageFormat_ASTC_12x12_UNORM: return decompressASTCBlocks<12, 12, false>;
+		case TinyImageFormat_ASTC_4x4_SRGB: return decompressASTCBlocks<4, 4, true>;
+		case TinyImageFormat_ASTC_5x4_SRGB: return decompressASTCBlocks<5, 4, true>;
+		case TinyImageFormat_ASTC_5x5_SRGB: return decompressASTCBlocks<5, 5, true>;
+		case TinyImageFormat_ASTC_6x5_SRGB: return decompressASTCBlocks<6, 5, true>;
+		case TinyImageFormat_ASTC_6x6_SRGB: return decompressASTCBlocks<6, 6, true>;
+		case TinyImageFormat_ASTC_8x5_SRGB: return decompressASTCBlocks<8, 5, true>;
+		case TinyImageFormat_ASTC_8x6_SRGB: return decompressASTCBlocks<8, 6, true>;
+		case TinyImageFormat_ASTC_8x8_SRGB: return decompressASTCBlocks<8, 8, true>;
+		case TinyImageFormat_ASTC_10x5_SRGB: return decompressASTCBlocks<10, 5, true>;
+		case TinyImageFormat_ASTC_10x6_SRGB: return decompressASTCBlocks<10, 6, true>;
+		case TinyImageFormat_ASTC_10x8_SRGB: return decompressASTCBlocks<10, 8, true>;
+		case TinyImageFormat_ASTC_10x10_SRGB: return decompressASTCBlocks<10, 10, true>;
+		case TinyImageFormat_ASTC_12x10_SRGB: return decompressASTCBlocks<12, 10, true>;
+		case TinyImageFormat_ASTC_12x12_SRGB: return decompressASTCBlocks<12, 12, true>;
+		default: return nullptr;
 	}
+}
+// 3D ASTC has no TinyImageFormat so is picked by footprint and dstFormat
+static decompressFunc ChooseASTC3DDecompressFunction(uint32_t blockWidth,
+																										 uint32_t blockHeight,
+																										 uint32_t blockDepth,
+																										 TinyImageFormat dstFormat) {
+#define ASTC_3D_CASE(x, y, z) \
+	case (x << 16) | (y << 8) | z: \
+		switch (dstFormat) { \
+			case TinyImageFormat_B8G8R8A8_UNORM: return decompressASTC3D<x, y, z, false>; \
+			case TinyImageFormat_B8G8R8A8_SRGB: return decompressASTC3D<x, y, z, true>; \
+			case TinyImageFormat_R16G16B16A16_SFLOAT: return decompressASTCHDR3D<x, y, z>; \
+			default: return nullptr; \
+		}
 
-	bool const sRGB = TinyImageFormat_IsSRGB(src->format);
+	switch ((blockWidth << 16) | (blockHeight << 8) | blockDepth) {
+		ASTC_3D_CASE(3, 3, 3)
+		ASTC_3D_CASE(4, 3, 3)
+		ASTC_3D_CASE(4, 4, 3)
+		ASTC_3D_CASE(4, 4, 4)
+		ASTC_3D_CASE(5, 4, 4)
+		ASTC_3D_CASE(5, 5, 4)
+		ASTC_3D_CASE(5, 5, 5)
+		ASTC_3D_CASE(6, 5, 5)
+		ASTC_3D_CASE(6, 6, 5)
+		ASTC_3D_CASE(6, 6, 6)
+		default: return nullptr;
+	}
+#undef ASTC_3D_CASE
+}
 
-	auto dstFormat = ChooseDstFormatFromCompressedFormat(src->format);
-	auto func = ChooseDecompressFunction(src->format);
+// everything needed to decompress any range of an image's blocks. Blocks are indexed x fastest then y, z and
+// slice, so a range spans depth as well as rows and volumes split across workers like 2D images do
+struct DecompressJob {
+	Image_ImageHeader const *src; // null when srcData is raw tightly packed blocks (3D ASTC)
+	uint8_t const *srcData;
+	Image_ImageHeader const *dst;
+	decompressFunc func;
+	decompressStripFunc stripFunc; // when set, used instead of func a strip of blocks at a time
+	storeFunc store; // when set, converts the decoded texels into dst's format, otherwise they are copied
+	premultiplyFunc premultiply; // when set, applied to the decoded texels before they are stored
+	uint32_t decodedTexelSize;
+	uint32_t srcBlockSize;
+	uint32_t blockWidth;
+	uint32_t blockHeight;
+	uint32_t blockDepth;
+	uint32_t blocksX;
+	uint32_t blocksY;
+	uint32_t blocksZ;
+};
 
-	if(dstFormat == TinyImageFormat_UNDEFINED) {
-		return nullptr;
+static uint32_t DecompressJobBlockCount(DecompressJob const *job, uint32_t slices) {
+	return job->blocksX * job->blocksY * job->blocksZ * slices;
+}
+
+static DecompressJob MakeDecompressJob(Image_ImageHeader const *src,
+																			 uint8_t const *srcData,
+																			 Image_ImageHeader const *dst,
+																			 decompressFunc func,
+																			 uint32_t srcBlockSize,
+																			 uint32_t blockWidth,
+																			 uint32_t blockHeight,
+																			 uint32_t blockDepth) {
+	DecompressJob job;
+	job.src = src;
+	job.srcData = srcData;
+	job.dst = dst;
+	job.func = func;
+	job.stripFunc = nullptr;
+	job.store = nullptr;
+	job.premultiply = nullptr;
+	job.decodedTexelSize = TinyImageFormat_BitSizeOfBlock(dst->format) / 8;
+	job.srcBlockSize = srcBlockSize;
+	job.blockWidth = blockWidth;
+	job.blockHeight = blockHeight;
+	job.blockDepth = blockDepth;
+	// get block counts rounding up
+	job.blocksX = (dst->width + blockWidth - 1) / blockWidth;
+	job.blocksY = (dst->height + blockHeight - 1) / blockHeight;
+	job.blocksZ = (dst->depth + blockDepth - 1) / blockDepth;
+	return job;
+}
+
+static void ReadCompressedBlock(DecompressJob const *job, uint32_t b, uint8_t *compressedBlock) {
+	if (job->src) {
+		uint32_t const x = b % job->blocksX;
+		uint32_t const y = (b / job->blocksX) % job->blocksY;
+		uint32_t const z = (b / (job->blocksX * job->blocksY)) % job->blocksZ;
+		uint32_t const w = b / (job->blocksX * job->blocksY * job->blocksZ);
+		ReadNxNBlock(job->src, x * job->blockWidth, y * job->blockHeight, z * job->blockDepth, w, job->srcBlockSize,
+								 compressedBlock);
+	} else {
+		memcpy(compressedBlock, job->srcData + (size_t) b * job->srcBlockSize, job->srcBlockSize);
 	}
+}
 
-	if(func == nullptr) {
-		return nullptr;
+static void WriteDecompressedBlock(DecompressJob const *job, uint32_t b, uint8_t const *uncompressedBlock) {
+	Image_ImageHeader const *dst = job->dst;
+
+	uint32_t const dstSize = TinyImageFormat_BitSizeOfBlock(dst->format) / 8;
+	uint32_t const decodedPitch = job->blockWidth * job->decodedTexelSize;
+	uint8_t *rawData = (uint8_t *) Image_RawDataPtr(dst);
+
+	uint32_t const x = b % job->blocksX;
+	uint32_t const y = (b / job->blocksX) % job->blocksY;
+	uint32_t const z = (b / (job->blocksX * job->blocksY)) % job->blocksZ;
+	uint32_t const w = b / (job->blocksX * job->blocksY * job->blocksZ);
+
+	uint32_t const sx = x * job->blockWidth;
+	uint32_t const sy = y * job->blockHeight;
+	uint32_t const sz = z * job->blockDepth;
+
+	// edge blocks overhang the image, only copy the texels inside it
+	uint32_t const copyWidth = (dst->width - sx < job->blockWidth) ? dst->width - sx : job->blockWidth;
+	uint32_t const copyHeight = (dst->height - sy < job->blockHeight) ? dst->height - sy : job->blockHeight;
+	uint32_t const copyDepth = (dst->depth - sz < job->blockDepth) ? dst->depth - sz : job->blockDepth;
+
+	for (uint32_t dz = 0; dz < copyDepth; ++dz) {
+		uint8_t const *ub = uncompressedBlock + (dz * job->blockHeight * decodedPitch);
+		for (uint32_t dy = 0; dy < copyHeight; ++dy) {
+			uint8_t *dstPtr = rawData + (Image_CalculateIndex(dst, sx, sy + dy, sz + dz, w) * dstSize);
+
+			if (job->store) {
+				job->store(ub, dstPtr, copyWidth);
+			} else {
+				memcpy(dstPtr, ub, copyWidth * dstSize);
+			}
+			ub += decodedPitch;
+		}
 	}
+}
 
-	Image_ImageHeader const *dst = Image_CreateNoClear(src->width, src->height, 1, src->slices, dstFormat);
-	if (!dst) {
-		return nullptr;
+// blocks handed to a strip function at once, fewer when the decoded strip would need more than
+// DecompressStripMaxBytes of stack (256 12x12 ASTC blocks are 144KB of BGRA8)
+static uint32_t const DecompressStripBlockCount = 256;
+static uint32_t const DecompressStripMaxBytes = 32 * 1024;
+
+static void DecompressBlockStrips(DecompressJob const *job, uint32_t start, uint32_t end) {
+	uint32_t const uncompressedBlockSize = job->blockWidth * job->blockHeight * job->blockDepth * job->decodedTexelSize;
+	uint32_t const maxStripBlocks = DecompressStripMaxBytes / uncompressedBlockSize;
+	uint32_t const stripBlockCount = (maxStripBlocks < DecompressStripBlockCount) ? maxStripBlocks : DecompressStripBlockCount;
+
+	uint8_t *compressedStrip = (uint8_t *) STACK_ALLOC(stripBlockCount * job->srcBlockSize);
+	uint8_t *uncompressedStrip = (uint8_t *) STACK_ALLOC(stripBlockCount * uncompressedBlockSize);
+
+	for (uint32_t b = start; b < end; b += stripBlockCount) {
+		uint32_t const count = (end - b < stripBlockCount) ? end - b : stripBlockCount;
+		for (uint32_t i = 0; i < count; ++i) {
+			ReadCompressedBlock(job, b + i, compressedStrip + i * job->srcBlockSize);
+		}
+
+		job->stripFunc(compressedStrip, count, uncompressedStrip);
+		if (job->premultiply) {
+			job->premultiply(uncompressedStrip, count * job->blockWidth * job->blockHeight * job->blockDepth);
+		}
+
+		for (uint32_t i = 0; i < count; ++i) {
+			WriteDecompressedBlock(job, b + i, uncompressedStrip + i * uncompressedBlockSize);
+		}
 	}
+}
 
-	// get block size round up to 4
-	size_t const blocksX =
-			(src->width + TinyImageFormat_WidthOfBlock(src->format) - 1) / TinyImageFormat_WidthOfBlock(src->format);
-	size_t const blocksY =
-			(src->height + TinyImageFormat_HeightOfBlock(src->format) - 1) / TinyImageFormat_HeightOfBlock(src->format);
+static void DecompressBlocks(DecompressJob const *job, uint32_t start, uint32_t end) {
+	if (job->stripFunc) {
+		DecompressBlockStrips(job, start, end);
+		return;
+	}
 
+	uint8_t *compressedBlock = (uint8_t *) STACK_ALLOC(job->srcBlockSize);
 	uint8_t uncompressedBlock[TinyImageFormat_MaxPixelCountOfBlock * 4 * sizeof(float)];
 
-	uint8_t *rawData = (uint8_t *) Image_RawDataPtr(dst);
+	for (uint32_t b = start; b < end; ++b) {
+		ReadCompressedBlock(job, b, compressedBlock);
+		job->func(compressedBlock, uncompressedBlock);
+		if (job->premultiply) {
+			job->premultiply(uncompressedBlock, job->blockWidth * job->blockHeight * job->blockDepth);
+		}
+		WriteDecompressedBlock(job, b, uncompressedBlock);
+	}
+}
 
-	uint32_t const srcSize = TinyImageFormat_BitSizeOfBlock(src->format) / 8;
-	uint32_t const dstSize = TinyImageFormat_BitSizeOfBlock(dst->format) / 8;
-	uint32_t const dstPitch = TinyImageFormat_WidthOfBlock(src->format) * dstSize;
+void EnkiDecompressBlockFunc(uint32_t start, uint32_t end, uint32_t threadnum, void *pArgs) {
+	(void) threadnum;
+	DecompressBlocks((DecompressJob const *) pArgs, start, end);
+}
+
+static void DecompressJobWithEnki(DecompressJob const *job, uint32_t slices, enkiTaskSchedulerHandle taskScheduler) {
+	auto taskSet = enkiCreateTaskSet(taskScheduler, &EnkiDecompressBlockFunc);
+
+	enkiAddTaskSetToPipeMinRange(taskScheduler, taskSet, (void *) job, DecompressJobBlockCount(job, slices), 10);
 
-	uint8_t *compressedBlock = (uint8_t *) STACK_ALLOC(srcSize);
+	enkiWaitForTaskSet(taskScheduler, taskSet);
+	enkiDeleteTaskSet(taskSet);
+}
 
-	for (uint32_t w = 0; w < src->slices; ++w) {
-		for (uint32_t y = 0; y < blocksY; ++y) {
-			for (uint32_t x = 0; x < blocksX; ++x) {
+// what the decoded texels become as they are stored
+enum DecompressMode {
+	DecompressModeDefault,
+	DecompressModePremultiplied,
+	DecompressModeNormalMap, // X and Y channels to an XYZ normal
+	// a single channel to R8, in TinyImageFormat_LogicalChannel order
+	DecompressModeRed,
+	DecompressModeGreen,
+	DecompressModeBlue,
+	DecompressModeAlpha,
+};
 
-				uint32_t const sx = x * TinyImageFormat_WidthOfBlock(src->format);
-				uint32_t const sy = y * TinyImageFormat_HeightOfBlock(src->format);
+// formats that store alpha apart from colour (or not at all) decode it alone, nullptr otherwise
+static decompressFunc ChooseAlphaDecompressFunction(TinyImageFormat srcFormat) {
+	switch (srcFormat) {
+		case TinyImageFormat_DXBC1_RGB_UNORM:
+		case TinyImageFormat_DXBC1_RGB_SRGB:
+		case TinyImageFormat_DXBC1_RGBA_UNORM:
+		case TinyImageFormat_DXBC1_RGBA_SRGB: return DecompressDXBC1AlphaBlock;
+		case TinyImageFormat_DXBC2_UNORM:
+		case TinyImageFormat_DXBC2_SRGB: return DecompressDXBC2AlphaBlock;
+		case TinyImageFormat_DXBC3_UNORM:
+		case TinyImageFormat_DXBC3_SRGB: return DecompressDXBC3AlphaBlock;
+		case TinyImageFormat_ETC2_R8G8B8A8_UNORM:
+		case TinyImageFormat_ETC2_R8G8B8A8_SRGB: return DecompressETC2EACAlphaBlock;
+		case TinyImageFormat_ETC2_R8G8B8_UNORM:
+		case TinyImageFormat_ETC2_R8G8B8_SRGB: return DecompressOpaqueAlphaBlock;
+		default: return nullptr;
+	}
+}
 
-				ReadNxNBlock(src, sx, sy, w, srcSize, compressedBlock);
+// BC4, BC5 and EAC R11/RG11 decode the channel alone straight to R8_UNORM (R8_SNORM if signed), nullptr for other
+// formats and for channels they don't store
+static decompressFunc ChooseRedGreenChannelDecompressFunction(TinyImageFormat srcFormat,
+																															uint32_t channel,
+																															decompressStripFunc *stripFunc,
+																															TinyImageFormat *dstFormat) {
+	*dstFormat = TinyImageFormat_R8_UNORM;
+	if (channel == TinyImageFormat_LC_Red) {
+		switch (srcFormat) {
+			case TinyImageFormat_DXBC4_UNORM: *stripFunc = DecompressDXTCAlphaBlocks<false, 1>;
+				return Image_DecompressDXBC4Block;
+			case TinyImageFormat_DXBC5_UNORM: *stripFunc = DecompressDXTCAlphaBlocks<false, 1, 2>;
+				return DecompressDXBC5ChannelBlock<false, 0>;
+			case TinyImageFormat_ETC2_EAC_R11_UNORM:
+			case TinyImageFormat_ETC2_EAC_R11G11_UNORM: return DecompressEAC11BlockTo8;
+			default: break;
+		}
+		*dstFormat = TinyImageFormat_R8_SNORM;
+		switch (srcFormat) {
+			case TinyImageFormat_DXBC4_SNORM: *stripFunc = DecompressDXTCAlphaBlocks<true, 1>;
+				return Image_DecompressDXBC4SNormBlock;
+			case TinyImageFormat_DXBC5_SNORM: *stripFunc = DecompressDXTCAlphaBlocks<true, 1, 2>;
+				return DecompressDXBC5ChannelBlock<true, 0>;
+			case TinyImageFormat_ETC2_EAC_R11_SNORM:
+			case TinyImageFormat_ETC2_EAC_R11G11_SNORM: return DecompressEACSigned11BlockTo8;
+			default: break;
+		}
+	} else if (channel == TinyImageFormat_LC_Green) {
+		switch (srcFormat) {
+			case TinyImageFormat_DXBC5_UNORM: *stripFunc = DecompressDXTCAlphaBlocks<false, 1, 2, 1>;
+				return DecompressDXBC5ChannelBlock<false, 1>;
+			case TinyImageFormat_ETC2_EAC_R11G11_UNORM: return DecompressEACDual11GreenBlockTo8;
+			default: break;
+		}
+		*dstFormat = TinyImageFormat_R8_SNORM;
+		switch (srcFormat) {
+			case TinyImageFormat_DXBC5_SNORM: *stripFunc = DecompressDXTCAlphaBlocks<true, 1, 2, 1>;
+				return DecompressDXBC5ChannelBlock<true, 1>;
+			case TinyImageFormat_ETC2_EAC_R11G11_SNORM: return DecompressEACDualSigned11GreenBlockTo8;
+			default: break;
+		}
+	}
+	return nullptr;
+}
 
-				func(compressedBlock, uncompressedBlock);
+// 1 and 2 channel formats, which have no 8 bit RGBA decode to pick a channel from
+static bool IsRedGreenFormat(TinyImageFormat srcFormat) {
+	switch (srcFormat) {
+		case TinyImageFormat_DXBC4_UNORM:
+		case TinyImageFormat_DXBC4_SNORM:
+		case TinyImageFormat_DXBC5_UNORM:
+		case TinyImageFormat_DXBC5_SNORM:
+		case TinyImageFormat_ETC2_EAC_R11_UNORM:
+		case TinyImageFormat_ETC2_EAC_R11_SNORM:
+		case TinyImageFormat_ETC2_EAC_R11G11_UNORM:
+		case TinyImageFormat_ETC2_EAC_R11G11_SNORM: return true;
+		default: return false;
+	}
+}
 
-				uint8_t const *ub = (uint8_t const *) uncompressedBlock;
-				for (uint32_t dy = 0; dy < TinyImageFormat_HeightOfBlock(src->format); ++dy) {
-					uint8_t *dstPtr = rawData + (Image_CalculateIndex(dst,
-																														sx, sy + dy, 0, w) * dstSize);
+// one channel to R8 (R8_SRGB for the colour of sRGB formats). Alpha that has its own block and the channels of
+// 1 and 2 channel formats are decoded alone, anything else is decoded in full and the channel picked out as it is
+// stored
+static Image_ImageHeader const *CreateChannelDecompressJob(Image_ImageHeader const *src,
+																													 uint32_t channel,
+																													 DecompressJob *job) {
+	auto const decodedFormat = ChooseDstFormatFromCompressedFormat(src->format);
+	bool const isAlpha = (channel == TinyImageFormat_LC_Alpha);
+	auto dstFormat = (!isAlpha && decodedFormat == TinyImageFormat_B8G8R8A8_SRGB) ?
+			TinyImageFormat_R8_SRGB : TinyImageFormat_R8_UNORM;
 
-					memcpy(dstPtr, ub, dstPitch);
-					ub += dstPitch;;
-				}
+	decompressFunc func = nullptr;
+	decompressStripFunc stripFunc = nullptr;
+	storeFunc store = nullptr;
+	if (IsRedGreenFormat(src->format)) {
+		func = ChooseRedGreenChannelDecompressFunction(src->format, channel, &stripFunc, &dstFormat);
+	} else {
+		func = isAlpha ? ChooseAlphaDecompressFunction(src->format) : nullptr;
+		if (func == nullptr) {
+			store = ChooseChannelStoreFunction(decodedFormat, channel);
+			if (store == nullptr) {
+				return nullptr;
 			}
+			func = ChooseDecompressFunction(src->format, decodedFormat);
+			stripFunc = ChooseDecompressStripFunction(src->format, decodedFormat);
+		} else if (src->format == TinyImageFormat_DXBC3_UNORM || src->format == TinyImageFormat_DXBC3_SRGB) {
+			stripFunc = DecompressDXTCAlphaBlocks<false, 1, 2>;
 		}
 	}
+
+	if (func == nullptr) {
+		return nullptr;
+	}
+
+	Image_ImageHeader const *dst = Image_CreateNoClear(src->width, src->height, src->depth, src->slices, dstFormat);
+	if (!dst) {
+		return nullptr;
+	}
+
+	*job = MakeDecompressJob(src,
+													 (uint8_t const *) Image_RawDataPtr(src),
+													 dst,
+													 func,
+													 TinyImageFormat_BitSizeOfBlock(src->format) / 8,
+													 TinyImageFormat_WidthOfBlock(src->format),
+													 TinyImageFormat_HeightOfBlock(src->format),
+													 1);
+	job->stripFunc = stripFunc;
+	if (store) {
+		job->store = store;
+		job->decodedTexelSize = TinyImageFormat_BitSizeOfBlock(decodedFormat) / 8;
+	}
 	return dst;
 }
-struct EnkiDecompressParameterBlock {
-	Image_ImageHeader const * src;
-	Image_ImageHeader const * dst;
-	decompressFunc func;
-	uint32_t w;
+
+// 2 channel formats and DXT5nm (BC3 with X in alpha and Y in green)
+static bool IsNormalMapFormat(TinyImageFormat srcFormat) {
+	switch (srcFormat) {
+		case TinyImageFormat_DXBC3_UNORM:
+		case TinyImageFormat_DXBC5_UNORM:
+		case TinyImageFormat_DXBC5_SNORM:
+		case TinyImageFormat_ETC2_EAC_R11G11_UNORM:
+		case TinyImageFormat_ETC2_EAC_R11G11_SNORM: return true;
+		default: return false;
+	}
+}
+
+// the format a converting job decodes to before its store. Floats come from the halves of a half kernel (ASTC
+// UNORM through the HDR profile, as BC6H) rather than from 8 bit texels
+static TinyImageFormat ChooseDecodedFormat(TinyImageFormat srcFormat, TinyImageFormat dstFormat) {
+	if (dstFormat == TinyImageFormat_R32G32B32A32_SFLOAT &&
+			ChooseConvertingDecompressFunction(srcFormat, TinyImageFormat_R16G16B16A16_SFLOAT) != nullptr) {
+		return TinyImageFormat_R16G16B16A16_SFLOAT;
+	}
+	return ChooseDstFormatFromCompressedFormat(srcFormat);
+}
+
+static Image_ImageHeader const *CreateDecompressJob(Image_ImageHeader const *src,
+																										TinyImageFormat requestedFormat,
+																										DecompressMode mode,
+																										DecompressJob *job) {
+	if (mode >= DecompressModeRed) {
+		return CreateChannelDecompressJob(src, (uint32_t) (mode - DecompressModeRed), job);
+	}
+
+	auto dstFormat = (requestedFormat == TinyImageFormat_UNDEFINED) ?
+			ChooseDstFormatFromCompressedFormat(src->format) : requestedFormat;
+	auto func = (mode == DecompressModeNormalMap) ? nullptr : ChooseDecompressFunction(src->format, dstFormat);
+
+	// no kernel for dstFormat, decode to the default format and convert each block as it is stored
+	auto decodedFormat = dstFormat;
+	storeFunc store = nullptr;
+	bool premultipliedByStore = false;
+	if (func == nullptr) {
+		decodedFormat = (mode == DecompressModeNormalMap) ?
+				ChooseDstFormatFromCompressedFormat(src->format) : ChooseDecodedFormat(src->format, dstFormat);
+		if (mode == DecompressModeNormalMap) {
+			store = IsNormalMapFormat(src->format) ? ChooseNormalStoreFunction(decodedFormat, dstFormat) : nullptr;
+		} else {
+			if (mode == DecompressModePremultiplied) {
+				store = ChoosePremultipliedStoreFunction(decodedFormat, dstFormat);
+				premultipliedByStore = (store != nullptr);
+			}
+			if (store == nullptr) {
+				store = ChooseStoreFunction(decodedFormat, dstFormat);
+			}
+		}
+		if (store) {
+			func = ChooseDecompressFunction(src->format, decodedFormat);
+		}
+	}
+
+	if(dstFormat == TinyImageFormat_UNDEFINED) {
+		return nullptr;
+	}
+
+	if(func == nullptr) {
+		return nullptr;
+	}
+
+	// 2D block formats with depth are a compressed image per depth slice
+	Image_ImageHeader const *dst = Image_CreateNoClear(src->width, src->height, src->depth, src->slices, dstFormat);
+	if (!dst) {
+		return nullptr;
+	}
+
+	*job = MakeDecompressJob(src,
+													 (uint8_t const *) Image_RawDataPtr(src),
+													 dst,
+													 func,
+													 TinyImageFormat_BitSizeOfBlock(src->format) / 8,
+													 TinyImageFormat_WidthOfBlock(src->format),
+													 TinyImageFormat_HeightOfBlock(src->format),
+													 1);
+	job->stripFunc = ChooseDecompressStripFunction(src->format, decodedFormat);
+	if (store) {
+		job->store = store;
+		job->decodedTexelSize = TinyImageFormat_BitSizeOfBlock(decodedFormat) / 8;
+	}
+	if (mode == DecompressModePremultiplied && !premultipliedByStore) {
+		job->premultiply = ChoosePremultiplyFunction(decodedFormat);
+	}
+	return dst;
+}
+
+struct PVRTCDecompressJob {
+	Image_ImageHeader const *src;
+	Image_ImageHeader const *dst;
+	premultiplyFunc premultiply;
 };
 
-void EnkiDecompressBlockFunc(uint32_t start, uint32_t end, uint32_t threadnum, void* pArgs) {
-	auto paramBlock = (EnkiDecompressParameterBlock const*) pArgs;
-	Image_ImageHeader const * src = paramBlock->src;
-	Image_ImageHeader const * dst = paramBlock->dst;
-	decompressFunc func = paramBlock->func;
-	uint32_t w = paramBlock->w;
+// PVRTC texels depend on neighbouring blocks so the unit of work is a row of blocks not a block
+static Image_ImageHeader const *CreatePVRTCDecompressJob(Image_ImageHeader const *src,
+																												 TinyImageFormat requestedFormat,
+																												 DecompressMode mode,
+																												 PVRTCDecompressJob *job) {
+	auto dstFormat = ChooseDstFormatFromCompressedFormat(src->format);
+	if ((mode != DecompressModeDefault && mode != DecompressModePremultiplied) ||
+			(requestedFormat != TinyImageFormat_UNDEFINED && requestedFormat != dstFormat)) {
+		return nullptr;
+	}
 
-	uint32_t const srcSize = TinyImageFormat_BitSizeOfBlock(src->format) / 8;
-	uint32_t const dstSize = TinyImageFormat_BitSizeOfBlock(dst->format) / 8;
-	uint32_t const dstPitch = TinyImageFormat_WidthOfBlock(src->format) * dstSize;
+	Image_ImageHeader const *dst = Image_CreateNoClear(src->width, src->height, src->depth, src->slices, dstFormat);
+	if (!dst) {
+		return nullptr;
+	}
 
-	uint8_t *compressedBlock = (uint8_t *) STACK_ALLOC(srcSize);
-	uint8_t uncompressedBlock[TinyImageFormat_MaxPixelCountOfBlock * 4 * sizeof(float)];
+	job->src = src;
+	job->dst = dst;
+	job->premultiply = (mode == DecompressModePremultiplied) ? ChoosePremultiplyFunction(dstFormat) : nullptr;
+	return dst;
+}
+
+// window row r of depth slice r / blocksY outputs the texel rows between the centres of block rows
+// r % blocksY and the one below it (wrapping), only the band that decoded a texel row premultiplies it
+static void DecompressPVRTCRows(PVRTCDecompressJob const *job, uint32_t start, uint32_t end) {
+	DecompressPVRTCWindowRows(job->src, job->dst, start, end);
+	if (!job->premultiply) {
+		return;
+	}
 
-	// get block size round up to 4
-	size_t const blocksX =
-			(src->width + TinyImageFormat_WidthOfBlock(src->format) - 1) / TinyImageFormat_WidthOfBlock(src->format);
-	size_t const blocksY =
-			(src->height + TinyImageFormat_HeightOfBlock(src->format) - 1) / TinyImageFormat_HeightOfBlock(src->format);
+	Image_ImageHeader const *dst = job->dst;
 	uint8_t *rawData = (uint8_t *) Image_RawDataPtr(dst);
+	uint32_t const blocksY = (dst->height + 3) / 4;
+	uint32_t const imageHeight = blocksY * 4;
+	for (uint32_t r = start; r < end; ++r) {
+		uint32_t const plane = r / blocksY;
+		for (uint32_t y = 0; y < 4; ++y) {
+			uint32_t const py = ((r % blocksY) * 4 + 2 + y) % imageHeight;
+			if (py >= dst->height) {
+				continue;
+			}
+			size_t const index = Image_CalculateIndex(dst, 0, py, plane % dst->depth, plane / dst->depth);
+			job->premultiply(rawData + index * sizeof(uint32_t), dst->width);
+		}
+	}
+}
 
-	for (uint32_t b = start; b < end; ++b) {
-		uint32_t x = b % blocksX;
-		uint32_t y = b / blocksY;
+void EnkiDecompressPVRTCFunc(uint32_t start, uint32_t end, uint32_t threadnum, void *pArgs) {
+	(void) threadnum;
+	DecompressPVRTCRows((PVRTCDecompressJob const *) pArgs, start, end);
+}
+
+static Image_ImageHeader const *DecompressPVRTC(Image_ImageHeader const *src,
+																								TinyImageFormat requestedFormat,
+																								DecompressMode mode,
+																								enkiTaskSchedulerHandle taskScheduler) {
+	PVRTCDecompressJob job;
+	Image_ImageHeader const *dst = CreatePVRTCDecompressJob(src, requestedFormat, mode, &job);
+	if (!dst) {
+		return nullptr;
+	}
 
-		uint32_t const sx = x * TinyImageFormat_WidthOfBlock(src->format);
-		uint32_t const sy = y * TinyImageFormat_HeightOfBlock(src->format);
+	if (taskScheduler) {
+		// each band decodes one extra block row to prime its window
+		auto taskSet = enkiCreateTaskSet(taskScheduler, &EnkiDecompressPVRTCFunc);
+		enkiAddTaskSetToPipeMinRange(taskScheduler, taskSet, &job, PVRTCWindowRowCount(src), 8);
+		enkiWaitForTaskSet(taskScheduler, taskSet);
+		enkiDeleteTaskSet(taskSet);
+	} else {
+		DecompressPVRTCRows(&job, 0, PVRTCWindowRowCount(src));
+	}
+	return dst;
+}
 
-		ReadNxNBlock(src, sx, sy, w, srcSize, compressedBlock);
+// taskScheduler may be null to decode on the calling thread
+static Image_ImageHeader const *DecompressImage(Image_ImageHeader const *src,
+																								TinyImageFormat requestedFormat,
+																								DecompressMode mode,
+																								enkiTaskSchedulerHandle taskScheduler) {
+	if (IsPVRTC1Format(src->format)) {
+		return DecompressPVRTC(src, requestedFormat, mode, taskScheduler);
+	}
+
+	DecompressJob job;
+	Image_ImageHeader const *dst = CreateDecompressJob(src, requestedFormat, mode, &job);
+	if (!dst) {
+		return nullptr;
+	}
 
-		func(compressedBlock, uncompressedBlock);
+	if (taskScheduler) {
+		DecompressJobWithEnki(&job, src->slices, taskScheduler);
+	} else {
+		DecompressBlocks(&job, 0, DecompressJobBlockCount(&job, src->slices));
+	}
+	return dst;
+}
 
-		uint8_t const *ub = (uint8_t const *) uncompressedBlock;
-		for (uint32_t dy = 0; dy < TinyImageFormat_HeightOfBlock(src->format); ++dy) {
-			uint8_t *dstPtr = rawData + (Image_CalculateIndex(dst,
-																												sx, sy + dy, 0, w) * dstSize);
+AL2O3_EXTERN_C Image_ImageHeader const *Image_Decompress(Image_ImageHeader const *src) {
+	return Image_DecompressTo(src, TinyImageFormat_UNDEFINED);
+}
 
-			memcpy(dstPtr, ub, dstPitch);
-			ub += dstPitch;;
-		}
+AL2O3_EXTERN_C Image_ImageHeader const *Image_DecompressTo(Image_ImageHeader const *src, TinyImageFormat requestedFormat) {
+	if (!TinyImageFormat_IsCompressed(src->format)) {
+		return (requestedFormat == TinyImageFormat_UNDEFINED || requestedFormat == src->format) ? src : nullptr;
 	}
+	return DecompressImage(src, requestedFormat, DecompressModeDefault, nullptr);
 }
 
 AL2O3_EXTERN_C Image_ImageHeader const *ImageDecompressWithEnki(Image_ImageHeader const *src, enkiTaskSchedulerHandle taskScheduler) {
-	if (src->depth > 1) {
+	return ImageDecompressToWithEnki(src, TinyImageFormat_UNDEFINED, taskScheduler);
+}
+
+AL2O3_EXTERN_C Image_ImageHeader const *ImageDecompressToWithEnki(Image_ImageHeader const *src,
+																																	TinyImageFormat requestedFormat,
+																																	enkiTaskSchedulerHandle taskScheduler) {
+	if (!TinyImageFormat_IsCompressed(src->format)) {
+		return (requestedFormat == TinyImageFormat_UNDEFINED || requestedFormat == src->format) ? src : nullptr;
+	}
+	return DecompressImage(src, requestedFormat, DecompressModeDefault, taskScheduler);
+}
+
+AL2O3_EXTERN_C Image_ImageHeader const *Image_DecompressToPremultiplied(Image_ImageHeader const *src,
+																																				TinyImageFormat requestedFormat) {
+	if (!TinyImageFormat_IsCompressed(src->format)) {
+		return nullptr;
+	}
+	return DecompressImage(src, requestedFormat, DecompressModePremultiplied, nullptr);
+}
+
+AL2O3_EXTERN_C Image_ImageHeader const *ImageDecompressToPremultipliedWithEnki(Image_ImageHeader const *src,
+																																							 TinyImageFormat requestedFormat,
+																																							 enkiTaskSchedulerHandle taskScheduler) {
+	if (!TinyImageFormat_IsCompressed(src->format)) {
+		return nullptr;
+	}
+	return DecompressImage(src, requestedFormat, DecompressModePremultiplied, taskScheduler);
+}
+
+AL2O3_EXTERN_C Image_ImageHeader const *Image_DecompressNormalMap(Image_ImageHeader const *src, TinyImageFormat dstFormat) {
+	if (!TinyImageFormat_IsCompressed(src->format)) {
 		return nullptr;
 	}
+	return DecompressImage(src, dstFormat, DecompressModeNormalMap, nullptr);
+}
 
+AL2O3_EXTERN_C Image_ImageHeader const *ImageDecompressNormalMapWithEnki(Image_ImageHeader const *src,
+																																				 TinyImageFormat dstFormat,
+																																				 enkiTaskSchedulerHandle taskScheduler) {
 	if (!TinyImageFormat_IsCompressed(src->format)) {
-		return src;
+		return nullptr;
 	}
+	return DecompressImage(src, dstFormat, DecompressModeNormalMap, taskScheduler);
+}
 
-	bool const sRGB = TinyImageFormat_IsSRGB(src->format);
+static bool ChannelDecompressMode(TinyImageFormat_LogicalChannel channel, DecompressMode *mode) {
+	switch (channel) {
+		case TinyImageFormat_LC_Red: *mode = DecompressModeRed;
+			return true;
+		case TinyImageFormat_LC_Green: *mode = DecompressModeGreen;
+			return true;
+		case TinyImageFormat_LC_Blue: *mode = DecompressModeBlue;
+			return true;
+		case TinyImageFormat_LC_Alpha: *mode = DecompressModeAlpha;
+			return true;
+		default: return false;
+	}
+}
 
-	auto dstFormat = ChooseDstFormatFromCompressedFormat(src->format);
-	auto func = ChooseDecompressFunction(src->format);
+AL2O3_EXTERN_C Image_ImageHeader const *Image_DecompressChannel(Image_ImageHeader const *src,
+																																TinyImageFormat_LogicalChannel channel) {
+	DecompressMode mode;
+	if (!TinyImageFormat_IsCompressed(src->format) || !ChannelDecompressMode(channel, &mode)) {
+		return nullptr;
+	}
+	return DecompressImage(src, TinyImageFormat_UNDEFINED, mode, nullptr);
+}
 
-	if(dstFormat == TinyImageFormat_UNDEFINED) {
+AL2O3_EXTERN_C Image_ImageHeader const *ImageDecompressChannelWithEnki(Image_ImageHeader const *src,
+																																			 TinyImageFormat_LogicalChannel channel,
+																																			 enkiTaskSchedulerHandle taskScheduler) {
+	DecompressMode mode;
+	if (!TinyImageFormat_IsCompressed(src->format) || !ChannelDecompressMode(channel, &mode)) {
 		return nullptr;
 	}
+	return DecompressImage(src, TinyImageFormat_UNDEFINED, mode, taskScheduler);
+}
 
-	if(func == nullptr) {
+// levels reduced inside a decode tile, tiles are a multiple of 1 << MipTileLevels texels so a tile's texels only
+// depend on the tile above it. The smaller levels are reduced once every tile is done
+static uint32_t const MipTileLevels = 4;
+static uint32_t const MipTileMinTexels = 64;
+
+struct MipDecompressJob {
+	DecompressJob decode;
+	Image_ImageHeader const **mips;
+	uint32_t mipCount;
+	uint32_t tileWidth; // in texels, a multiple of the block size and 1 << MipTileLevels
+	uint32_t tileHeight;
+	uint32_t tilesX;
+	uint32_t tilesY;
+};
+
+static uint32_t MipTileSize(uint32_t blockSize) {
+	uint32_t const align = 1u << MipTileLevels;
+	uint32_t a = blockSize, b = align;
+	while (b) {
+		uint32_t const t = a % b;
+		a = b;
+		b = t;
+	}
+	uint32_t const lcm = blockSize / a * align;
+	return ((MipTileMinTexels + lcm - 1) / lcm) * lcm;
+}
+
+static void DecompressMipTiles(MipDecompressJob const *job, uint32_t start, uint32_t end) {
+	DecompressJob const *decode = &job->decode;
+	uint32_t const tileBlocksX = job->tileWidth / decode->blockWidth;
+	uint32_t const tileBlocksY = job->tileHeight / decode->blockHeight;
+	uint32_t const fusedLevels = (job->mipCount - 1 < MipTileLevels) ? job->mipCount - 1 : MipTileLevels;
+
+	for (uint32_t t = start; t < end; ++t) {
+		uint32_t const tx = t % job->tilesX;
+		uint32_t const ty = (t / job->tilesX) % job->tilesY;
+		uint32_t const w = t / (job->tilesX * job->tilesY);
+
+		uint32_t const bx0 = tx * tileBlocksX;
+		uint32_t const bx1 = (bx0 + tileBlocksX < decode->blocksX) ? bx0 + tileBlocksX : decode->blocksX;
+		uint32_t const by0 = ty * tileBlocksY;
+		uint32_t const by1 = (by0 + tileBlocksY < decode->blocksY) ? by0 + tileBlocksY : decode->blocksY;
+		for (uint32_t by = by0; by < by1; ++by) {
+			uint32_t const rowStart = (w * decode->blocksY + by) * decode->blocksX;
+			DecompressBlocks(decode, rowStart + bx0, rowStart + bx1);
+		}
+
+		for (uint32_t l = 1; l <= fusedLevels; ++l) {
+			Image_ImageHeader const *level = job->mips[l];
+			uint32_t const x0 = (tx * job->tileWidth) >> l;
+			uint32_t const y0 = (ty * job->tileHeight) >> l;
+			uint32_t x1 = ((tx + 1) * job->tileWidth) >> l;
+			uint32_t y1 = ((ty + 1) * job->tileHeight) >> l;
+			x1 = (x1 < level->width) ? x1 : level->width;
+			y1 = (y1 < level->height) ? y1 : level->height;
+			if (x0 < x1 && y0 < y1) {
+				ReduceMipRegion(job->mips[l - 1], level, x0, y0, x1, y1, w);
+			}
+		}
+	}
+}
+
+void EnkiDecompressMipTilesFunc(uint32_t start, uint32_t end, uint32_t threadnum, void *pArgs) {
+	(void) threadnum;
+	DecompressMipTiles((MipDecompressJob const *) pArgs, start, end);
+}
+
+static uint32_t DecompressWithMips(Image_ImageHeader const *src,
+																	 uint32_t maxMipCount,
+																	 Image_ImageHeader const **mips,
+																	 enkiTaskSchedulerHandle taskScheduler) {
+	if (maxMipCount == 0 || !TinyImageFormat_IsCompressed(src->format) || IsPVRTC1Format(src->format) ||
+			src->depth != 1) {
+		return 0;
+	}
+	TinyImageFormat const decodedFormat = ChooseDstFormatFromCompressedFormat(src->format);
+	if (!CanReduceMipFormat(decodedFormat)) {
+		return 0;
+	}
+
+	MipDecompressJob job;
+	mips[0] = CreateDecompressJob(src, decodedFormat, DecompressModeDefault, &job.decode);
+	if (!mips[0]) {
+		return 0;
+	}
+
+	uint32_t mipCount = 1;
+	uint32_t width = src->width;
+	uint32_t height = src->height;
+	while (mipCount < maxMipCount && (width > 1 || height > 1)) {
+		width = (width > 1) ? width >> 1 : 1;
+		height = (height > 1) ? height >> 1 : 1;
+		mips[mipCount] = Image_CreateNoClear(width, height, 1, src->slices, decodedFormat);
+		if (!mips[mipCount]) {
+			for (uint32_t i = 0; i < mipCount; ++i) {
+				Image_Destroy(mips[i]);
+			}
+			return 0;
+		}
+		mipCount++;
+	}
+
+	job.mips = mips;
+	job.mipCount = mipCount;
+	job.tileWidth = MipTileSize(job.decode.blockWidth);
+	job.tileHeight = MipTileSize(job.decode.blockHeight);
+	job.tilesX = (src->width + job.tileWidth - 1) / job.tileWidth;
+	job.tilesY = (src->height + job.tileHeight - 1) / job.tileHeight;
+	uint32_t const tileCount = job.tilesX * job.tilesY * src->slices;
+
+	if (taskScheduler) {
+		auto taskSet = enkiCreateTaskSet(taskScheduler, &EnkiDecompressMipTilesFunc);
+		enkiAddTaskSetToPipeMinRange(taskScheduler, taskSet, &job, tileCount, 1);
+		enkiWaitForTaskSet(taskScheduler, taskSet);
+		enkiDeleteTaskSet(taskSet);
+	} else {
+		DecompressMipTiles(&job, 0, tileCount);
+	}
+
+	// merge pass for the levels smaller than a tile, reading level MipTileLevels which is 1/256 of level 0
+	for (uint32_t l = MipTileLevels + 1; l < mipCount; ++l) {
+		for (uint32_t w = 0; w < src->slices; ++w) {
+			ReduceMipRegion(mips[l - 1], mips[l], 0, 0, mips[l]->width, mips[l]->height, w);
+		}
+	}
+	return mipCount;
+}
+
+AL2O3_EXTERN_C uint32_t Image_DecompressWithMips(Image_ImageHeader const *src,
+																								 uint32_t maxMipCount,
+																								 Image_ImageHeader const **mips) {
+	return DecompressWithMips(src, maxMipCount, mips, nullptr);
+}
+
+AL2O3_EXTERN_C uint32_t ImageDecompressWithMipsWithEnki(Image_ImageHeader const *src,
+																												uint32_t maxMipCount,
+																												Image_ImageHeader const **mips,
+																												enkiTaskSchedulerHandle taskScheduler) {
+	return DecompressWithMips(src, maxMipCount, mips, taskScheduler);
+}
+
+static Image_ImageHeader const *CreateASTC3DDecompressJob(void const *src,
+																													uint32_t width,
+																													uint32_t height,
+																													uint32_t depth,
+																													uint32_t blockWidth,
+																													uint32_t blockHeight,
+																													uint32_t blockDepth,
+																													TinyImageFormat dstFormat,
+																													DecompressJob *job) {
+	auto func = ChooseASTC3DDecompressFunction(blockWidth, blockHeight, blockDepth, dstFormat);
+	if (func == nullptr) {
 		return nullptr;
 	}
 
-	Image_ImageHeader const *dst = Image_CreateNoClear(src->width, src->height, 1, src->slices, dstFormat);
+	Image_ImageHeader const *dst = Image_CreateNoClear(width, height, depth, 1, dstFormat);
 	if (!dst) {
 		return nullptr;
 	}
 
-	// get block size round up to 4
-	size_t const blocksX =
-			(src->width + TinyImageFormat_WidthOfBlock(src->format) - 1) / TinyImageFormat_WidthOfBlock(src->format);
-	size_t const blocksY =
-			(src->height + TinyImageFormat_HeightOfBlock(src->format) - 1) / TinyImageFormat_HeightOfBlock(src->format);
+	*job = MakeDecompressJob(nullptr, (uint8_t const *) src, dst, func, 16, blockWidth, blockHeight, blockDepth);
+	return dst;
+}
 
-	auto taskSet = enkiCreateTaskSet(taskScheduler, &EnkiDecompressBlockFunc);
+AL2O3_EXTERN_C Image_ImageHeader const *Image_DecompressASTC3D(void const *src,
+																															 uint32_t width,
+																															 uint32_t height,
+																															 uint32_t depth,
+																															 uint32_t blockWidth,
+																															 uint32_t blockHeight,
+																															 uint32_t blockDepth,
+																															 TinyImageFormat dstFormat) {
+	DecompressJob job;
+	Image_ImageHeader const *dst = CreateASTC3DDecompressJob(src, width, height, depth,
+																													 blockWidth, blockHeight, blockDepth, dstFormat, &job);
+	if (!dst) {
+		return nullptr;
+	}
 
-	auto paramBlocks = (EnkiDecompressParameterBlock*) STACK_ALLOC(sizeof(EnkiDecompressParameterBlock) * src->slices);
+	DecompressBlocks(&job, 0, DecompressJobBlockCount(&job, 1));
+	return dst;
+}
 
-	for (uint32_t w = 0; w < src->slices; ++w) {
-		paramBlocks[w] =  { src, dst, func, w };
-		enkiAddTaskSetToPipeMinRange(taskScheduler, taskSet, &paramBlocks[w], blocksX * blocksY, 10);
+AL2O3_EXTERN_C Image_ImageHeader const *ImageDecompressASTC3DWithEnki(void const *src,
+																																			uint32_t width,
+																																			uint32_t height,
+																																			uint32_t depth,
+																																			uint32_t blockWidth,
+																																			uint32_t blockHeight,
+																																			uint32_t blockDepth,
+																																			TinyImageFormat dstFormat,
+																																			enkiTaskSchedulerHandle taskScheduler) {
+	DecompressJob job;
+	Image_ImageHeader const *dst = CreateASTC3DDecompressJob(src, width, height, depth,
+																													 blockWidth, blockHeight, blockDepth, dstFormat, &job);
+	if (!dst) {
+		return nullptr;
 	}
 
-	enkiWaitForTaskSet(taskScheduler, taskSet);
-	enkiDeleteTaskSet(taskSet);
-
+	DecompressJobWithEnki(&job, 1, taskScheduler);
 	return dst;
 }
@@ -0,0 +1,348 @@
+// PVRTC1 2bpp and 4bpp whole image decompression.
+// Every texel blends the low frequency A and B images of the 2x2 blocks around it, so unlike the other formats
+// blocks can't be decoded alone. Instead a window of two decoded block rows slides down the image and each
+// step outputs the block height of texel rows between the two block rows' centres.
+// Based on the PowerVR SDK reference decoder (PVRTDecompress)
+
+#include "al2o3_platform/platform.h"
+#include "al2o3_memory/memory.h"
+#include "gfx_image/image.h"
+
+namespace {
+
+// 5 bit RGB and 4 bit alpha
+enum { PVRTC_R, PVRTC_G, PVRTC_B, PVRTC_A };
+struct PVRTCColour {
+	int32_t channel[4];
+};
+
+// a decoded row of blocks, modulation is per texel
+struct PVRTCBlockRow {
+	PVRTCColour *colourA;
+	PVRTCColour *colourB;
+	uint8_t *modulation;    // 4bpp final weight (+10 for punch through), 2bpp 2 bit stored value
+	uint8_t *modulationMode;  // 2bpp per block, 0 direct, 1 H&V, 2 H only, 3 V only
+};
+
+struct PVRTCPlane {
+	uint8_t const *blocks;
+	uint32_t blocksX;
+	uint32_t blocksY;
+	bool is2bpp;
+};
+
+int32_t const ModulationWeights[4] = {0, 3, 5, 8};
+int32_t const PunchThroughWeights[4] = {0, 4, 14, 8};
+
+// blocks are stored in morton order, any extra bits of the larger dimension are on top
+uint32_t TwiddleUV(uint32_t xSize, uint32_t ySize, uint32_t xPos, uint32_t yPos) {
+	uint32_t minimumDimension = xSize;
+	uint32_t maxValue = yPos;
+	if (ySize < xSize) {
+		minimumDimension = ySize;
+		maxValue = xPos;
+	}
+
+	uint32_t twiddled = 0;
+	uint32_t srcBitPos = 1;
+	uint32_t dstBitPos = 1;
+	uint32_t shiftCount = 0;
+	while (srcBitPos < minimumDimension) {
+		if (yPos & srcBitPos) {
+			twiddled |= dstBitPos;
+		}
+		if (xPos & srcBitPos) {
+			twiddled |= (dstBitPos << 1);
+		}
+		srcBitPos <<= 1;
+		dstBitPos <<= 2;
+		shiftCount++;
+	}
+
+	return twiddled | ((maxValue >> shiftCount) << (2 * shiftCount));
+}
+
+PVRTCColour UnpackColourA(uint32_t colourData) {
+	PVRTCColour c;
+	if (colourData & 0x8000) {
+		// RGB 554
+		c.channel[PVRTC_R] = (colourData >> 10) & 0x1F;
+		c.channel[PVRTC_G] = (colourData >> 5) & 0x1F;
+		c.channel[PVRTC_B] = (colourData & 0x1E) | ((colourData >> 4) & 0x1);
+		c.channel[PVRTC_A] = 0xF;
+	} else {
+		// ARGB 3443
+		c.channel[PVRTC_R] = ((colourData >> 7) & 0x1E) | ((colourData >> 11) & 0x1);
+		c.channel[PVRTC_G] = ((colourData >> 3) & 0x1E) | ((colourData >> 7) & 0x1);
+		c.channel[PVRTC_B] = ((colourData << 1) & 0x1C) | ((colourData >> 2) & 0x3);
+		c.channel[PVRTC_A] = (colourData >> 11) & 0xE;
+	}
+	return c;
+}
+
+PVRTCColour UnpackColourB(uint32_t colourData) {
+	PVRTCColour c;
+	if (colourData & 0x8000) {
+		// RGB 555
+		c.channel[PVRTC_R] = (colourData >> 10) & 0x1F;
+		c.channel[PVRTC_G] = (colourData >> 5) & 0x1F;
+		c.channel[PVRTC_B] = colourData & 0x1F;
+		c.channel[PVRTC_A] = 0xF;
+	} else {
+		// ARGB 3444
+		c.channel[PVRTC_R] = ((colourData >> 7) & 0x1E) | ((colourData >> 11) & 0x1);
+		c.channel[PVRTC_G] = ((colourData >> 3) & 0x1E) | ((colourData >> 7) & 0x1);
+		c.channel[PVRTC_B] = ((colourData << 1) & 0x1E) | ((colourData >> 3) & 0x1);
+		c.channel[PVRTC_A] = (colourData >> 11) & 0xE;
+	}
+	return c;
+}
+
+void DecodeBlockRow(PVRTCPlane const *plane, uint32_t by, PVRTCBlockRow *row) {
+	uint32_t const blockWidth = plane->is2bpp ? 8 : 4;
+	uint32_t const rowWidth = plane->blocksX * blockWidth;
+
+	for (uint32_t bx = 0; bx < plane->blocksX; ++bx) {
+		uint8_t const *block = plane->blocks + TwiddleUV(plane->blocksX, plane->blocksY, bx, by) * 8;
+		uint32_t modulationData = block[0] | (block[1] << 8) | (block[2] << 16) | ((uint32_t) block[3] << 24);
+		uint32_t const colourData = block[4] | (block[5] << 8) | (block[6] << 16) | ((uint32_t) block[7] << 24);
+
+		row->colourA[bx] = UnpackColourA(colourData & 0xFFFF);
+		row->colourB[bx] = UnpackColourB(colourData >> 16);
+
+		uint8_t *modulation = row->modulation + bx * blockWidth;
+		bool const modulationFlag = (colourData & 0x1) != 0;
+		if (!plane->is2bpp) {
+			int32_t const *weights = modulationFlag ? PunchThroughWeights : ModulationWeights;
+			for (uint32_t y = 0; y < 4; ++y) {
+				for (uint32_t x = 0; x < 4; ++x) {
+					modulation[y * rowWidth + x] = (uint8_t) weights[modulationData & 0x3];
+					modulationData >>= 2;
+				}
+			}
+		} else if (modulationFlag) {
+			// 2 bits for every other texel in a checkerboard, the rest are interpolated from their neighbours
+			uint8_t mode = 1;
+			if (modulationData & 0x1) {
+				// the centre texel's low bit selects H or V only, its value is the single bit above
+				mode = (modulationData & (0x1 << 20)) ? 3 : 2;
+				if (modulationData & (0x1 << 21)) {
+					modulationData |= (0x1 << 20);
+				} else {
+					modulationData &= ~(0x1 << 20);
+				}
+			}
+			if (modulationData & 0x2) {
+				modulationData |= 0x1;
+			} else {
+				modulationData &= ~0x1;
+			}
+			row->modulationMode[bx] = mode;
+
+			for (uint32_t y = 0; y < 4; ++y) {
+				for (uint32_t x = 0; x < 8; ++x) {
+					if (((x ^ y) & 1) == 0) {
+						modulation[y * rowWidth + x] = (uint8_t) (modulationData & 0x3);
+						modulationData >>= 2;
+					}
+				}
+			}
+		} else {
+			// 1 bit per texel, 0 -> 00 and 1 -> 11
+			row->modulationMode[bx] = 0;
+			for (uint32_t y = 0; y < 4; ++y) {
+				for (uint32_t x = 0; x < 8; ++x) {
+					modulation[y * rowWidth + x] = (modulationData & 0x1) ? 0x3 : 0x0;
+					modulationData >>= 1;
+				}
+			}
+		}
+	}
+}
+
+// x is in texels across the row and wraps, y is 0 to 7 over the upper then lower block row
+AL2O3_FORCE_INLINE int32_t StoredModulation(PVRTCBlockRow const *rows, uint32_t rowWidth, int32_t x, int32_t y) {
+	x = (x < 0) ? x + (int32_t) rowWidth : ((x >= (int32_t) rowWidth) ? x - (int32_t) rowWidth : x);
+	return ModulationWeights[rows[y >> 2].modulation[(y & 3) * rowWidth + x]];
+}
+
+int32_t ModulationWeight2bpp(PVRTCBlockRow const *rows, uint32_t rowWidth, int32_t x, int32_t y) {
+	uint8_t const mode = rows[y >> 2].modulationMode[x / 8];
+	if (mode == 0 || ((x ^ y) & 1) == 0) {
+		return StoredModulation(rows, rowWidth, x, y);
+	}
+
+	switch (mode) {
+		case 1:
+			return (StoredModulation(rows, rowWidth, x, y - 1) + StoredModulation(rows, rowWidth, x, y + 1) +
+					StoredModulation(rows, rowWidth, x - 1, y) + StoredModulation(rows, rowWidth, x + 1, y) + 2) / 4;
+		case 2: return (StoredModulation(rows, rowWidth, x - 1, y) + StoredModulation(rows, rowWidth, x + 1, y) + 1) / 2;
+		default: return (StoredModulation(rows, rowWidth, x, y - 1) + StoredModulation(rows, rowWidth, x, y + 1) + 1) / 2;
+	}
+}
+
+// outputs the texel rows between the centres of the upper and lower block rows
+void DecodeWindowRow(PVRTCPlane const *plane,
+										 PVRTCBlockRow const *rows,
+										 uint32_t wy,
+										 Image_ImageHeader const *dst,
+										 uint32_t z,
+										 uint32_t w) {
+	uint32_t const blockWidth = plane->is2bpp ? 8 : 4;
+	uint32_t const blockHeight = 4;
+	uint32_t const rowWidth = plane->blocksX * blockWidth;
+	uint32_t const imageHeight = plane->blocksY * blockHeight;
+	// upscale weights sum to 16 (4bpp) or 32 (2bpp), these take the sums straight to 8 bit
+	uint32_t const shift = plane->is2bpp ? 5 : 4;
+	uint8_t *rawData = (uint8_t *) Image_RawDataPtr(dst);
+
+	for (uint32_t y = 0; y < blockHeight; ++y) {
+		uint32_t const py = (wy * blockHeight + blockHeight / 2 + y) % imageHeight;
+		if (py >= dst->height) {
+			continue;
+		}
+		int32_t const fy = (int32_t) y;
+		uint8_t *dstRow = rawData + Image_CalculateIndex(dst, 0, py, z, w) * 4;
+
+		for (uint32_t wx = 0; wx < plane->blocksX; ++wx) {
+			uint32_t const wx1 = (wx + 1 == plane->blocksX) ? 0 : wx + 1;
+			PVRTCColour const *a[4] = {&rows[0].colourA[wx], &rows[0].colourA[wx1], &rows[1].colourA[wx], &rows[1].colourA[wx1]};
+			PVRTCColour const *b[4] = {&rows[0].colourB[wx], &rows[0].colourB[wx1], &rows[1].colourB[wx], &rows[1].colourB[wx1]};
+
+			for (uint32_t x = 0; x < blockWidth; ++x) {
+				uint32_t const px = (wx * blockWidth + blockWidth / 2 + x) % rowWidth;
+				if (px >= dst->width) {
+					continue;
+				}
+
+				int32_t const fx = (int32_t) x;
+				int32_t const bw = (int32_t) blockWidth;
+				int32_t const bh = (int32_t) blockHeight;
+				int32_t const wP = (bw - fx) * (bh - fy);
+				int32_t const wQ = fx * (bh - fy);
+				int32_t const wR = (bw - fx) * fy;
+				int32_t const wS = fx * fy;
+
+				int32_t mod;
+				int32_t const my = (int32_t) (blockHeight / 2 + y);
+				if (plane->is2bpp) {
+					mod = ModulationWeight2bpp(rows, rowWidth, (int32_t) px, my);
+				} else {
+					mod = rows[my >> 2].modulation[(my & 3) * rowWidth + px];
+				}
+				bool punchThrough = false;
+				if (mod > 10) {
+					punchThrough = true;
+					mod -= 10;
+				}
+
+				int32_t colour[4];
+				for (int c = 0; c < 4; ++c) {
+					int32_t sa = a[0]->channel[c] * wP + a[1]->channel[c] * wQ + a[2]->channel[c] * wR + a[3]->channel[c] * wS;
+					int32_t sb = b[0]->channel[c] * wP + b[1]->channel[c] * wQ + b[2]->channel[c] * wR + b[3]->channel[c] * wS;
+					if (c == PVRTC_A) {
+						// 4 bit to 8 bit
+						sa = (sa >> shift) + ((sa << 4) >> shift);
+						sb = (sb >> shift) + ((sb << 4) >> shift);
+					} else {
+						// 5 bit to 8 bit
+						sa = (sa >> (shift + 2)) + (sa >> (shift - 3));
+						sb = (sb >> (shift + 2)) + (sb >> (shift - 3));
+					}
+					colour[c] = (sa * (8 - mod) + sb * mod) / 8;
+				}
+
+				uint8_t *dstPtr = dstRow + px * 4;
+				dstPtr[0] = (uint8_t) colour[PVRTC_B];
+				dstPtr[1] = (uint8_t) colour[PVRTC_G];
+				dstPtr[2] = (uint8_t) colour[PVRTC_R];
+				dstPtr[3] = punchThrough ? 0 : (uint8_t) colour[PVRTC_A];
+			}
+		}
+	}
+}
+
+bool IsPVRTC2bpp(TinyImageFormat format) {
+	return format == TinyImageFormat_PVRTC1_2BPP_UNORM || format == TinyImageFormat_PVRTC1_2BPP_SRGB;
+}
+
+} // end anonymous namespace
+
+bool IsPVRTC1Format(TinyImageFormat format) {
+	switch (format) {
+		case TinyImageFormat_PVRTC1_2BPP_UNORM:
+		case TinyImageFormat_PVRTC1_4BPP_UNORM:
+		case TinyImageFormat_PVRTC1_2BPP_SRGB:
+		case TinyImageFormat_PVRTC1_4BPP_SRGB: return true;
+		default: return false;
+	}
+}
+
+// one window row per block row of every depth slice and array slice
+uint32_t PVRTCWindowRowCount(Image_ImageHeader const *src) {
+	uint32_t const blocksY = (src->height + 3) / 4;
+	return blocksY * src->depth * src->slices;
+}
+
+// decodes window rows [start, end) into dst (BGRA8), consecutive rows reuse the already decoded block row
+void DecompressPVRTCWindowRows(Image_ImageHeader const *src,
+															 Image_ImageHeader const *dst,
+															 uint32_t start,
+															 uint32_t end) {
+	PVRTCPlane plane;
+	plane.is2bpp = IsPVRTC2bpp(src->format);
+	uint32_t const blockWidth = plane.is2bpp ? 8 : 4;
+	plane.blocksX = (src->width + blockWidth - 1) / blockWidth;
+	plane.blocksY = (src->height + 3) / 4;
+	uint32_t const rowWidth = plane.blocksX * blockWidth;
+
+	size_t const colourSize = plane.blocksX * sizeof(PVRTCColour);
+	size_t const modulationSize = rowWidth * 4;
+	// keep the second row's colours aligned
+	size_t const rowSize = (colourSize * 2 + modulationSize + plane.blocksX + 15) & ~(size_t) 15;
+	uint8_t *scratch = (uint8_t *) MEMORY_MALLOC(rowSize * 2);
+	if (!scratch) {
+		return;
+	}
+
+	PVRTCBlockRow rows[2];
+	for (uint32_t i = 0; i < 2; ++i) {
+		uint8_t *base = scratch + rowSize * i;
+		rows[i].colourA = (PVRTCColour *) base;
+		rows[i].colourB = (PVRTCColour *) (base + colourSize);
+		rows[i].modulation = base + colourSize * 2;
+		rows[i].modulationMode = base + colourSize * 2 + modulationSize;
+	}
+
+	uint8_t const *srcData = (uint8_t const *) Image_RawDataPtr(src);
+	uint32_t loadedPlane = ~0u;
+	uint32_t loadedRow = ~0u;
+	for (uint32_t r = start; r < end; ++r) {
+		uint32_t const planeIndex = r / plane.blocksY;
+		uint32_t const wy = r % plane.blocksY;
+		uint32_t const z = planeIndex % src->depth;
+		uint32_t const w = planeIndex / src->depth;
+		uint32_t const lowerRow = (wy + 1 == plane.blocksY) ? 0 : wy + 1;
+
+		if (planeIndex != loadedPlane) {
+			plane.blocks = srcData + Image_GetBlockIndex(src, 0, 0, z, w) * 8;
+			loadedPlane = planeIndex;
+			loadedRow = ~0u;
+		}
+
+		if (loadedRow == wy) {
+			// slide the window down, the old lower row is the new upper row
+			PVRTCBlockRow const tmp = rows[0];
+			rows[0] = rows[1];
+			rows[1] = tmp;
+		} else {
+			DecodeBlockRow(&plane, wy, &rows[0]);
+		}
+		DecodeBlockRow(&plane, lowerRow, &rows[1]);
+		loadedRow = lowerRow;
+
+		DecodeWindowRow(&plane, rows, wy, dst, z, w);
+	}
+
+	MEMORY_FREE(scratch);
+}
@@ -0,0 +1,351 @@
+#include "al2o3_platform/platform.h"
+#include "al2o3_catch2/catch2.hpp"
+#include "gfx_image/image.h"
+#include "gfx_imagedecompress/imagedecompress.h"
+#include "knownanswers.h"
+#include <math.h>
+
+// ASTC known answer blocks, HDR profile outputs are RGBA halves
+namespace {
+typedef KnownAnswerBlock<uint16_t, 4 * 4 * 4> ASTCHDRVector;
+
+// 4x4 single partition blocks, one per HDR endpoint mode
+static ASTCHDRVector const HDRVectors[6] = {
+		// endpoint mode 2
+		{
+				{0x8E, 0x43, 0xBC, 0xC0, 0xEF, 0xC5, 0xC9, 0x9D, 0x79, 0x60, 0xB0, 0x77, 0x07, 0xBB, 0x39, 0x0F},
+				{
+						0x2EC0, 0x2EC0, 0x2EC0, 0x3C00, 0x5B9C, 0x5B9C, 0x5B9C, 0x3C00,
+						0x6BEC, 0x6BEC, 0x6BEC, 0x3C00, 0x63C4, 0x63C4, 0x63C4, 0x3C00,
+						0x3AFC, 0x3AFC, 0x3AFC, 0x3C00, 0x5E7C, 0x5E7C, 0x5E7C, 0x3C00,
+						0x6AAC, 0x6AAC, 0x6AAC, 0x3C00, 0x649F, 0x649F, 0x649F, 0x3C00,
+						0x4A2C, 0x4A2C, 0x4A2C, 0x3C00, 0x5E7C, 0x5E7C, 0x5E7C, 0x3C00,
+						0x68AB, 0x68AB, 0x68AB, 0x3C00, 0x669C, 0x669C, 0x669C, 0x3C00,
+						0x565C, 0x565C, 0x565C, 0x3C00, 0x628C, 0x628C, 0x628C, 0x3C00,
+						0x67D8, 0x67D8, 0x67D8, 0x3C00, 0x67D8, 0x67D8, 0x67D8, 0x3C00
+				}
+		},
+		// endpoint mode 3
+		{
+				{0x3F, 0x67, 0xB4, 0xEA, 0xEC, 0x1F, 0x6C, 0x54, 0xB1, 0x60, 0xED, 0xDB, 0xA1, 0x94, 0x40, 0x95},
+				{
+						0x3D97, 0x3D76, 0x3D76, 0x3C00, 0x3D94, 0x3D6F, 0x3D6F, 0x3C00,
+						0x3D92, 0x3D67, 0x3D67, 0x3C00, 0x3D8F, 0x3D60, 0x3D60, 0x3C00,
+						0x3D75, 0x3D88, 0x3D88, 0x3C00, 0x3D80, 0x3D83, 0x3D83, 0x3C00,
+						0x3D93, 0x3D7D, 0x3D7D, 0x3C00, 0x3D9E, 0x3D78, 0x3D78, 0x3C00,
+						0x3D75, 0x3D93, 0x3D93, 0x3C00, 0x3D83, 0x3D8A, 0x3D8A, 0x3C00,
+						0x3D97, 0x3D83, 0x3D83, 0x3C00, 0x3DA5, 0x3D79, 0x3D79, 0x3C00,
+						0x3D97, 0x3D9C, 0x3D9C, 0x3C00, 0x3D9B, 0x3D8A, 0x3D8A, 0x3C00,
+						0x3DA0, 0x3D74, 0x3D74, 0x3C00, 0x3DA3, 0x3D62, 0x3D62, 0x3C00
+				}
+		},
+		// endpoint mode 7
+		{
+				{0xDF, 0xE3, 0x98, 0xC3, 0x37, 0x82, 0xEF, 0xFB, 0x68, 0x1C, 0xBA, 0x75, 0x64, 0xB2, 0xDE, 0x5A},
+				{
+						0x4828, 0x5058, 0x4976, 0x3C00, 0x4828, 0x5058, 0x4976, 0x3C00,
+						0x48BA, 0x50F9, 0x4A39, 0x3C00, 0x49FE, 0x523E, 0x4BAD, 0x3C00,
+						0x4828, 0x5058, 0x4976, 0x3C00, 0x4010, 0x4840, 0x4156, 0x3C00,
+						0x3ED6, 0x4726, 0x406D, 0x3C00, 0x447E, 0x4CAE, 0x45E8, 0x3C00,
+						0x46FE, 0x4F4E, 0x4885, 0x3C00, 0x45EE, 0x4E2E, 0x4799, 0x3C00,
+						0x46B1, 0x4EFD, 0x4854, 0x3C00, 0x497C, 0x51BC, 0x4B0B, 0x3C00,
+						0x3B65, 0x43B5, 0x3CC4, 0x3C00, 0x3FCA, 0x480F, 0x4115, 0x3C00,
+						0x411B, 0x495B, 0x429B, 0x3C00, 0x4072, 0x48A2, 0x41D8, 0x3C00
+				}
+		},
+		// endpoint mode 11
+		{
+				{0x21, 0x62, 0xAD, 0xE0, 0x9E, 0x6A, 0xD4, 0x88, 0xF5, 0xB8, 0x90, 0x2E, 0x13, 0x07, 0x40, 0x76},
+				{
+						0x4A04, 0x3D22, 0x4D30, 0x3C00, 0x4A04, 0x3D22, 0x4D30, 0x3C00,
+						0x49B0, 0x3DD8, 0x4E80, 0x3C00, 0x4B10, 0x3B10, 0x4940, 0x3C00,
+						0x4AAC, 0x3BF3, 0x4A90, 0x3C00, 0x4AAC, 0x3BF3, 0x4A90, 0x3C00,
+						0x49B0, 0x3DD8, 0x4E80, 0x3C00, 0x4A1C, 0x3CEE, 0x4CD0, 0x3C00,
+						0x4A7C, 0x3C46, 0x4B74, 0x3C00, 0x4A28, 0x3CD4, 0x4CA8, 0x3C00,
+						0x495C, 0x3E8E, 0x500C, 0x3C00, 0x4944, 0x3EC2, 0x5054, 0x3C00,
+						0x4950, 0x3EA8, 0x5030, 0x3C00, 0x486F, 0x40CA, 0x5424, 0x3C00,
+						0x48AE, 0x403F, 0x52A0, 0x3C00, 0x486F, 0x40CA, 0x5424, 0x3C00
+				}
+		},
+		// endpoint mode 14
+		{
+				{0x9E, 0xC3, 0xC5, 0x93, 0xF2, 0xC3, 0x41, 0x99, 0x09, 0xA4, 0x80, 0x4E, 0x8C, 0xE3, 0x2F, 0x7D},
+				{
+						0x51AC, 0x7788, 0x31A0, 0x307A, 0x34FC, 0x72E8, 0x4220, 0x3413,
+						0x3407, 0x72B0, 0x42D4, 0x3427, 0x4E16, 0x76D4, 0x33EC, 0x30F0,
+						0x494E, 0x7610, 0x3670, 0x318C, 0x3407, 0x72B0, 0x42D4, 0x3427,
+						0x34FC, 0x72E8, 0x4220, 0x3413, 0x4BEE, 0x7670, 0x3510, 0x313E,
+						0x3FFD, 0x749C, 0x3C24, 0x32C6, 0x362E, 0x7324, 0x4170, 0x33FF,
+						0x389D, 0x739C, 0x403C, 0x33B1, 0x494E, 0x7610, 0x3670, 0x318C,
+						0x3788, 0x7360, 0x40C0, 0x33D8, 0x34FC, 0x72E8, 0x4220, 0x3413,
+						0x39C4, 0x73D8, 0x3F88, 0x338A, 0x46F4, 0x75B0, 0x380C, 0x31DB
+				}
+		},
+		// endpoint mode 15
+		{
+				{0x13, 0xE2, 0x03, 0x7B, 0xCE, 0x09, 0x16, 0x93, 0xC7, 0xE8, 0xFB, 0x97, 0xC8, 0x15, 0xCD, 0x60},
+				{
+						0x39E0, 0x5DF8, 0x1660, 0x7BFF, 0x25B0, 0x1A94, 0x3B4C, 0x7BFF,
+						0x33B0, 0x48B4, 0x2200, 0x7BFF, 0x2D20, 0x3392, 0x2DA0, 0x7BFF,
+						0x3306, 0x46F4, 0x2306, 0x7BFF, 0x2B10, 0x2C6C, 0x3180, 0x7BFF,
+						0x3628, 0x518E, 0x1D28, 0x7BFF, 0x28E0, 0x2538, 0x3560, 0x7BFF,
+						0x2A78, 0x2A8A, 0x3278, 0x7BFF, 0x3160, 0x4198, 0x25E0, 0x7BFF,
+						0x3958, 0x5C55, 0x177E, 0x7BFF, 0x2442, 0x1542, 0x3E18, 0x7BFF,
+						0x23C4, 0x13AB, 0x3F24, 0x7BFF, 0x36B0, 0x5379, 0x1C54, 0x7BFF,
+						0x3C30, 0x6510, 0x1280, 0x7BFF, 0x2078, 0x08D8, 0x44E0, 0x7BFF
+				}
+		}
+};
+
+// 3D blocks, LDR expected texels are B8G8R8A8 as little endian uint32s
+// 3x3x3 UNORM, 2x2x2 weight grid
+static uint8_t const Infill3x3x3Block[16] = {0x13, 0x02, 0x03, 0x7B, 0xCE, 0x09, 0x16, 0x93, 0xC7, 0xE8, 0xFB, 0x97, 0xC8, 0x15, 0xCD, 0x60};
+static uint32_t const Infill3x3x3Texels[27] = {
+		0xFF8476BE, 0xFF848EAB, 0xFF85A799, 0xFF847DB8, 0xFF8485B2, 0xFF859E9F, 0xFF8485B2, 0xFF848DAC,
+		0xFF8595A6, 0xFF8591A9, 0xFF8479BB, 0xFF8592A8, 0xFF8373C0, 0xFF8595A6, 0xFF86AE94, 0xFF847BBA,
+		0xFF859DA0, 0xFF85A49B, 0xFF86AC95, 0xFF8595A6, 0xFF847DB8, 0xFF848EAB, 0xFF86B092, 0xFF8599A3,
+		0xFF8370C2, 0xFF8592A8, 0xFF86B48F
+};
+// 4x4x4 SRGB, 3x2x3 weight grid
+static uint8_t const Infill4x4x4SRGBBlock[16] = {0x27, 0x02, 0x95, 0x69, 0x63, 0xA1, 0x3A, 0x0E, 0xF3, 0x49, 0xA6, 0xF8, 0x49, 0x37, 0x30, 0x99};
+static uint32_t const Infill4x4x4SRGBTexels[64] = {
+		0xFF6363FF, 0xFF478CAF, 0xFF4391A5, 0xFF5873DF, 0xFF5479D3, 0xFF4E81C5, 0xFF4292A2, 0xFF5774DD,
+		0xFF40969B, 0xFF5873DF, 0xFF4C84BD, 0xFF5676DA, 0xFF30AC6F, 0xFF4889B3, 0xFF5479D3, 0xFF5577D8,
+		0xFF6264FD, 0xFF537AD1, 0xFF3D9994, 0xFF3C9B91, 0xFF6165FA, 0xFF5A71E4, 0xFF40969B, 0xFF3F9799,
+		0xFF6067F8, 0xFF6264FD, 0xFF488BB1, 0xFF4193A0, 0xFF507EC9, 0xFF527CCE, 0xFF4F7FC7, 0xFF41949E,
+		0xFF5A6FE7, 0xFF4E82C2, 0xFF4292A2, 0xFF2FAD6D, 0xFF6068F5, 0xFF527CCE, 0xFF458EAA, 0xFF32A974,
+		0xFF5F69F3, 0xFF5A71E4, 0xFF4D83C0, 0xFF35A67B, 0xFF5E6AF0, 0xFF5972E2, 0xFF5479D3, 0xFF36A380,
+		0xFF4C84BD, 0xFF4193A0, 0xFF38A185, 0xFF2EB068, 0xFF517DCC, 0xFF458EAA, 0xFF3B9D8C, 0xFF30AC6F,
+		0xFF5774DD, 0xFF4A87B8, 0xFF3F9799, 0xFF33A877, 0xFF5C6DEC, 0xFF4F7FC7, 0xFF4391A5, 0xFF35A47E
+};
+// 4x3x3 UNORM, dual plane 3x2x2 weight grid
+static uint8_t const DualPlane4x3x3Block[16] = {0x31, 0x04, 0x33, 0xF2, 0xD7, 0x0F, 0x53, 0x14, 0x69, 0x46, 0x40, 0x3C, 0x56, 0xC3, 0xA7, 0x31};
+static uint32_t const DualPlane4x3x3Texels[36] = {
+		0xFFF9EB29, 0xFF5FA66C, 0xFF3C977B, 0xFF89B959, 0xFF89D241, 0xFFCFBF53, 0xFF43B062, 0xFF51D241,
+		0xFF19B959, 0xFFB3B959, 0xFFB3C94A, 0xFF19EB29, 0xFFF9B959, 0xFFCFBF53, 0xFF439081, 0xFF51A072,
+		0xFFF9EB29, 0xFF97D93B, 0xFF74B959, 0xFFC1D241, 0xFF89D241, 0xFF7BD241, 0xFFE4D241, 0xFF89EB29,
+		0xFFF9878A, 0xFFF9AA69, 0xFFB3AA69, 0xFF19878A, 0xFFF9B959, 0xFFC1C350, 0xFFE4D241, 0xFF89B959,
+		0xFFF9EB29, 0xFFACEB29, 0xFFACEB29, 0xFFF9EB29
+};
+// 3x3x3 UNORM, 2 partitions hashed with the small block coordinates
+static uint8_t const Partitions3x3x3Block[16] = {0x02, 0xAA, 0x43, 0xB1, 0xBA, 0xA4, 0x19, 0x99, 0xC6, 0xE5, 0x05, 0x2B, 0x64, 0x2E, 0x3A, 0x72};
+static uint32_t const Partitions3x3x3Texels[27] = {
+		0xFFD224CA, 0xFFC321BC, 0xFFB31EAC, 0xFFCF24C8, 0xFFC421BD, 0xFFB41EAE, 0xFFCC23C5, 0xFFC121BA,
+		0xFFB61FAF, 0xFFC321BC, 0xFFC722C0, 0xFFB71FB0, 0xFFC622BE, 0xFFBF20B8, 0xFFB01DA9, 0xFFC321BC,
+		0xFFBC20B5, 0xFFB11EAB, 0xFFB31EAC, 0xFFB71FB0, 0x41313131, 0xFFB61FAF, 0xFFB01DA9, 0x3B323232,
+		0xFFB91FB2, 0xFFB31EAC, 0x34333333
+};
+// 5x4x4 UNORM, 3 partitions
+static uint8_t const Partitions5x4x4Block[16] = {0x16, 0xD2, 0x9A, 0x46, 0xC4, 0x82, 0x9E, 0x2C, 0x32, 0xA2, 0x85, 0x76, 0xC0, 0xE3, 0x39, 0xF1};
+static uint32_t const Partitions5x4x4Texels[80] = {
+		0xFF33C133, 0xFF2DAB2D, 0xFF289828, 0xFF228222, 0xFF1D6C1D, 0x39222222, 0x3F222222, 0x4A222222,
+		0x56222222, 0x62222222, 0xFF515151, 0xFF444444, 0xFF373737, 0xFF2A2A2A, 0xFF171717, 0xFF484848,
+		0xFF3B3B3B, 0xFF313131, 0xFF242424, 0xFF171717, 0xFF3FEC3F, 0xFF3ADB3A, 0xFF35C835, 0xFF30B730,
+		0xFF2BA12B, 0x36222222, 0x33222222, 0x3A222222, 0x43222222, 0x4F222222, 0xFF2A2A2A, 0xFF2E2E2E,
+		0xFF333333, 0xFF333333, 0xFF202020, 0xFF222222, 0xFF262626, 0xFF2C2C2C, 0xFF2C2C2C, 0xFF202020,
+		0xFF42F842, 0xFF3BE03B, 0xFF37CF37, 0xFF32BC32, 0xFF4E4E4E, 0x22222222, 0x15222222, 0x19222222,
+		0x23222222, 0x2D222222, 0xFF4A4A4A, 0xFF606060, 0xFF686868, 0xFF686868, 0xFF575757, 0xFF202020,
+		0xFF353535, 0xFF3D3D3D, 0xFF424242, 0xFF464646, 0xFF3EEA3E, 0xFF717171, 0xFF5D5D5D, 0xFF484848,
+		0xFF333333, 0x2A222222, 0x1D222222, 0x23222222, 0x31222222, 0x3E222222, 0xFF575757, 0xFF6C6C6C,
+		0xFF808080, 0xFF8A8A8A, 0xFF757575, 0xFF424242, 0xFF575757, 0xFF6A6A6A, 0xFF808080, 0xFF939393
+};
+// 3x3x3 HDR profile, endpoint mode 11 with a 2x2x2 weight grid
+static uint8_t const HDR3x3x3Block[16] = {0x12, 0x62, 0x57, 0xA4, 0xAD, 0xE5, 0xE7, 0x9B, 0x96, 0xEB, 0xD0, 0xED, 0x7C, 0x80, 0x96, 0x8C};
+static uint16_t const HDR3x3x3Halves[108] = {
+		0x782A, 0x789E, 0x76F8, 0x3C00, 0x7843, 0x78BD, 0x7734, 0x3C00, 0x7857, 0x78DA, 0x7761, 0x3C00,
+		0x7743, 0x77D4, 0x75D0, 0x3C00, 0x7809, 0x7877, 0x76B2, 0x3C00, 0x7823, 0x7896, 0x76EA, 0x3C00,
+		0x765A, 0x76A7, 0x74B6, 0x3C00, 0x770D, 0x7793, 0x7595, 0x3C00, 0x77D9, 0x7851, 0x7677, 0x3C00,
+		0x7738, 0x77C7, 0x75C5, 0x3C00, 0x7758, 0x77ED, 0x75E8, 0x3C00, 0x7779, 0x780C, 0x760C, 0x3C00,
+		0x7803, 0x7870, 0x76A6, 0x3C00, 0x77C4, 0x7842, 0x765F, 0x3C00, 0x77E5, 0x7858, 0x7683, 0x3C00,
+		0x7702, 0x7787, 0x7589, 0x3C00, 0x76C1, 0x773A, 0x7542, 0x3C00, 0x778E, 0x781B, 0x7624, 0x3C00,
+		0x7640, 0x7688, 0x749C, 0x3C00, 0x765A, 0x76A7, 0x74B6, 0x3C00, 0x7674, 0x76C6, 0x74D7, 0x3C00,
+		0x76ED, 0x776D, 0x7571, 0x3C00, 0x76B0, 0x7720, 0x752A, 0x3C00, 0x76CC, 0x7747, 0x754E, 0x3C00,
+		0x77BA, 0x783A, 0x7653, 0x3C00, 0x7779, 0x780C, 0x760C, 0x3C00, 0x7738, 0x77C7, 0x75C5, 0x3C00
+};
+
+void Check3D(uint8_t const block[16], uint32_t w, uint32_t h, uint32_t d, bool isSRGB, uint32_t const *texels) {
+	uint32_t output[6 * 6 * 6];
+	Image_DecompressASTC3DBlock(block, w, h, d, isSRGB, (uint8_t *) output);
+	CheckKnownAnswer(output, texels, w * h * d);
+}
+
+uint32_t NextRandom(uint32_t& state) {
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+// random blocks for a width x height footprint, every 8th one an error block and the others ones that decode. Random
+// blocks mix partition counts, dual plane and weight grid sizes, so the batch decode sorts them into many groups
+void MakeMixedPartitionBlocks(uint8_t *blocks, uint32_t count, uint32_t width, uint32_t height) {
+	uint32_t state = 0x2545F491;
+	for (uint32_t b = 0; b < count;) {
+		uint8_t *block = blocks + b * 16;
+		for (uint32_t i = 0; i < 16; ++i) {
+			block[i] = (uint8_t) NextRandom(state);
+		}
+		uint32_t texels[12 * 12];
+		Image_DecompressASTCBlock(block, width, height, false, (uint8_t *) texels);
+		bool isError = true;
+		for (uint32_t i = 0; i < width * height; ++i) {
+			isError = isError && texels[i] == 0xFFFF00FF;
+		}
+		if (isError == ((b % 8) == 7)) {
+			++b;
+		}
+	}
+}
+
+} // end anon namespace
+
+TEST_CASE("ASTC HDR endpoint modes", "[gfx_imagedecompress astc]") {
+	CheckKnownAnswerBlocks(HDRVectors, [](uint8_t const *block, uint16_t *output) {
+		Image_DecompressASTCHDRBlock(block, 4, 4, (uint8_t *) output);
+	});
+}
+
+TEST_CASE("ASTC HDR void extent", "[gfx_imagedecompress astc]") {
+	// HDR void extent with every extent bit set, colour is 12.0, 0.5, 100.0, 1.0
+	static uint8_t const block[16] = {
+			0xFC, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+			0x00, 0x4A, 0x00, 0x38, 0x40, 0x56, 0x00, 0x3C
+	};
+	uint16_t output[6 * 6 * 4];
+	Image_DecompressASTCHDRBlock(block, 6, 6, (uint8_t *) output);
+	for (uint32_t i = 0; i < 6 * 6; ++i) {
+		INFO("texel " << i);
+		CHECK(output[i * 4 + 0] == 0x4A00);
+		CHECK(output[i * 4 + 1] == 0x3800);
+		CHECK(output[i * 4 + 2] == 0x5640);
+		CHECK(output[i * 4 + 3] == 0x3C00);
+	}
+}
+
+TEST_CASE("ASTC 3D weight infill", "[gfx_imagedecompress astc]") {
+	Check3D(Infill3x3x3Block, 3, 3, 3, false, Infill3x3x3Texels);
+	Check3D(Infill4x4x4SRGBBlock, 4, 4, 4, true, Infill4x4x4SRGBTexels);
+	Check3D(DualPlane4x3x3Block, 4, 3, 3, false, DualPlane4x3x3Texels);
+}
+
+TEST_CASE("ASTC 3D partitions", "[gfx_imagedecompress astc]") {
+	Check3D(Partitions3x3x3Block, 3, 3, 3, false, Partitions3x3x3Texels);
+	Check3D(Partitions5x4x4Block, 5, 4, 4, false, Partitions5x4x4Texels);
+}
+
+TEST_CASE("ASTC 3D HDR", "[gfx_imagedecompress astc]") {
+	uint16_t output[3 * 3 * 3 * 4];
+	Image_DecompressASTCHDR3DBlock(HDR3x3x3Block, 3, 3, 3, (uint8_t *) output);
+	CheckKnownAnswer(output, HDR3x3x3Halves, 3 * 3 * 3 * 4);
+}
+
+TEST_CASE("ASTC 3D void extent", "[gfx_imagedecompress astc]") {
+	// 3D void extents have no reserved bits, every extent bit set is a constant block
+	// LDR colour is UNORM16 0xFFFF, 0x8000, 0x1234, 0xFFFF
+	static uint8_t const ldrBlock[16] = {
+			0xFC, 0xFD, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+			0xFF, 0xFF, 0x00, 0x80, 0x34, 0x12, 0xFF, 0xFF
+	};
+	uint32_t output[5 * 5 * 5];
+	Image_DecompressASTC3DBlock(ldrBlock, 5, 5, 5, false, (uint8_t *) output);
+	for (uint32_t i = 0; i < 5 * 5 * 5; ++i) {
+		INFO("texel " << i);
+		CHECK(output[i] == 0xFFFF8012);
+	}
+
+	// HDR colour is 12.0, 0.5, 100.0, 1.0
+	static uint8_t const hdrBlock[16] = {
+			0xFC, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+			0x00, 0x4A, 0x00, 0x38, 0x40, 0x56, 0x00, 0x3C
+	};
+	uint16_t halves[5 * 5 * 5 * 4];
+	Image_DecompressASTCHDR3DBlock(hdrBlock, 5, 5, 5, (uint8_t *) halves);
+	for (uint32_t i = 0; i < 5 * 5 * 5; ++i) {
+		INFO("texel " << i);
+		CHECK(halves[i * 4 + 0] == 0x4A00);
+		CHECK(halves[i * 4 + 1] == 0x3800);
+		CHECK(halves[i * 4 + 2] == 0x5640);
+		CHECK(halves[i * 4 + 3] == 0x3C00);
+	}
+}
+
+TEST_CASE("ASTC batch decode matches the block decode on mixed partitions", "[gfx_imagedecompress astc]") {
+	// a batch strip holds 256 blocks, so 300 is a full strip and a partial one
+	static uint32_t const footprints[4][2] = { {4, 4}, {6, 6}, {8, 5}, {12, 12} };
+	static uint8_t blocks[300 * 16];
+	static uint32_t batch[300 * 12 * 12];
+	for (uint32_t f = 0; f < 4; ++f) {
+		uint32_t const width = footprints[f][0];
+		uint32_t const height = footprints[f][1];
+		MakeMixedPartitionBlocks(blocks, 300, width, height);
+		for (uint32_t s = 0; s < 2; ++s) {
+			bool const isSRGB = s == 1;
+			Image_DecompressASTCBlocks(blocks, 300, width, height, isSRGB, (uint8_t *) batch);
+			for (uint32_t b = 0; b < 300; ++b) {
+				INFO(width << "x" << height << (isSRGB ? " sRGB" : " UNORM") << " block " << b);
+				uint32_t single[12 * 12];
+				Image_DecompressASTCBlock(blocks + b * 16, width, height, isSRGB, (uint8_t *) single);
+				CheckKnownAnswer(batch + b * width * height, single, width * height);
+			}
+		}
+	}
+}
+
+TEST_CASE("ASTC HDR error blocks are NaN", "[gfx_imagedecompress astc]") {
+	// block mode 0 is reserved
+	static uint8_t const reservedBlock[16] = {};
+	// HDR void extent whose S and T extents are empty and not all ones
+	static uint8_t const voidExtentBlock[16] = {
+			0xFC, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+			0x00, 0x4A, 0x00, 0x38, 0x40, 0x56, 0x00, 0x3C
+	};
+	uint8_t const *errorBlocks[2] = { reservedBlock, voidExtentBlock };
+	for (uint32_t b = 0; b < 2; ++b) {
+		INFO("block " << b);
+		uint16_t halves[4 * 4 * 4];
+		Image_DecompressASTCHDRBlock(errorBlocks[b], 4, 4, (uint8_t *) halves);
+		for (uint32_t i = 0; i < 4 * 4 * 4; ++i) {
+			CHECK(halves[i] == 0xFFFF);
+		}
+
+		uint16_t volume[3 * 3 * 3 * 4];
+		Image_DecompressASTCHDR3DBlock(errorBlocks[b], 3, 3, 3, (uint8_t *) volume);
+		for (uint32_t i = 0; i < 3 * 3 * 3 * 4; ++i) {
+			CHECK(volume[i] == 0xFFFF);
+		}
+
+		// UNORM to float goes through the HDR profile
+		float floats[4 * 4 * 4];
+		Image_DecompressASTCBlockF(errorBlocks[b], 4, 4, false, floats);
+		for (uint32_t i = 0; i < 4 * 4 * 4; ++i) {
+			CHECK(isnan(floats[i]));
+		}
+	}
+}
+
+TEST_CASE("ASTC UNORM to half image decode matches the HDR block decode", "[gfx_imagedecompress astc]") {
+	// 7 x 5 blocks of 6x6, the last column and row of blocks only partly in the image
+	static uint8_t blocks[35 * 16];
+	MakeMixedPartitionBlocks(blocks, 35, 6, 6);
+	Image_ImageHeader const *src = Image_Create(40, 26, 1, 1, TinyImageFormat_ASTC_6x6_UNORM);
+	REQUIRE(src);
+	REQUIRE(src->dataSize == sizeof(blocks));
+	memcpy(Image_RawDataPtr(src), blocks, sizeof(blocks));
+
+	Image_ImageHeader const *dst = Image_DecompressTo(src, TinyImageFormat_R16G16B16A16_SFLOAT);
+	REQUIRE(dst);
+	uint16_t const *halves = (uint16_t const *) Image_RawDataPtr(dst);
+	for (uint32_t b = 0; b < 35; ++b) {
+		INFO("block " << b);
+		uint16_t single[6 * 6 * 4];
+		Image_DecompressASTCHDRBlock(blocks + b * 16, 6, 6, (uint8_t *) single);
+		uint32_t const bx = (b % 7) * 6;
+		uint32_t const by = (b / 7) * 6;
+		for (uint32_t y = 0; y < 6 && by + y < 26; ++y) {
+			uint32_t const width = (bx + 6 <= 40) ? 6 : 40 - bx;
+			CheckKnownAnswer(halves + ((by + y) * 40 + bx) * 4, single + y * 6 * 4, width * 4);
+		}
+	}
+	Image_Destroy(dst);
+	Image_Destroy(src);
+}
@@ -0,0 +1,433 @@
+#include "al2o3_platform/platform.h"
+#include "al2o3_catch2/catch2.hpp"
+#include "gfx_image/image.h"
+#include "gfx_imagedecompress/imagedecompress.h"
+#include "knownanswers.h"
+#include <math.h>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <xmmintrin.h>
+#define BC6H_TEST_SSE2 1
+#else
+#define BC6H_TEST_SSE2 0
+#endif
+
+// BC6H known answer blocks, expected values are the RGB halves of each texel in order, alpha is always 1.0
+namespace {
+typedef KnownAnswerBlock<uint16_t, 16 * 3> BC6HVector;
+
+static BC6HVector const UFloatVectors[14] = {
+		// mode 1
+		{
+				{0x34, 0xA5, 0xA2, 0x9E, 0x50, 0xF7, 0x96, 0x9E, 0x8E, 0x98, 0xAD, 0x2C, 0xDC, 0x01, 0x9F, 0xAB},
+				{
+						0x2489, 0x26F4, 0x0979, 0x245D, 0x271C, 0x0986, 0x2432, 0x2743, 0x0993, 0x23BF, 0x2659, 0x09A6,
+						0x2432, 0x2743, 0x0993, 0x2355, 0x262E, 0x097B, 0x23BF, 0x2659, 0x09A6, 0x2235, 0x25B8, 0x0905,
+						0x24DF, 0x26CF, 0x0A1C, 0x24DF, 0x26CF, 0x0A1C, 0x2295, 0x25DF, 0x092C, 0x2235, 0x25B8, 0x0905,
+						0x2355, 0x262E, 0x097B, 0x23BF, 0x2659, 0x09A6, 0x22F5, 0x2606, 0x0953, 0x241F, 0x2681, 0x09CE
+				}
+		},
+		// mode 2
+		{
+				{0x45, 0xEE, 0xBA, 0xC4, 0xE7, 0x00, 0x05, 0x76, 0x62, 0xF7, 0x18, 0xF2, 0xAD, 0x82, 0x46, 0x71},
+				{
+						0x53AD, 0x6B4A, 0x59F9, 0x614C, 0x6E8F, 0x5CB2, 0x36EA, 0x6463, 0x5438, 0x36EA, 0x6463, 0x5438,
+						0x0E0C, 0x5A94, 0x4C0C, 0x294B, 0x611E, 0x517F, 0x294B, 0x611E, 0x517F, 0x5F92, 0x5B8C, 0x6C1B,
+						0x614C, 0x6E8F, 0x5CB2, 0x6EEC, 0x71D4, 0x5F6C, 0x5E4D, 0x691C, 0x6334, 0x5FFB, 0x5730, 0x6EF7,
+						0x53AD, 0x6B4A, 0x59F9, 0x5FFB, 0x5730, 0x6EF7, 0x5DE4, 0x6D78, 0x6058, 0x5FFB, 0x5730, 0x6EF7
+				}
+		},
+		// mode 3
+		{
+				{0x82, 0x9C, 0x62, 0x79, 0x97, 0x03, 0x5F, 0x5E, 0x99, 0x0A, 0x03, 0xEF, 0x55, 0x1A, 0x58, 0x6B},
+				{
+						0x4BD5, 0x68F5, 0x77E9, 0x4BD5, 0x68F5, 0x77E9, 0x4C2B, 0x68EA, 0x77B3, 0x4B2B, 0x68A7, 0x7818,
+						0x4B1B, 0x688A, 0x77B4, 0x4B7A, 0x68C0, 0x77CF, 0x4B39, 0x689C, 0x77BD, 0x4C2B, 0x68EA, 0x77B3,
+						0x4B98, 0x68D2, 0x77D8, 0x4B7A, 0x68C0, 0x77CF, 0x4BD5, 0x68F5, 0x77E9, 0x4BC1, 0x68CE, 0x77DD,
+						0x4B39, 0x689C, 0x77BD, 0x4B1B, 0x688A, 0x77B4, 0x4B98, 0x68D2, 0x77D8, 0x4B7A, 0x68C0, 0x77CF
+				}
+		},
+		// mode 4
+		{
+				{0x06, 0x1A, 0x01, 0x8B, 0x70, 0xA8, 0x8E, 0x28, 0x4D, 0x0A, 0x12, 0x9E, 0xE5, 0xB3, 0x77, 0x17},
+				{
+						0x0C9F, 0x5D26, 0x4235, 0x0C9B, 0x5D0F, 0x4237, 0x0C8D, 0x5CC4, 0x423E, 0x0C80, 0x5C7C, 0x4244,
+						0x0CEA, 0x5CE1, 0x422B, 0x0C89, 0x5CAC, 0x4240, 0x0C8D, 0x5CC4, 0x423E, 0x0C80, 0x5C7C, 0x4244,
+						0x0CF8, 0x5C89, 0x41E0, 0x0CEF, 0x5CC2, 0x4210, 0x0CDD, 0x5D36, 0x4273, 0x0C89, 0x5CAC, 0x4240,
+						0x0CEF, 0x5CC2, 0x4210, 0x0CDD, 0x5D36, 0x4273, 0x0CF4, 0x5CA5, 0x41F8, 0x0CFC, 0x5C6C, 0x41C8
+				}
+		},
+		// mode 5
+		{
+				{0xAA, 0xD9, 0x33, 0x75, 0x41, 0xFC, 0x03, 0xCC, 0x47, 0x86, 0x74, 0x3D, 0x65, 0x67, 0xE9, 0xEA},
+				{
+						0x2B5F, 0x6342, 0x0B39, 0x2AF5, 0x6334, 0x0ACE, 0x2B4E, 0x633F, 0x0B27, 0x2AF5, 0x6334, 0x0ACE,
+						0x2B5F, 0x6342, 0x0B39, 0x2B18, 0x6339, 0x0AF1, 0x2B29, 0x633B, 0x0B03, 0x2B51, 0x633B, 0x0BB4,
+						0x2B3C, 0x633D, 0x0B16, 0x2B06, 0x6337, 0x0AE0, 0x2B4E, 0x633F, 0x0B27, 0x2B81, 0x632D, 0x0BF8,
+						0x2AF5, 0x6334, 0x0ACE, 0x2B4E, 0x633F, 0x0B27, 0x2B51, 0x633B, 0x0BB4, 0x2B72, 0x6332, 0x0BE2
+				}
+		},
+		// mode 6
+		{
+				{0x8E, 0x5D, 0xA7, 0x35, 0x9A, 0x3B, 0xE4, 0x68, 0xD9, 0x60, 0x94, 0xAB, 0x2F, 0x8D, 0x8E, 0x34},
+				{
+						0x38D5, 0x510B, 0x43E8, 0x38D5, 0x510B, 0x43E8, 0x3621, 0x5141, 0x40C9, 0x3B6F, 0x5037, 0x43E3,
+						0x3703, 0x512F, 0x41CE, 0x3621, 0x5141, 0x40C9, 0x3A44, 0x501C, 0x44F2, 0x3AA4, 0x5025, 0x449B,
+						0x3692, 0x5138, 0x414B, 0x3947, 0x5103, 0x446B, 0x3A44, 0x501C, 0x44F2, 0x3B0F, 0x502E, 0x443A,
+						0x3775, 0x5126, 0x4251, 0x3AA4, 0x5025, 0x449B, 0x39E4, 0x5013, 0x4549, 0x3C2F, 0x5049, 0x4335
+				}
+		},
+		// mode 7
+		{
+				{0x92, 0x12, 0xC2, 0x9A, 0xD3, 0x62, 0x1E, 0x26, 0x62, 0x86, 0xB3, 0x78, 0x46, 0x31, 0xCD, 0x73},
+				{
+						0x47EE, 0x402E, 0x638A, 0x4D3E, 0x3D85, 0x65FD, 0x49B3, 0x3F4B, 0x645B, 0x4BE7, 0x417F, 0x6904,
+						0x4D3E, 0x3D85, 0x65FD, 0x4BE7, 0x417F, 0x6904, 0x40AA, 0x40AA, 0x6406, 0x4A10, 0x415C, 0x6833,
+						0x40AA, 0x40AA, 0x6406, 0x4BE7, 0x417F, 0x6904, 0x4839, 0x4139, 0x6762, 0x52C0, 0x3AC4, 0x6888,
+						0x4839, 0x4139, 0x6762, 0x5486, 0x39E2, 0x695A, 0x4F35, 0x3C8A, 0x66E6, 0x4D3E, 0x3D85, 0x65FD
+				}
+		},
+		// mode 8
+		{
+				{0x76, 0x20, 0xE0, 0x1A, 0x9D, 0x7A, 0xA6, 0xB4, 0x18, 0xCF, 0x8B, 0xAB, 0x8C, 0x99, 0x65, 0x29},
+				{
+						0x22CC, 0x5B78, 0x45C3, 0x0782, 0x540A, 0x46F6, 0x04A5, 0x58BD, 0x4348, 0x02A2, 0x5C0B, 0x40B1,
+						0x22CC, 0x5B78, 0x45C3, 0x123F, 0x5C5B, 0x4526, 0x3359, 0x5A95, 0x4660, 0x0396, 0x5A7A, 0x41EB,
+						0x068D, 0x559B, 0x45BC, 0x3359, 0x5A95, 0x4660, 0x66D8, 0x57D4, 0x4849, 0x22CC, 0x5B78, 0x45C3,
+						0x01AE, 0x5D9C, 0x3F77, 0x0599, 0x572C, 0x4482, 0x0599, 0x572C, 0x4482, 0x123F, 0x5C5B, 0x4526
+				}
+		},
+		// mode 9
+		{
+				{0x9A, 0x27, 0xBB, 0x7D, 0xA9, 0x9D, 0x00, 0xEF, 0xD4, 0xED, 0x7E, 0xDF, 0xB6, 0xD8, 0x21, 0x9F},
+				{
+						0x1B0E, 0x3A37, 0x6267, 0x1AE2, 0x31A6, 0x5F2E, 0x1BE7, 0x329A, 0x5D11, 0x1AE2, 0x31A6, 0x5F2E,
+						0x18B9, 0x3B10, 0x68C2, 0x18B9, 0x3B10, 0x68C2, 0x1BE7, 0x329A, 0x5D11, 0x201A, 0x3685, 0x5463,
+						0x1A39, 0x3A84, 0x64AC, 0x1979, 0x3ACA, 0x66B7, 0x1F15, 0x3591, 0x567F, 0x2226, 0x386E, 0x502A,
+						0x1C8E, 0x39AB, 0x5E51, 0x17FA, 0x3B56, 0x6ACE, 0x1B0E, 0x3A37, 0x6267, 0x201A, 0x3685, 0x5463
+				}
+		},
+		// mode 10
+		{
+				{0x3E, 0x6C, 0x96, 0x89, 0x86, 0x36, 0x47, 0xBF, 0xA3, 0x8B, 0xBC, 0x79, 0xD4, 0xC4, 0x16, 0xCD},
+				{
+						0x3302, 0x60D8, 0x3820, 0x3302, 0x60D8, 0x3820, 0x3302, 0x60D8, 0x3820, 0x2499, 0x6BDD, 0x694A,
+						0x3302, 0x60D8, 0x3820, 0x2DDD, 0x64C7, 0x49AF, 0x37A4, 0x5D4D, 0x2853, 0x26CF, 0x4CFC, 0x4D97,
+						0x37A4, 0x5D4D, 0x2853, 0x2DDD, 0x64C7, 0x49AF, 0x293B, 0x6852, 0x597D, 0x2A43, 0x5DAA, 0x5BF8,
+						0x40E8, 0x5638, 0x08B8, 0x293B, 0x6852, 0x597D, 0x238A, 0x3D2E, 0x3FF7, 0x26CF, 0x4CFC, 0x4D97
+				}
+		},
+		// mode 11
+		{
+				{0xC3, 0x5C, 0x75, 0x0A, 0x88, 0x11, 0x59, 0x71, 0x09, 0xAD, 0xA1, 0x0C, 0x6C, 0x74, 0x63, 0xD0},
+				{
+						0x5417, 0x2BC5, 0x183E, 0x59E9, 0x1C65, 0x00AA, 0x4713, 0x4E23, 0x4CF2, 0x4B2F, 0x4349, 0x3C4D,
+						0x588A, 0x2003, 0x0636, 0x4B2F, 0x4349, 0x3C4D, 0x4872, 0x4A85, 0x4765, 0x59E9, 0x1C65, 0x00AA,
+						0x4872, 0x4A85, 0x4765, 0x5102, 0x33E9, 0x24B9, 0x5417, 0x2BC5, 0x183E, 0x4FA3, 0x3787, 0x2A45,
+						0x5575, 0x2827, 0x12B2, 0x5102, 0x33E9, 0x24B9, 0x59E9, 0x1C65, 0x00AA, 0x4713, 0x4E23, 0x4CF2
+				}
+		},
+		// mode 12
+		{
+				{0x27, 0x18, 0x12, 0xE9, 0x38, 0x32, 0x4E, 0x58, 0xEB, 0x93, 0xB1, 0xEC, 0xB5, 0xF3, 0xFA, 0xDA},
+				{
+						0x4B20, 0x6174, 0x488C, 0x4DBE, 0x659F, 0x4F0B, 0x4A97, 0x6099, 0x4737, 0x4C44, 0x6345, 0x4B61,
+						0x49FC, 0x5FA3, 0x45B8, 0x4CDF, 0x643C, 0x4CE1, 0x4D24, 0x64A9, 0x4D8B, 0x4DBE, 0x659F, 0x4F0B,
+						0x4B20, 0x6174, 0x488C, 0x4CDF, 0x643C, 0x4CE1, 0x4A97, 0x6099, 0x4737, 0x4E03, 0x660D, 0x4FB5,
+						0x4C9A, 0x63CE, 0x4C36, 0x4E03, 0x660D, 0x4FB5, 0x4C9A, 0x63CE, 0x4C36, 0x4D69, 0x6517, 0x4E36
+				}
+		},
+		// mode 13
+		{
+				{0xAB, 0x34, 0x8E, 0x37, 0xEE, 0x2E, 0x21, 0x1F, 0x49, 0xD7, 0xB6, 0xD7, 0xEE, 0xAB, 0x29, 0x88},
+				{
+						0x4A7A, 0x562F, 0x3795, 0x4A7A, 0x562F, 0x3795, 0x4A43, 0x563D, 0x37F6, 0x49D9, 0x5658, 0x38B2,
+						0x4A54, 0x5639, 0x37D8, 0x49FB, 0x5650, 0x3876, 0x4A43, 0x563D, 0x37F6, 0x49D9, 0x5658, 0x38B2,
+						0x49C4, 0x565E, 0x38D7, 0x49C4, 0x565E, 0x38D7, 0x49FB, 0x5650, 0x3876, 0x4A0C, 0x564B, 0x3858,
+						0x4A21, 0x5646, 0x3832, 0x4A9C, 0x5626, 0x3758, 0x4A32, 0x5642, 0x3814, 0x4A32, 0x5642, 0x3814
+				}
+		},
+		// mode 14
+		{
+				{0xEF, 0xE9, 0x4A, 0xB1, 0x27, 0x1F, 0x1D, 0xE3, 0x34, 0xA6, 0xF2, 0x17, 0xC7, 0x4A, 0x34, 0xFF},
+				{
+						0x3DAA, 0x377F, 0x1CFD, 0x3DAA, 0x377F, 0x1CFD, 0x3DAB, 0x377E, 0x1CFD, 0x3DAB, 0x377D, 0x1CFE,
+						0x3DAA, 0x377F, 0x1CFD, 0x3DAC, 0x377C, 0x1CFF, 0x3DAB, 0x377E, 0x1CFE, 0x3DAA, 0x3780, 0x1CFC,
+						0x3DAB, 0x377E, 0x1CFE, 0x3DAB, 0x377D, 0x1CFF, 0x3DAB, 0x377D, 0x1CFE, 0x3DAA, 0x377F, 0x1CFD,
+						0x3DAA, 0x377F, 0x1CFD, 0x3DAA, 0x377F, 0x1CFD, 0x3DAC, 0x377C, 0x1CFF, 0x3DAC, 0x377C, 0x1CFF
+				}
+		}
+};
+
+static BC6HVector const SFloatVectors[14] = {
+		// mode 1
+		{
+				{0x74, 0xE3, 0x54, 0xFA, 0xD9, 0x53, 0xED, 0x9C, 0x92, 0x5D, 0x52, 0x43, 0xFC, 0x38, 0x65, 0xC0},
+				{
+						0xB795, 0x290D, 0x3D65, 0xB873, 0x2ACA, 0x3C2D, 0xB89F, 0x2B21, 0x3BF0, 0xB795, 0x290D, 0x3D65,
+						0xB7EC, 0x29BB, 0x3CEA, 0xB848, 0x2A73, 0x3C6A, 0xB8CB, 0x2B79, 0x3BB3, 0xB817, 0x2A12, 0x3CAD,
+						0xB567, 0x275B, 0x3E5D, 0xB8CB, 0x2B79, 0x3BB3, 0xB848, 0x2A73, 0x3C6A, 0xB7EC, 0x29BB, 0x3CEA,
+						0xB850, 0x2830, 0x3C7D, 0xB567, 0x275B, 0x3E5D, 0xB567, 0x275B, 0x3E5D, 0xB89F, 0x2B21, 0x3BF0
+				}
+		},
+		// mode 2
+		{
+				{0x55, 0x41, 0x2C, 0xF5, 0x6B, 0xFD, 0xCA, 0x27, 0xB4, 0x37, 0xB9, 0x06, 0x4B, 0x56, 0xC9, 0xA4},
+				{
+						0x0972, 0xC1EF, 0x83E0, 0x03FF, 0xBBAB, 0x007C, 0x0972, 0xF047, 0xA435, 0x3ABB, 0xD833, 0x0AD6,
+						0x1458, 0xCE78, 0x8C98, 0x22C1, 0xE3EA, 0x8C0C, 0x3ABB, 0xD833, 0x0AD6, 0x3ABB, 0xD833, 0x0AD6,
+						0x22C1, 0xE3EA, 0x8C0C, 0x0972, 0xF047, 0xA435, 0x2EBE, 0xDE0F, 0x809B, 0x2EBE, 0xDE0F, 0x809B,
+						0x828B, 0xF623, 0xAFA6, 0x156F, 0xEA6C, 0x98C3, 0x156F, 0xEA6C, 0x98C3, 0x2EBE, 0xDE0F, 0x809B
+				}
+		},
+		// mode 3
+		{
+				{0x22, 0xDA, 0xA1, 0x4E, 0xFE, 0x13, 0x5E, 0x80, 0x12, 0x07, 0x28, 0xA4, 0x23, 0x2F, 0x36, 0xA0},
+				{
+						0xA4C9, 0xD4F2, 0x61C8, 0xA4C9, 0xD4F2, 0x61C8, 0xA3A9, 0xD5CB, 0x6244, 0xA393, 0xD5C2, 0x6237,
+						0xA4D6, 0xD4F2, 0x61C8, 0xA4CD, 0xD4F2, 0x61C8, 0xA34F, 0xD5A7, 0x620F, 0xA34F, 0xD5A7, 0x620F,
+						0xA4DF, 0xD4F2, 0x61C8, 0xA4C9, 0xD4F2, 0x61C8, 0xA34F, 0xD5A7, 0x620F, 0xA33A, 0xD59E, 0x6201,
+						0xA4C4, 0xD4F2, 0x61C8, 0xA4C0, 0xD4F2, 0x61C8, 0xA34F, 0xD5A7, 0x620F, 0xA37D, 0xD5BA, 0x622A
+				}
+		},
+		// mode 4
+		{
+				{0x06, 0x8B, 0xCB, 0x9D, 0xFD, 0xFE, 0x32, 0xD8, 0x30, 0x11, 0xBC, 0x85, 0xEC, 0xFD, 0x92, 0x9F},
+				{
+						0xF174, 0x6EE3, 0xA51D, 0xF174, 0x6EE3, 0xA51D, 0xF1DC, 0x70B4, 0xA4F2, 0xF233, 0x7102, 0xA492,
+						0xF178, 0x6EB7, 0xA51D, 0xF178, 0x6EB7, 0xA51D, 0xF180, 0x7060, 0xA558, 0xF129, 0x7012, 0xA5B8,
+						0xF181, 0x6E69, 0xA51D, 0xF186, 0x6E41, 0xA51D, 0xF180, 0x7060, 0xA558, 0xF1AC, 0x7088, 0xA528,
+						0xF178, 0x6EB7, 0xA51D, 0xF186, 0x6E41, 0xA51D, 0xF1DC, 0x70B4, 0xA4F2, 0xF208, 0x70DB, 0xA4C3
+				}
+		},
+		// mode 5
+		{
+				{0x8A, 0x01, 0x2E, 0xAD, 0x5D, 0xD4, 0x95, 0x3D, 0xD8, 0x48, 0xDF, 0xBB, 0x52, 0xCE, 0xDC, 0x3E},
+				{
+						0x0142, 0x4919, 0xA466, 0x0176, 0x492B, 0xA511, 0x0149, 0x48E2, 0xA4A3, 0x0114, 0x4906, 0xA494,
+						0x0142, 0x4919, 0xA466, 0x0176, 0x492B, 0xA511, 0x0161, 0x4908, 0xA4DD, 0x0157, 0x4922, 0xA451,
+						0x00FE, 0x48FE, 0xA4AA, 0x011D, 0x489C, 0xA43A, 0x0149, 0x48E2, 0xA4A3, 0x00FE, 0x48FE, 0xA4AA,
+						0x0114, 0x4906, 0xA494, 0x0176, 0x492B, 0xA511, 0x01A2, 0x4971, 0xA57A, 0x016E, 0x492A, 0xA43A
+				}
+		},
+		// mode 6
+		{
+				{0xAE, 0x3F, 0x3D, 0xE9, 0xCB, 0x47, 0xD6, 0x4B, 0x77, 0x89, 0xBE, 0xD7, 0xC1, 0x34, 0xCC, 0x20},
+				{
+						0x8320, 0x3879, 0x87E4, 0x8320, 0x3879, 0x87E4, 0x85F4, 0x3678, 0x823B, 0x85F4, 0x3678, 0x823B,
+						0x8421, 0x3676, 0x8930, 0x8320, 0x3879, 0x87E4, 0x81B2, 0x3B56, 0x860E, 0x87DD, 0x37F3, 0x834A,
+						0x83A7, 0x376A, 0x8893, 0x849B, 0x3582, 0x89CD, 0x81B2, 0x3B56, 0x860E, 0x849B, 0x3582, 0x89CD,
+						0x83A7, 0x376A, 0x8893, 0x822C, 0x3A61, 0x86AA, 0x81B2, 0x3B56, 0x860E, 0x822C, 0x3A61, 0x86AA
+				}
+		},
+		// mode 7
+		{
+				{0x52, 0xD5, 0xB6, 0xB9, 0xF2, 0xFE, 0x46, 0xFD, 0x8D, 0x57, 0x47, 0x6C, 0x70, 0xEC, 0xEE, 0x62},
+				{
+						0xCFB5, 0x68DA, 0x58CA, 0xDADD, 0x6E26, 0x619A, 0xCDFC, 0x691C, 0x58A4, 0xBAD2, 0x6295, 0x549D,
+						0xBAD2, 0x6295, 0x549D, 0xCDFC, 0x691C, 0x58A4, 0xDADD, 0x6E26, 0x619A, 0xC789, 0x6666, 0x5728,
+						0xC2FE, 0x6509, 0x563F, 0xDDFF, 0x6F60, 0x63C8, 0xD762, 0x6CC9, 0x5F2E, 0xB6BC, 0x615C, 0x53CC,
+						0xBAD2, 0x6295, 0x549D, 0xDDFF, 0x6F60, 0x63C8, 0xCDFC, 0x691C, 0x58A4, 0xC789, 0x6666, 0x5728
+				}
+		},
+		// mode 8
+		{
+				{0x36, 0xD7, 0xF3, 0x9E, 0x72, 0xD9, 0x0E, 0xC5, 0x6C, 0xE2, 0xCC, 0xD0, 0xEE, 0xC4, 0x4D, 0xD3},
+				{
+						0xBF8B, 0x9CCA, 0x511A, 0xBD6C, 0x9E4D, 0x529D, 0xC35B, 0x9A10, 0x4E60, 0xBD6C, 0x9E4D, 0x529D,
+						0xB99C, 0xA107, 0x5557, 0xB99C, 0xA107, 0x5557, 0xBB84, 0x9FAA, 0x53FA, 0xC93B, 0xAA08, 0x490C,
+						0xC173, 0x9B6D, 0x4FBD, 0xBD6C, 0x9E4D, 0x529D, 0xC93B, 0xAA08, 0x490C, 0xC93B, 0xAA08, 0x490C,
+						0xC173, 0x9B6D, 0x4FBD, 0xC93B, 0xAA08, 0x490C, 0xCB23, 0xAAB7, 0x4724, 0xC93B, 0xAA08, 0x490C
+				}
+		},
+		// mode 9
+		{
+				{0x9A, 0x54, 0x49, 0x4A, 0x16, 0xD0, 0x78, 0x29, 0xE1, 0x6A, 0x37, 0xB6, 0x36, 0x51, 0x07, 0x73},
+				{
+						0xD956, 0xEA3A, 0x26C7, 0xD8CA, 0xE898, 0x2BAF, 0xE91C, 0xE34C, 0x3C8C, 0xE710, 0xE06F, 0x2D6C,
+						0xD8CA, 0xE898, 0x2BAF, 0xE5A0, 0xDE6C, 0x22C8, 0xE5A0, 0xDE6C, 0x22C8, 0xD956, 0xEA3A, 0x26C7,
+						0xD956, 0xEA3A, 0x26C7, 0xE7BF, 0xE163, 0x3277, 0xE5A0, 0xDE6C, 0x22C8, 0xD8CA, 0xE898, 0x2BAF,
+						0xE91C, 0xE34C, 0x3C8C, 0xE4F2, 0xDD78, 0x1DBE, 0xD87D, 0xE7AF, 0x2E68, 0xD8CA, 0xE898, 0x2BAF
+				}
+		},
+		// mode 10
+		{
+				{0xFE, 0xC8, 0x50, 0xD8, 0xA4, 0x4F, 0x69, 0x59, 0x7E, 0x18, 0xCB, 0xA0, 0x04, 0xC3, 0x71, 0x19},
+				{
+						0x0744, 0xCDAD, 0xC8E6, 0x8FBE, 0x9CCA, 0xC1FF, 0x8DFC, 0x1711, 0xA74B, 0x85D0, 0x1D10, 0xB830,
+						0x0744, 0xCDAD, 0xC8E6, 0x122A, 0xE4D6, 0xCC2B, 0x122A, 0xE4D6, 0xCC2B, 0x85D0, 0x1D10, 0xB830,
+						0x83A2, 0xB684, 0xC5A1, 0x1D10, 0xFBFF, 0xCF70, 0xB070, 0x28B0, 0xB830, 0x85D0, 0x1D10, 0xB830,
+						0xB070, 0x28B0, 0xB830, 0x0744, 0xCDAD, 0xC8E6, 0xA58A, 0x1187, 0xBB75, 0x1D10, 0xFBFF, 0xCF70
+				}
+		},
+		// mode 11
+		{
+				{0xE3, 0x7C, 0xC2, 0x16, 0x13, 0xFF, 0x9C, 0xE9, 0xD4, 0x2C, 0x20, 0x3C, 0xD4, 0x6E, 0xB1, 0x91},
+				{
+						0x8658, 0x58BE, 0x623C, 0x8737, 0x3D69, 0x6EC5, 0x8724, 0x3FCA, 0x6DAE, 0x8658, 0x58BE, 0x623C,
+						0x862D, 0x5E17, 0x5FC9, 0x8658, 0x58BE, 0x623C, 0x8724, 0x3FCA, 0x6DAE, 0x866B, 0x565D, 0x6353,
+						0x867F, 0x53FD, 0x646A, 0x8737, 0x3D69, 0x6EC5, 0x874F, 0x3A71, 0x7022, 0x86AA, 0x4EA4, 0x66DE,
+						0x8640, 0x5BB6, 0x60E0, 0x8710, 0x422A, 0x6C97, 0x8640, 0x5BB6, 0x60E0, 0x86E5, 0x4783, 0x6A23
+				}
+		},
+		// mode 12
+		{
+				{0x67, 0xD2, 0x5C, 0x3D, 0x68, 0x1D, 0xDF, 0x8D, 0xB2, 0x06, 0xBC, 0xF8, 0x24, 0x80, 0xB1, 0x8A},
+				{
+						0xACE3, 0xA5C8, 0x01F3, 0xB3A3, 0x919A, 0x90C2, 0xB057, 0x9B75, 0x879F, 0xAC42, 0xA7A8, 0x03B1,
+						0xB444, 0x8FBA, 0x9280, 0xB3A3, 0x919A, 0x90C2, 0xB199, 0x97B4, 0x8B1A, 0xB64F, 0x89A0, 0x9828,
+						0xAEED, 0x9FAE, 0x83B4, 0xADAB, 0xA36F, 0x8039, 0xAC42, 0xA7A8, 0x03B1, 0xB199, 0x97B4, 0x8B1A,
+						0xACE3, 0xA5C8, 0x01F3, 0xB3A3, 0x919A, 0x90C2, 0xB302, 0x937B, 0x8F04, 0xB199, 0x97B4, 0x8B1A
+				}
+		},
+		// mode 13
+		{
+				{0x2B, 0x39, 0xE5, 0xCC, 0x85, 0x76, 0x34, 0x80, 0x0E, 0x35, 0x91, 0xE6, 0x59, 0x53, 0xD1, 0xA2},
+				{
+						0x5856, 0xE2EF, 0xCF1A, 0x59B3, 0xE04C, 0xCF1A, 0x58BF, 0xE225, 0xCF1A, 0x591C, 0xE171, 0xCF1A,
+						0x5984, 0xE0A6, 0xCF1A, 0x57F9, 0xE3A4, 0xCF1A, 0x5885, 0xE295, 0xCF1A, 0x56F9, 0xE594, 0xCF1A,
+						0x57F9, 0xE3A4, 0xCF1A, 0x58BF, 0xE225, 0xCF1A, 0x591C, 0xE171, 0xCF1A, 0x58BF, 0xE225, 0xCF1A,
+						0x5984, 0xE0A6, 0xCF1A, 0x5733, 0xE523, 0xCF1A, 0x594A, 0xE117, 0xCF1A, 0x57BF, 0xE415, 0xCF1A
+				}
+		},
+		// mode 14
+		{
+				{0xAF, 0x66, 0xD1, 0x0E, 0xDF, 0xC3, 0x1F, 0xF7, 0x22, 0x04, 0x5C, 0x5A, 0x04, 0x98, 0x48, 0x3E},
+				{
+						0x9BE4, 0x8DEB, 0x77AA, 0x9BE5, 0x8DEB, 0x77AA, 0x9BE5, 0x8DEC, 0x77A9, 0x9BE4, 0x8DEB, 0x77AA,
+						0x9BE8, 0x8DED, 0x77A8, 0x9BE6, 0x8DEC, 0x77A9, 0x9BE7, 0x8DEC, 0x77A9, 0x9BE6, 0x8DEC, 0x77A9,
+						0x9BE5, 0x8DEC, 0x77A9, 0x9BE4, 0x8DEB, 0x77AA, 0x9BE7, 0x8DEC, 0x77A9, 0x9BE7, 0x8DEC, 0x77A9,
+						0x9BE7, 0x8DEC, 0x77A9, 0x9BE5, 0x8DEC, 0x77A9, 0x9BE9, 0x8DED, 0x77A8, 0x9BE5, 0x8DEB, 0x77AA
+				}
+		}
+};
+
+static BC6HVector const SFloatEdgeVectors[3] = {
+		// mode 2, interpolated values that scale to 0 are +0
+		{
+				{0xA2, 0x43, 0xF2, 0xFF, 0x9F, 0x4E, 0x65, 0x7E, 0xB7, 0x21, 0xDE, 0x1D, 0x78, 0x25, 0x33, 0x01},
+				{
+						0x40E8, 0x785D, 0x8062, 0x41A9, 0x788F, 0x0000, 0x4160, 0x78F5, 0x8053, 0x41CC, 0x785F, 0x0026,
+						0x415A, 0x7891, 0x803F, 0x4192, 0x78AB, 0x802E, 0x4038, 0x780B, 0x8099, 0x4160, 0x78F5, 0x8053,
+						0x4070, 0x7825, 0x8087, 0x40AA, 0x783F, 0x8076, 0x40AA, 0x783F, 0x8076, 0x415A, 0x7891, 0x803F,
+						0x40E8, 0x785D, 0x8062, 0x4121, 0x7877, 0x8051, 0x4192, 0x78AB, 0x802E, 0x4192, 0x78AB, 0x802E
+				}
+		},
+		// mode 13, interpolated values that scale to 0 are +0
+		{
+				{0xEB, 0x7F, 0x00, 0x04, 0xB0, 0xD8, 0x01, 0x1A, 0xFF, 0xCA, 0xDC, 0x07, 0x1A, 0x5E, 0xC1, 0x62},
+				{
+						0x0090, 0x0069, 0x3FA0, 0x014D, 0x00E0, 0x414C, 0x00D8, 0x0097, 0x4044, 0x0104, 0x00B3, 0x40A9,
+						0x0104, 0x00B3, 0x40A9, 0x011A, 0x00C0, 0x40DB, 0x0090, 0x0069, 0x3FA0, 0x8017, 0x0000, 0x3E26,
+						0x00D8, 0x0097, 0x4044, 0x0000, 0x000E, 0x3E59, 0x0136, 0x00D3, 0x411A, 0x005D, 0x0049, 0x3F2F,
+						0x0000, 0x000E, 0x3E59, 0x0104, 0x00B3, 0x40A9, 0x001B, 0x001F, 0x3E98, 0x007A, 0x005B, 0x3F6E
+				}
+		},
+		// mode 14, a -32768 endpoint finishes as the most negative finite half
+		{
+				{0x0F, 0x80, 0x00, 0x04, 0x80, 0x00, 0x8A, 0x83, 0xCC, 0x0F, 0xEB, 0x39, 0xF5, 0x2C, 0x76, 0x0C},
+				{
+						0xFBFF, 0xDCFF, 0x07C4, 0xFBFF, 0xDCFF, 0x07C7, 0xFBFF, 0xDCFF, 0x07C8, 0xFBFF, 0xDCFF, 0x07C1,
+						0xFBFF, 0xDCFF, 0x07C6, 0xFBFF, 0xDCFF, 0x07C8, 0xFBFF, 0xDCFF, 0x07C5, 0xFBFF, 0xDCFF, 0x07C2,
+						0xFBFF, 0xDCFF, 0x07C3, 0xFBFF, 0xDCFF, 0x07C8, 0xFBFF, 0xDCFF, 0x07C7, 0xFBFF, 0xDCFF, 0x07C2,
+						0xFBFF, 0xDCFF, 0x07C4, 0xFBFF, 0xDCFF, 0x07C4, 0xFBFF, 0xDCFF, 0x07C7, 0xFBFF, 0xDCFF, 0x07C1
+				}
+		}
+};
+
+template<bool Signed>
+void DecompressRGB(uint8_t const *block, uint16_t *rgb) {
+	uint16_t output[4 * 4 * 4];
+	if (Signed) {
+		Image_DecompressDXBC6HSFloatBlock(block, (uint8_t *) output);
+	} else {
+		Image_DecompressDXBC6HUFloatBlock(block, (uint8_t *) output);
+	}
+	for (uint32_t i = 0; i < 16; ++i) {
+		CHECK(output[i * 4 + 3] == 0x3C00);
+		rgb[i * 3 + 0] = output[i * 4 + 0];
+		rgb[i * 3 + 1] = output[i * 4 + 1];
+		rgb[i * 3 + 2] = output[i * 4 + 2];
+	}
+}
+
+#if BC6H_TEST_SSE2
+// exact half to float, written apart from the library's conversions
+float HalfToFloatReference(uint16_t h) {
+	int const exponent = (h >> 10) & 0x1F;
+	int const mantissa = h & 0x3FF;
+	float const magnitude = exponent ? ldexpf((float) (0x400 | mantissa), exponent - 25) : ldexpf((float) mantissa, -24);
+	return (h & 0x8000) ? -magnitude : magnitude;
+}
+
+// decodes to float with denormals flushed on input (DAZ, MXCSR bit 6) and output (FTZ, bit 15)
+template<bool Signed, size_t Count>
+void CheckFloatsWithDenormalsFlushed(BC6HVector const (&vectors)[Count]) {
+	for (size_t v = 0; v < Count; ++v) {
+		INFO("vector " << v);
+		float output[4 * 4 * 4];
+		unsigned int const csr = _mm_getcsr();
+		_mm_setcsr(csr | 0x8040);
+		if (Signed) {
+			Image_DecompressDXBC6HSFloatBlockF(vectors[v].block, output);
+		} else {
+			Image_DecompressDXBC6HUFloatBlockF(vectors[v].block, output);
+		}
+		_mm_setcsr(csr);
+
+		float expected[4 * 4 * 4];
+		for (uint32_t i = 0; i < 16; ++i) {
+			expected[i * 4 + 0] = HalfToFloatReference(vectors[v].expected[i * 3 + 0]);
+			expected[i * 4 + 1] = HalfToFloatReference(vectors[v].expected[i * 3 + 1]);
+			expected[i * 4 + 2] = HalfToFloatReference(vectors[v].expected[i * 3 + 2]);
+			expected[i * 4 + 3] = 1.0f;
+		}
+		CheckKnownAnswer(output, expected, 4 * 4 * 4);
+	}
+}
+#endif
+
+} // end anon namespace
+
+// vectors are in mode order
+TEST_CASE("BC6H unsigned every mode", "[gfx_imagedecompress bc6h]") {
+	CheckKnownAnswerBlocks(UFloatVectors, DecompressRGB<false>);
+}
+
+TEST_CASE("BC6H signed every mode", "[gfx_imagedecompress bc6h]") {
+	CheckKnownAnswerBlocks(SFloatVectors, DecompressRGB<true>);
+}
+
+TEST_CASE("BC6H signed zero and minimum endpoint", "[gfx_imagedecompress bc6h]") {
+	CheckKnownAnswerBlocks(SFloatEdgeVectors, DecompressRGB<true>);
+}
+
+#if BC6H_TEST_SSE2
+TEST_CASE("BC6H float output keeps half denormals under DAZ and FTZ", "[gfx_imagedecompress bc6h]") {
+	CheckFloatsWithDenormalsFlushed<false>(UFloatVectors);
+	CheckFloatsWithDenormalsFlushed<true>(SFloatVectors);
+	CheckFloatsWithDenormalsFlushed<true>(SFloatEdgeVectors);
+}
+#endif
+
+TEST_CASE("BC6H reserved modes are opaque black", "[gfx_imagedecompress bc6h]") {
+	static uint8_t const reservedHeaders[4] = { 0x13, 0x17, 0x1B, 0x1F };
+	for (uint32_t r = 0; r < 4; ++r) {
+		uint8_t block[16];
+		memset(block, 0xA5, sizeof(block));
+		block[0] = (uint8_t) ((block[0] & ~0x1F) | reservedHeaders[r]);
+
+		uint16_t output[4 * 4 * 4];
+		Image_DecompressDXBC6HUFloatBlock(block, (uint8_t *) output);
+		for (uint32_t i = 0; i < 16; ++i) {
+			CHECK(output[i * 4 + 0] == 0);
+			CHECK(output[i * 4 + 1] == 0);
+			CHECK(output[i * 4 + 2] == 0);
+			CHECK(output[i * 4 + 3] == 0x3C00);
+		}
+		Image_DecompressDXBC6HSFloatBlock(block, (uint8_t *) output);
+		for (uint32_t i = 0; i < 16; ++i) {
+			CHECK(output[i * 4 + 0] == 0);
+			CHECK(output[i * 4 + 3] == 0x3C00);
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#include "al2o3_platform/platform.h"
+#include "al2o3_catch2/catch2.hpp"
+#include "gfx_image/image.h"
+#include "gfx_imagedecompress/imagedecompress.h"
+#include "knownanswers.h"
+
+// the strip decoder buckets blocks by mode, every byte it writes has to match decoding each block on its own
+namespace {
+uint32_t NextRandom(uint32_t& state) {
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+// random blocks of random modes, mode 8 is the reserved encoding with no mode bit
+void MakeMixedModeBlocks(uint8_t *blocks, uint32_t count) {
+	uint32_t state = 0x2545F491;
+	for (uint32_t b = 0; b < count; ++b) {
+		for (uint32_t i = 0; i < 16; ++i) {
+			blocks[b * 16 + i] = (uint8_t) NextRandom(state);
+		}
+		uint32_t const mode = NextRandom(state) % 9;
+		uint32_t const modeMask = (2u << mode) - 1;
+		blocks[b * 16] = (uint8_t) ((blocks[b * 16] & ~modeMask) | ((1u << mode) & 0xFF));
+	}
+}
+
+} // end anon namespace
+
+TEST_CASE("BC7 strip decode matches the block decode on mixed modes", "[gfx_imagedecompress bc7]") {
+	// a strip holds 256 blocks, so 600 is two full strips and a partial one
+	static uint32_t const blockCounts[3] = { 1, 37, 600 };
+	static uint8_t blocks[600 * 16];
+	static uint8_t strip[600 * 4 * 4 * sizeof(uint32_t)];
+	MakeMixedModeBlocks(blocks, 600);
+
+	for (uint32_t c = 0; c < 3; ++c) {
+		uint32_t const blockCount = blockCounts[c];
+		memset(strip, 0xCD, sizeof(strip));
+		Image_DecompressDXBC7Blocks(blocks, blockCount, strip);
+		for (uint32_t b = 0; b < blockCount; ++b) {
+			INFO("block count " << blockCount << " block " << b << " first byte " << (int) blocks[b * 16]);
+			uint8_t single[4 * 4 * sizeof(uint32_t)];
+			Image_DecompressDXBC7Block(blocks + b * 16, single);
+			CheckKnownAnswer(strip + b * sizeof(single), single, sizeof(single));
+		}
+	}
+}
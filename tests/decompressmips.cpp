@@ -0,0 +1,154 @@
+#include "al2o3_platform/platform.h"
+#include "al2o3_catch2/catch2.hpp"
+#include "gfx_image/image.h"
+#include "gfx_imagedecompress/imagedecompress.h"
+#include "knownanswers.h"
+#include "al2o3_enki/TaskScheduler_c.h"
+#include <math.h>
+
+namespace {
+// a BC1 block of white (index 0), black (1), 170 grey (2) and 85 grey (3). Its 2x2 quads hold one, two and three
+// whites with blacks and white, 170, 85 and black
+static uint8_t const GreyQuadsBlock[8] = { 0xFF, 0xFF, 0x00, 0x00, 0x04, 0x55, 0x80, 0x74 };
+
+// level 1 then level 2 as B8G8R8A8, each grey with opaque alpha
+static uint32_t const GreyQuadsUNormMips[5] = { 0xFF404040, 0xFF808080, 0xFFBFBFBF, 0xFF808080, 0xFF808080 };
+// averaged in linear, one white and three blacks are 0.25 linear
+static uint32_t const GreyQuadsSRGBMips[5] = { 0xFF898989, 0xFFBCBCBC, 0xFFE1E1E1, 0xFFA4A4A4, 0xFFB6B6B6 };
+
+void CheckGreyQuadMips(TinyImageFormat format, uint32_t const *expected) {
+	Image_ImageHeader const *src = Image_Create(4, 4, 1, 1, format);
+	REQUIRE(src);
+	memcpy(Image_RawDataPtr(src), GreyQuadsBlock, sizeof(GreyQuadsBlock));
+
+	Image_ImageHeader const *mips[3];
+	REQUIRE(Image_DecompressWithMips(src, 3, mips) == 3);
+	CHECK(mips[1]->width == 2);
+	CHECK(mips[1]->height == 2);
+	CHECK(mips[2]->width == 1);
+	CHECK(mips[2]->height == 1);
+	CheckKnownAnswer((uint32_t const *) Image_RawDataPtr(mips[1]), expected, 4);
+	CheckKnownAnswer((uint32_t const *) Image_RawDataPtr(mips[2]), expected + 4, 1);
+	for (uint32_t i = 0; i < 3; ++i) {
+		Image_Destroy(mips[i]);
+	}
+	Image_Destroy(src);
+}
+
+double SRGBToLinearReference(double c) {
+	return c <= 0.04045 ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+}
+
+double LinearToSRGBReference(double l) {
+	return l <= 0.0031308 ? l * 12.92 : 1.055 * pow(l, 1.0 / 2.4) - 0.055;
+}
+
+// one level reduced from the whole of the level above, the last row or column of an odd sized level is dropped
+Image_ImageHeader const *ReduceReference(Image_ImageHeader const *src, uint32_t channels, bool isSRGB) {
+	uint32_t const width = (src->width > 1) ? src->width >> 1 : 1;
+	uint32_t const height = (src->height > 1) ? src->height >> 1 : 1;
+	Image_ImageHeader const *dst = Image_Create(width, height, 1, src->slices, src->format);
+	uint8_t const *in = (uint8_t const *) Image_RawDataPtr(src);
+	uint8_t *out = (uint8_t *) Image_RawDataPtr(dst);
+	for (uint32_t w = 0; w < src->slices; ++w) {
+		for (uint32_t y = 0; y < height; ++y) {
+			for (uint32_t x = 0; x < width; ++x) {
+				uint32_t const sx[2] = { 2 * x, (src->width > 1) ? 2 * x + 1 : 0 };
+				uint32_t const sy[2] = { 2 * y, (src->height > 1) ? 2 * y + 1 : 0 };
+				for (uint32_t c = 0; c < channels; ++c) {
+					uint32_t texels[4];
+					for (uint32_t i = 0; i < 4; ++i) {
+						texels[i] = in[Image_CalculateIndex(src, sx[i & 1], sy[i >> 1], 0, w) * channels + c];
+					}
+					uint8_t *o = out + Image_CalculateIndex(dst, x, y, 0, w) * channels + c;
+					if (isSRGB && c < 3) {
+						double linear = 0.0;
+						for (uint32_t i = 0; i < 4; ++i) {
+							linear += SRGBToLinearReference(texels[i] / 255.0);
+						}
+						*o = (uint8_t) floor(LinearToSRGBReference(linear * 0.25) * 255.0 + 0.5);
+					} else {
+						*o = (uint8_t) ((texels[0] + texels[1] + texels[2] + texels[3] + 2) / 4);
+					}
+				}
+			}
+		}
+	}
+	return dst;
+}
+
+// random blocks decoded with their whole mip chain, serially and through the scheduler, against decoding the
+// image and reducing it a level at a time
+void CheckMipsMatchReference(TinyImageFormat format,
+														 uint32_t width,
+														 uint32_t height,
+														 uint32_t slices,
+														 uint32_t channels,
+														 bool isSRGB) {
+	Image_ImageHeader const *src = Image_Create(width, height, 1, slices, format);
+	REQUIRE(src);
+	uint32_t state = 0x2545F491 + width * 131 + height;
+	uint8_t *blocks = (uint8_t *) Image_RawDataPtr(src);
+	for (size_t i = 0; i < src->dataSize; ++i) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		blocks[i] = (uint8_t) state;
+	}
+
+	Image_ImageHeader const *reference[16];
+	uint32_t referenceCount = 1;
+	reference[0] = Image_Decompress(src);
+	REQUIRE(reference[0]);
+	while (reference[referenceCount - 1]->width > 1 || reference[referenceCount - 1]->height > 1) {
+		reference[referenceCount] = ReduceReference(reference[referenceCount - 1], channels, isSRGB);
+		referenceCount++;
+	}
+
+	enkiTaskSchedulerHandle scheduler = enkiNewTaskScheduler();
+	enkiInitTaskSchedulerNumThreads(scheduler, 4);
+	for (uint32_t threaded = 0; threaded < 2; ++threaded) {
+		Image_ImageHeader const *mips[16];
+		uint32_t const mipCount = threaded ? ImageDecompressWithMipsWithEnki(src, 16, mips, scheduler) :
+																				 Image_DecompressWithMips(src, 16, mips);
+		REQUIRE(mipCount == referenceCount);
+		for (uint32_t l = 0; l < mipCount; ++l) {
+			INFO("threaded " << threaded << " level " << l);
+			REQUIRE(mips[l]->width == reference[l]->width);
+			REQUIRE(mips[l]->height == reference[l]->height);
+			REQUIRE(mips[l]->dataSize == reference[l]->dataSize);
+			CheckKnownAnswer((uint8_t const *) Image_RawDataPtr(mips[l]),
+											 (uint8_t const *) Image_RawDataPtr(reference[l]),
+											 mips[l]->dataSize);
+			Image_Destroy(mips[l]);
+		}
+	}
+	enkiDeleteTaskScheduler(scheduler);
+
+	for (uint32_t l = 0; l < referenceCount; ++l) {
+		Image_Destroy(reference[l]);
+	}
+	Image_Destroy(src);
+}
+
+} // end anon namespace
+
+TEST_CASE("Mip box filter of 2x2 quads", "[gfx_imagedecompress mips]") {
+	CheckGreyQuadMips(TinyImageFormat_DXBC1_RGB_UNORM, GreyQuadsUNormMips);
+	CheckGreyQuadMips(TinyImageFormat_DXBC1_RGB_SRGB, GreyQuadsSRGBMips);
+}
+
+TEST_CASE("Mip chain matches reducing a level at a time", "[gfx_imagedecompress mips]") {
+	// whole tiles, 4 fused levels and a merged tail
+	CheckMipsMatchReference(TinyImageFormat_DXBC7_UNORM, 128, 64, 1, 4, false);
+	CheckMipsMatchReference(TinyImageFormat_DXBC7_SRGB, 128, 64, 1, 4, true);
+	// partial tiles, odd levels and the merge pass reading a level made of several tiles' texels
+	CheckMipsMatchReference(TinyImageFormat_DXBC7_UNORM, 100, 68, 2, 4, false);
+	CheckMipsMatchReference(TinyImageFormat_DXBC1_RGB_SRGB, 200, 36, 1, 4, true);
+	CheckMipsMatchReference(TinyImageFormat_DXBC4_UNORM, 92, 20, 1, 1, false);
+	CheckMipsMatchReference(TinyImageFormat_DXBC5_UNORM, 76, 140, 1, 2, false);
+	// 5x5 blocks, tiles of 80 texels
+	CheckMipsMatchReference(TinyImageFormat_ASTC_5x5_SRGB, 170, 95, 1, 4, true);
+	// a single row of blocks
+	CheckMipsMatchReference(TinyImageFormat_DXBC7_UNORM, 260, 3, 1, 4, false);
+}
@@ -0,0 +1,138 @@
+#include "al2o3_platform/platform.h"
+#include "al2o3_catch2/catch2.hpp"
+#include "gfx_image/image.h"
+#include "gfx_imagedecompress/imagedecompress.h"
+#include "knownanswers.h"
+#include <math.h>
+
+// in decompressstore.cpp
+extern void PremultiplyBGRA8(uint8_t *decoded, uint32_t texelCount);
+extern void PremultiplySRGBA8(uint8_t *decoded, uint32_t texelCount);
+
+// the premultiply kernels against references that do the arithmetic the slow way, normal map Z against known answers
+namespace {
+double SRGBToLinearReference(double c) {
+	return c <= 0.04045 ? c / 12.92 : pow((c + 0.055) / 1.055, 2.4);
+}
+
+double LinearToSRGBReference(double l) {
+	return l <= 0.0031308 ? l * 12.92 : 1.055 * pow(l, 1.0 / 2.4) - 0.055;
+}
+
+// every colour value against every alpha, each texel has 3 different colour values so all 3 lanes are checked.
+// 65536 texels is a multiple of 4, the extra 3 go down the scalar tail
+void MakeEveryColourAlphaPair(uint8_t *texels, uint32_t texelCount) {
+	for (uint32_t i = 0; i < texelCount; ++i) {
+		uint32_t const c = i & 0xFF;
+		texels[i * 4 + 0] = (uint8_t) c;
+		texels[i * 4 + 1] = (uint8_t) (c ^ 0x5A);
+		texels[i * 4 + 2] = (uint8_t) (255 - c);
+		texels[i * 4 + 3] = (uint8_t) ((i >> 8) & 0xFF);
+	}
+}
+
+static uint32_t const TexelCount = 65536 + 3;
+
+// X and Y normal map blocks and the XYZ * 0.5 + 0.5 they store as R8G8B8, z is 0 wherever x^2 + y^2 > 1
+static KnownAnswerBlock<uint8_t, 48> const BC5NormalVectors[2] = {
+		// x from 0.25 to -0.18, y from -0.5 to 1
+		{ { 0xA0, 0x60, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA, 0x40, 0xC0, 0x98, 0xC3, 0xAB, 0x98, 0xC3, 0xAB },
+			{ 160, 64, 233, 96, 115, 250, 151, 0, 128, 142, 192, 237, 133, 141, 254, 123, 255, 128, 114, 90, 249, 105, 166, 247,
+				160, 64, 233, 96, 115, 250, 151, 0, 128, 142, 192, 237, 133, 141, 254, 123, 255, 128, 114, 90, 249, 105, 166, 247 } },
+		// x and y both 0.73, clamped though neither is at an end of the range
+		{ { 0xDD, 0xDD, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xDD, 0xDD, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 },
+			{ 221, 221, 128, 221, 221, 128, 221, 221, 128, 221, 221, 128, 221, 221, 128, 221, 221, 128, 221, 221, 128, 221, 221, 128,
+				221, 221, 128, 221, 221, 128, 221, 221, 128, 221, 221, 128, 221, 221, 128, 221, 221, 128, 221, 221, 128, 221, 221, 128 } },
+};
+static float const BC5NormalZ[2][16] = {
+		{ 0.828843713f, 0.96402818f, 0.0f, 0.855072737f, 0.993442535f, 0.0f, 0.949886203f, 0.936844647f,
+			0.828843713f, 0.96402818f, 0.0f, 0.855072737f, 0.993442535f, 0.0f, 0.949886203f, 0.936844647f },
+		{ 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f },
+};
+
+// x from 0.65 to 1, y from -0.93 to 0.88
+static KnownAnswerBlock<uint8_t, 48> const EACNormalVectors[1] = {
+		{ { 0xFF, 0xF0, 0x05, 0x39, 0x77, 0x05, 0x39, 0x77, 0x80, 0x80, 0x0F, 0x19, 0xD5, 0x0F, 0x19, 0xD5 },
+			{ 210, 104, 222, 255, 144, 128, 210, 104, 222, 255, 144, 128, 165, 8, 154, 255, 240, 128, 165, 8, 154, 255, 240, 128,
+				120, 192, 237, 255, 56, 128, 120, 192, 237, 255, 56, 128, 30, 80, 195, 255, 168, 128, 30, 80, 195, 255, 168, 128 } },
+};
+static float const EACNormalZ[1][16] = {
+		{ 0.741597593f, 0.0f, 0.741597593f, 0.0f, 0.205575541f, 0.0f, 0.205575541f, 0.0f,
+			0.861358523f, 0.0f, 0.861358523f, 0.0f, 0.53146261f, 0.0f, 0.53146261f, 0.0f },
+};
+
+// a single block 4x4 image decoded as a normal map into output
+void DecodeNormalBlock(TinyImageFormat format, uint8_t const *block, TinyImageFormat dstFormat, void *output) {
+	Image_ImageHeader const *src = Image_Create(4, 4, 1, 1, format);
+	REQUIRE(src);
+	memcpy(Image_RawDataPtr(src), block, 16);
+	Image_ImageHeader const *dst = Image_DecompressNormalMap(src, dstFormat);
+	REQUIRE(dst);
+	memcpy(output, Image_RawDataPtr(dst), dst->dataSize);
+	Image_Destroy(dst);
+	Image_Destroy(src);
+}
+
+template<size_t Count>
+void CheckNormalBlocks(TinyImageFormat format,
+											 KnownAnswerBlock<uint8_t, 48> const (&vectors)[Count],
+											 float const (&z)[Count][16]) {
+	CheckKnownAnswerBlocks(vectors, [format](uint8_t const *block, uint8_t *output) {
+		DecodeNormalBlock(format, block, TinyImageFormat_R8G8B8_UNORM, output);
+	});
+	for (size_t v = 0; v < Count; ++v) {
+		float output[16 * 3];
+		DecodeNormalBlock(format, vectors[v].block, TinyImageFormat_R32G32B32_SFLOAT, output);
+		for (uint32_t i = 0; i < 16; ++i) {
+			INFO("vector " << v << " texel " << i);
+			CHECK(output[i * 3 + 2] == Approx(z[v][i]).margin(1e-6));
+		}
+	}
+}
+
+} // end anon namespace
+
+TEST_CASE("Premultiply UNORM matches the rounded product", "[gfx_imagedecompress premultiply]") {
+	static uint8_t texels[TexelCount * 4];
+	MakeEveryColourAlphaPair(texels, TexelCount);
+	static uint8_t expected[TexelCount * 4];
+	for (uint32_t i = 0; i < TexelCount; ++i) {
+		uint32_t const alpha = texels[i * 4 + 3];
+		for (uint32_t c = 0; c < 3; ++c) {
+			// c * a / 255 is never halfway between two integers, as 255 is odd
+			expected[i * 4 + c] = (uint8_t) ((2 * texels[i * 4 + c] * alpha + 255) / 510);
+		}
+		expected[i * 4 + 3] = (uint8_t) alpha;
+	}
+
+	PremultiplyBGRA8(texels, TexelCount);
+	for (uint32_t i = 0; i < TexelCount; ++i) {
+		INFO("texel " << i << " alpha " << (int) expected[i * 4 + 3]);
+		CheckKnownAnswer(texels + i * 4, expected + i * 4, 4);
+	}
+}
+
+TEST_CASE("Premultiply sRGB matches a round trip through linear", "[gfx_imagedecompress premultiply]") {
+	static uint8_t texels[TexelCount * 4];
+	MakeEveryColourAlphaPair(texels, TexelCount);
+	static uint8_t expected[TexelCount * 4];
+	for (uint32_t i = 0; i < TexelCount; ++i) {
+		uint32_t const alpha = texels[i * 4 + 3];
+		for (uint32_t c = 0; c < 3; ++c) {
+			double const linear = SRGBToLinearReference(texels[i * 4 + c] / 255.0) * alpha / 255.0;
+			expected[i * 4 + c] = (uint8_t) floor(LinearToSRGBReference(linear) * 255.0 + 0.5);
+		}
+		expected[i * 4 + 3] = (uint8_t) alpha;
+	}
+
+	PremultiplySRGBA8(texels, TexelCount);
+	for (uint32_t i = 0; i < TexelCount; ++i) {
+		INFO("texel " << i << " alpha " << (int) expected[i * 4 + 3]);
+		CheckKnownAnswer(texels + i * 4, expected + i * 4, 4);
+	}
+}
+
+TEST_CASE("Normal map Z of BC5 and EAC RG11", "[gfx_imagedecompress normal]") {
+	CheckNormalBlocks(TinyImageFormat_DXBC5_UNORM, BC5NormalVectors, BC5NormalZ);
+	CheckNormalBlocks(TinyImageFormat_ETC2_EAC_R11G11_UNORM, EACNormalVectors, EACNormalZ);
+}
@@ -0,0 +1,238 @@
+#include "al2o3_platform/platform.h"
+#include "al2o3_catch2/catch2.hpp"
+#include "gfx_image/image.h"
+#include "gfx_imagedecompress/imagedecompress.h"
+#include "knownanswers.h"
+
+// BC4 SNORM known answers, the -128 endpoint decodes as -127 but the ramp mode is chosen by the encoded values
+namespace {
+static KnownAnswerBlock<int8_t, 16> const SignedBC4Vectors[6] = {
+		// 127 and -128, eight values
+		{ { 0x7F, 0x80, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA },
+			{ 127, -127, 91, 54, 18, -18, -54, -91, 127, -127, 91, 54, 18, -18, -54, -91 } },
+		// -128 and 127, six values
+		{ { 0x80, 0x7F, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA },
+			{ -127, 127, -76, -25, 25, 76, -127, 127, -127, 127, -76, -25, 25, 76, -127, 127 } },
+		// -128 and -128, six values
+		{ { 0x80, 0x80, 0x77, 0x39, 0x05, 0x77, 0x39, 0x05 },
+			{ 127, -127, -127, -127, -127, -127, -127, -127, 127, -127, -127, -127, -127, -127, -127, -127 } },
+		// -37 and -100, eight values
+		{ { 0xDB, 0x9C, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA },
+			{ -37, -100, -46, -55, -64, -73, -82, -91, -37, -100, -46, -55, -64, -73, -82, -91 } },
+		// -6 and 5, six values
+		{ { 0xFA, 0x05, 0x77, 0x39, 0x05, 0x77, 0x39, 0x05 },
+			{ 127, -127, 3, 1, -2, -4, 5, -6, 127, -127, 3, 1, -2, -4, 5, -6 } },
+		// -127 and -128, eight values from the encoded compare
+		{ { 0x81, 0x80, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA },
+			{ -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127, -127 } },
+};
+
+// BC4 UNORM of 160 and 96, eight values, then 64 and 192, six values. Together they are a BC5 block
+static KnownAnswerBlock<uint8_t, 16> const UnsignedBC4Vectors[2] = {
+		{ { 0xA0, 0x60, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA },
+			{ 160, 96, 151, 142, 133, 123, 114, 105, 160, 96, 151, 142, 133, 123, 114, 105 } },
+		{ { 0x40, 0xC0, 0x98, 0xC3, 0xAB, 0x98, 0xC3, 0xAB },
+			{ 64, 115, 0, 192, 141, 255, 90, 166, 64, 115, 0, 192, 141, 255, 90, 166 } },
+};
+
+// width x height of blocks, 8 bytes a block for BC4 and 16 for BC5
+Image_ImageHeader const *CreateBlockImage(TinyImageFormat format, uint32_t width, uint32_t height, uint8_t const *blocks) {
+	Image_ImageHeader const *src = Image_Create(width, height, 1, 1, format);
+	REQUIRE(src);
+	memcpy(Image_RawDataPtr(src), blocks, src->dataSize);
+	return src;
+}
+
+// a single block decoded as one channel, which must be R8 of the block's signedness
+template<typename T>
+void CheckChannelBlock(TinyImageFormat format,
+											 uint8_t const *block,
+											 TinyImageFormat_LogicalChannel channel,
+											 TinyImageFormat dstFormat,
+											 T const *expected) {
+	Image_ImageHeader const *src = CreateBlockImage(format, 4, 4, block);
+	Image_ImageHeader const *dst = Image_DecompressChannel(src, channel);
+	REQUIRE(dst);
+	CHECK(dst->format == dstFormat);
+	CheckKnownAnswer((T const *) Image_RawDataPtr(dst), expected, 16);
+	Image_Destroy(dst);
+	Image_Destroy(src);
+}
+
+} // end anon namespace
+
+TEST_CASE("BC4 SNORM endpoints including -128", "[gfx_imagedecompress dxtc]") {
+	CheckKnownAnswerBlocks(SignedBC4Vectors, [](uint8_t const *block, int8_t *output) {
+		Image_DecompressDXBC4SNormBlock(block, (uint8_t *) output);
+	});
+
+	// -128 is exactly -1 once converted
+	float output[16];
+	Image_DecompressDXBC4SNormBlockF(SignedBC4Vectors[1].block, output);
+	CHECK(output[0] == -1.0f);
+	CHECK(output[1] == 1.0f);
+}
+
+TEST_CASE("BC5 SNORM endpoints including -128", "[gfx_imagedecompress dxtc]") {
+	// each vector as red with the next one as green
+	for (size_t v = 0; v < 6; ++v) {
+		INFO("vector " << v);
+		KnownAnswerBlock<int8_t, 16> const& red = SignedBC4Vectors[v];
+		KnownAnswerBlock<int8_t, 16> const& green = SignedBC4Vectors[(v + 1) % 6];
+		uint8_t block[16];
+		memcpy(block, red.block, 8);
+		memcpy(block + 8, green.block, 8);
+		int8_t expected[32];
+		for (uint32_t i = 0; i < 16; ++i) {
+			expected[i * 2 + 0] = red.expected[i];
+			expected[i * 2 + 1] = green.expected[i];
+		}
+		int8_t output[32];
+		Image_DecompressDXBC5SNormBlock(block, (uint8_t *) output);
+		CheckKnownAnswer(output, expected, 32);
+	}
+}
+
+TEST_CASE("BC4 SNORM image decode matches the block decode", "[gfx_imagedecompress dxtc]") {
+	// 8 blocks across fills the ramps of a whole strip
+	Image_ImageHeader const *src = Image_Create(32, 8, 1, 1, TinyImageFormat_DXBC4_SNORM);
+	REQUIRE(src);
+	uint8_t *blocks = (uint8_t *) Image_RawDataPtr(src);
+	for (uint32_t b = 0; b < 16; ++b) {
+		memcpy(blocks + b * 8, SignedBC4Vectors[b % 6].block, 8);
+	}
+
+	Image_ImageHeader const *dst = Image_Decompress(src);
+	REQUIRE(dst);
+	CHECK(dst->format == TinyImageFormat_R8_SNORM);
+	int8_t const *out = (int8_t const *) Image_RawDataPtr(dst);
+	for (uint32_t b = 0; b < 16; ++b) {
+		INFO("block " << b);
+		int8_t const *expected = SignedBC4Vectors[b % 6].expected;
+		uint32_t const bx = b % 8;
+		uint32_t const by = b / 8;
+		for (uint32_t y = 0; y < 4; ++y) {
+			CheckKnownAnswer(out + (by * 4 + y) * 32 + bx * 4, expected + y * 4, 4);
+		}
+	}
+	Image_Destroy(dst);
+	Image_Destroy(src);
+}
+
+TEST_CASE("BC4 and BC5 channels decode alone", "[gfx_imagedecompress dxtc]") {
+	uint8_t block[16];
+	memcpy(block, UnsignedBC4Vectors[0].block, 8);
+	memcpy(block + 8, UnsignedBC4Vectors[1].block, 8);
+	CheckChannelBlock(TinyImageFormat_DXBC4_UNORM, block, TinyImageFormat_LC_Red, TinyImageFormat_R8_UNORM,
+										UnsignedBC4Vectors[0].expected);
+	CheckChannelBlock(TinyImageFormat_DXBC5_UNORM, block, TinyImageFormat_LC_Red, TinyImageFormat_R8_UNORM,
+										UnsignedBC4Vectors[0].expected);
+	CheckChannelBlock(TinyImageFormat_DXBC5_UNORM, block, TinyImageFormat_LC_Green, TinyImageFormat_R8_UNORM,
+										UnsignedBC4Vectors[1].expected);
+	// BC4 has no green
+	Image_ImageHeader const *src = CreateBlockImage(TinyImageFormat_DXBC4_UNORM, 4, 4, block);
+	CHECK(Image_DecompressChannel(src, TinyImageFormat_LC_Green) == nullptr);
+	Image_Destroy(src);
+
+	for (size_t v = 0; v < 6; ++v) {
+		INFO("vector " << v);
+		KnownAnswerBlock<int8_t, 16> const& red = SignedBC4Vectors[v];
+		KnownAnswerBlock<int8_t, 16> const& green = SignedBC4Vectors[(v + 1) % 6];
+		memcpy(block, red.block, 8);
+		memcpy(block + 8, green.block, 8);
+		CheckChannelBlock(TinyImageFormat_DXBC4_SNORM, block, TinyImageFormat_LC_Red, TinyImageFormat_R8_SNORM,
+											red.expected);
+		CheckChannelBlock(TinyImageFormat_DXBC5_SNORM, block, TinyImageFormat_LC_Red, TinyImageFormat_R8_SNORM,
+											red.expected);
+		CheckChannelBlock(TinyImageFormat_DXBC5_SNORM, block, TinyImageFormat_LC_Green, TinyImageFormat_R8_SNORM,
+											green.expected);
+	}
+}
+
+TEST_CASE("BC5 channel image decode matches the two channel decode", "[gfx_imagedecompress dxtc]") {
+	// 4 rows of 12 blocks, a whole strip of 8 and a partial one on every row
+	static uint8_t blocks[48 * 16];
+	uint32_t state = 0x2545F491;
+	for (uint32_t i = 0; i < sizeof(blocks); ++i) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		blocks[i] = (uint8_t) state;
+	}
+
+	TinyImageFormat const formats[2] = { TinyImageFormat_DXBC5_UNORM, TinyImageFormat_DXBC5_SNORM };
+	for (uint32_t f = 0; f < 2; ++f) {
+		Image_ImageHeader const *src = CreateBlockImage(formats[f], 48, 16, blocks);
+		Image_ImageHeader const *both = Image_Decompress(src);
+		REQUIRE(both);
+		uint8_t const *rg = (uint8_t const *) Image_RawDataPtr(both);
+		TinyImageFormat_LogicalChannel const channels[2] = { TinyImageFormat_LC_Red, TinyImageFormat_LC_Green };
+		for (uint32_t c = 0; c < 2; ++c) {
+			INFO("format " << f << " channel " << c);
+			Image_ImageHeader const *one = Image_DecompressChannel(src, channels[c]);
+			REQUIRE(one);
+			uint8_t const *out = (uint8_t const *) Image_RawDataPtr(one);
+			for (uint32_t i = 0; i < 48 * 16; ++i) {
+				INFO("texel " << i);
+				CHECK(out[i] == rg[i * 2 + c]);
+			}
+			Image_Destroy(one);
+		}
+		Image_Destroy(both);
+		Image_Destroy(src);
+	}
+}
+
+TEST_CASE("BC1 narrow decodes match converting the default decode", "[gfx_imagedecompress dxtc]") {
+	// 8 x 5 blocks, the image edges cut the last column and row
+	static uint8_t blocks[40 * 8];
+	uint32_t state = 0x2545F491;
+	for (uint32_t i = 0; i < sizeof(blocks); ++i) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		blocks[i] = (uint8_t) state;
+	}
+
+	// opaque, punch through alpha whose transparent texels are black and sRGB, which has no 565 output
+	TinyImageFormat const formats[3] = { TinyImageFormat_DXBC1_RGB_UNORM, TinyImageFormat_DXBC1_RGBA_UNORM,
+																			 TinyImageFormat_DXBC1_RGB_SRGB };
+	for (uint32_t f = 0; f < 3; ++f) {
+		INFO("format " << f);
+		Image_ImageHeader const *src = CreateBlockImage(formats[f], 30, 18, blocks);
+		Image_ImageHeader const *bgra = Image_Decompress(src);
+		REQUIRE(bgra);
+		uint8_t const *texels = (uint8_t const *) Image_RawDataPtr(bgra);
+		uint32_t const texelCount = 30 * 18;
+
+		bool const isSRGB = (formats[f] == TinyImageFormat_DXBC1_RGB_SRGB);
+		Image_ImageHeader const *rgb = Image_DecompressTo(src, isSRGB ? TinyImageFormat_R8G8B8_SRGB :
+																																 TinyImageFormat_R8G8B8_UNORM);
+		REQUIRE(rgb);
+		uint8_t const *rgbTexels = (uint8_t const *) Image_RawDataPtr(rgb);
+		for (uint32_t i = 0; i < texelCount; ++i) {
+			INFO("texel " << i);
+			CHECK(rgbTexels[i * 3 + 0] == texels[i * 4 + 2]);
+			CHECK(rgbTexels[i * 3 + 1] == texels[i * 4 + 1]);
+			CHECK(rgbTexels[i * 3 + 2] == texels[i * 4 + 0]);
+		}
+		Image_Destroy(rgb);
+
+		if (!isSRGB) {
+			// each channel rounded to its 565 bits
+			Image_ImageHeader const *packed = Image_DecompressTo(src, TinyImageFormat_B5G6R5_UNORM);
+			REQUIRE(packed);
+			uint16_t const *packedTexels = (uint16_t const *) Image_RawDataPtr(packed);
+			for (uint32_t i = 0; i < texelCount; ++i) {
+				INFO("texel " << i);
+				uint32_t const r = (texels[i * 4 + 2] * 31 + 127) / 255;
+				uint32_t const g = (texels[i * 4 + 1] * 63 + 127) / 255;
+				uint32_t const b = (texels[i * 4 + 0] * 31 + 127) / 255;
+				CHECK(packedTexels[i] == ((r << 11) | (g << 5) | b));
+			}
+			Image_Destroy(packed);
+		}
+		Image_Destroy(bgra);
+		Image_Destroy(src);
+	}
+}
@@ -0,0 +1,222 @@
+#include "al2o3_platform/platform.h"
+#include "al2o3_catch2/catch2.hpp"
+#include "gfx_image/image.h"
+#include "gfx_imagedecompress/imagedecompress.h"
+#include "knownanswers.h"
+
+// EAC signed R11 known answers as 16 bit SNORM in row order, the -128 base codeword decodes as -127
+namespace {
+static KnownAnswerBlock<int16_t, 16> const SignedR11Vectors[4] = {
+		// base -128 decodes as -127, multiplier 15
+		{ { 0x80, 0xF0, 0x05, 0x39, 0x77, 0x05, 0x39, 0x77 },
+			{ -32767, -24856, -32767, -24856, -32767, -13325, -32767, -13325,
+				-32767, -1793, -32767, -1793, -32767, 21268, -32767, 21268 } },
+		// base 127 clamps to 1023
+		{ { 0x7F, 0xFD, 0x0F, 0x19, 0xD5, 0x0F, 0x19, 0xD5 },
+			{ 28700, 32543, 28700, 32543, -5893, 32767, -5893, 32767,
+				32767, 21012, 32767, 21012, 24856, 32767, 24856, 32767 } },
+		// base -128 with multiplier 0, modifiers are not scaled
+		{ { 0x80, 0x0E, 0x0F, 0x19, 0xD5, 0x0F, 0x19, 0xD5 },
+			{ -32671, -32447, -32671, -32447, -32767, -32287, -32767, -32287,
+				-32319, -32767, -32319, -32767, -32735, -32383, -32735, -32383 } },
+		// base -59, multiplier 3
+		{ { 0xC5, 0x35, 0x05, 0x39, 0x77, 0x05, 0x39, 0x77 },
+			{ -17425, -13581, -17425, -13581, -20500, -10506, -20500, -10506,
+				-22037, -8968, -22037, -8968, -23575, -7431, -23575, -7431 } },
+};
+
+// the same blocks as 8 bit SNORM, 11 bit values rounded half away from zero
+static int8_t const SignedR11To8Expected[4][16] = {
+		{ -127, -96, -127, -96, -127, -52, -127, -52, -127, -7, -127, -7, -127, 82, -127, 82 },
+		{ 111, 126, 111, 126, -23, 127, -23, 127, 127, 81, 127, 81, 96, 127, 96, 127 },
+		{ -127, -126, -127, -126, -127, -125, -127, -125, -125, -127, -125, -127, -127, -126, -127, -126 },
+		{ -68, -53, -68, -53, -79, -41, -79, -41, -85, -35, -85, -35, -91, -29, -91, -29 },
+};
+
+// EAC R11 as 8 bit UNORM, the 11 bit values rounded to nearest
+static KnownAnswerBlock<uint8_t, 16> const UnsignedR11To8Vectors[3] = {
+		// base 255, multiplier 15
+		{ { 0xFF, 0xF0, 0x05, 0x39, 0x77, 0x05, 0x39, 0x77 },
+			{ 210, 255, 210, 255, 165, 255, 165, 255, 120, 255, 120, 255, 30, 255, 30, 255 } },
+		// base 128, multiplier 8
+		{ { 0x80, 0x80, 0x0F, 0x19, 0xD5, 0x0F, 0x19, 0xD5 },
+			{ 104, 144, 104, 144, 8, 240, 8, 240, 192, 56, 192, 56, 80, 168, 80, 168 } },
+		// base 3 with multiplier 0, modifiers are not scaled
+		{ { 0x03, 0x0D, 0x0F, 0x19, 0xD5, 0x0F, 0x19, 0xD5 },
+			{ 3, 3, 3, 3, 2, 5, 2, 5, 4, 3, 4, 3, 3, 4, 3, 4 } },
+};
+
+// ETC2 EAC alpha, base + modifier * multiplier clamped to 0 to 255
+static KnownAnswerBlock<uint8_t, 16> const AlphaVectors[2] = {
+		// base 100, multiplier 3
+		{ { 0x64, 0x30, 0x05, 0x39, 0x77, 0x05, 0x39, 0x77 },
+			{ 91, 106, 91, 106, 82, 115, 82, 115, 73, 124, 73, 124, 55, 142, 55, 142 } },
+		// base 250, multiplier 15 clamps
+		{ { 0xFA, 0xFD, 0x0F, 0x19, 0xD5, 0x0F, 0x19, 0xD5 },
+			{ 235, 250, 235, 250, 100, 255, 100, 255, 255, 205, 255, 205, 220, 255, 220, 255 } },
+};
+
+// a 4x4 image of the 16 byte block decoded as one channel, which must be dstFormat
+template<typename T>
+void CheckChannelBlock(TinyImageFormat format,
+											 uint8_t const *block,
+											 TinyImageFormat_LogicalChannel channel,
+											 TinyImageFormat dstFormat,
+											 T const *expected) {
+	Image_ImageHeader const *src = Image_Create(4, 4, 1, 1, format);
+	REQUIRE(src);
+	memcpy(Image_RawDataPtr(src), block, src->dataSize);
+	Image_ImageHeader const *dst = Image_DecompressChannel(src, channel);
+	REQUIRE(dst);
+	CHECK(dst->format == dstFormat);
+	CheckKnownAnswer((T const *) Image_RawDataPtr(dst), expected, 16);
+	Image_Destroy(dst);
+	Image_Destroy(src);
+}
+
+} // end anon namespace
+
+TEST_CASE("EAC signed R11 base codewords including -128", "[gfx_imagedecompress eac]") {
+	CheckKnownAnswerBlocks(SignedR11Vectors, [](uint8_t const *block, int16_t *output) {
+		Image_DecompressEACSigned11Block(block, (uint8_t *) output);
+	});
+
+	// -128 is exactly -1 once converted
+	float output[16];
+	Image_DecompressEACSigned11BlockF(SignedR11Vectors[0].block, output);
+	CHECK(output[0] == -1.0f);
+	CHECK(output[1] == -24856.0f / 32767.0f);
+}
+
+TEST_CASE("EAC signed RG11 base codewords including -128", "[gfx_imagedecompress eac]") {
+	// each vector as red with the next one as green, so -128 is tried in both channels
+	for (size_t v = 0; v < 4; ++v) {
+		INFO("vector " << v);
+		KnownAnswerBlock<int16_t, 16> const& red = SignedR11Vectors[v];
+		KnownAnswerBlock<int16_t, 16> const& green = SignedR11Vectors[(v + 1) % 4];
+		uint8_t block[16];
+		memcpy(block, red.block, 8);
+		memcpy(block + 8, green.block, 8);
+		int16_t expected[32];
+		for (uint32_t i = 0; i < 16; ++i) {
+			expected[i * 2 + 0] = red.expected[i];
+			expected[i * 2 + 1] = green.expected[i];
+		}
+		int16_t output[32];
+		Image_DecompressEACDualSigned11Block(block, (uint8_t *) output);
+		CheckKnownAnswer(output, expected, 32);
+
+		float outputF[32];
+		Image_DecompressEACDualSigned11BlockF(block, outputF);
+		for (uint32_t i = 0; i < 32; ++i) {
+			INFO("value " << i);
+			CHECK(outputF[i] == (float) expected[i] / 32767.0f);
+		}
+	}
+}
+
+TEST_CASE("EAC R11 and RG11 channels decode alone", "[gfx_imagedecompress eac]") {
+	for (size_t v = 0; v < 3; ++v) {
+		INFO("unsigned vector " << v);
+		uint8_t block[16];
+		memcpy(block, UnsignedR11To8Vectors[v].block, 8);
+		memcpy(block + 8, UnsignedR11To8Vectors[(v + 1) % 3].block, 8);
+		CheckChannelBlock(TinyImageFormat_ETC2_EAC_R11_UNORM, block, TinyImageFormat_LC_Red, TinyImageFormat_R8_UNORM,
+											UnsignedR11To8Vectors[v].expected);
+		CheckChannelBlock(TinyImageFormat_ETC2_EAC_R11G11_UNORM, block, TinyImageFormat_LC_Red,
+											TinyImageFormat_R8_UNORM, UnsignedR11To8Vectors[v].expected);
+		CheckChannelBlock(TinyImageFormat_ETC2_EAC_R11G11_UNORM, block, TinyImageFormat_LC_Green,
+											TinyImageFormat_R8_UNORM, UnsignedR11To8Vectors[(v + 1) % 3].expected);
+	}
+	for (size_t v = 0; v < 4; ++v) {
+		INFO("signed vector " << v);
+		uint8_t block[16];
+		memcpy(block, SignedR11Vectors[v].block, 8);
+		memcpy(block + 8, SignedR11Vectors[(v + 1) % 4].block, 8);
+		CheckChannelBlock(TinyImageFormat_ETC2_EAC_R11_SNORM, block, TinyImageFormat_LC_Red, TinyImageFormat_R8_SNORM,
+											SignedR11To8Expected[v]);
+		CheckChannelBlock(TinyImageFormat_ETC2_EAC_R11G11_SNORM, block, TinyImageFormat_LC_Red,
+											TinyImageFormat_R8_SNORM, SignedR11To8Expected[v]);
+		CheckChannelBlock(TinyImageFormat_ETC2_EAC_R11G11_SNORM, block, TinyImageFormat_LC_Green,
+											TinyImageFormat_R8_SNORM, SignedR11To8Expected[(v + 1) % 4]);
+	}
+}
+
+TEST_CASE("ETC2 RGBA8 alpha is the first half of the block", "[gfx_imagedecompress eac]") {
+	// the colour half holds the other alpha vector, so reading alpha from the wrong half fails
+	for (size_t v = 0; v < 2; ++v) {
+		INFO("vector " << v);
+		uint8_t block[16];
+		memcpy(block, AlphaVectors[v].block, 8);
+		memcpy(block + 8, AlphaVectors[1 - v].block, 8);
+		CheckChannelBlock(TinyImageFormat_ETC2_R8G8B8A8_UNORM, block, TinyImageFormat_LC_Alpha,
+											TinyImageFormat_R8_UNORM, AlphaVectors[v].expected);
+
+		// and the full decode puts the same alpha in each texel
+		Image_ImageHeader const *src = Image_Create(4, 4, 1, 1, TinyImageFormat_ETC2_R8G8B8A8_UNORM);
+		REQUIRE(src);
+		memcpy(Image_RawDataPtr(src), block, 16);
+		Image_ImageHeader const *dst = Image_Decompress(src);
+		REQUIRE(dst);
+		uint8_t const *texels = (uint8_t const *) Image_RawDataPtr(dst);
+		for (uint32_t i = 0; i < 16; ++i) {
+			INFO("texel " << i);
+			CHECK(texels[i * 4 + 3] == AlphaVectors[v].expected[i]);
+		}
+		Image_Destroy(dst);
+		Image_Destroy(src);
+	}
+}
+
+TEST_CASE("EAC 8 bit decodes match converting the 16 bit decode", "[gfx_imagedecompress eac]") {
+	// 8 x 5 blocks of 16 bytes, R11 uses the first half of them. The image edges cut the last column and row
+	static uint8_t blocks[40 * 16];
+	uint32_t state = 0x2545F491;
+	for (uint32_t i = 0; i < sizeof(blocks); ++i) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		blocks[i] = (uint8_t) state;
+	}
+
+	struct Conversion {
+		TinyImageFormat srcFormat;
+		TinyImageFormat dstFormat;
+		uint32_t channels;
+		bool isSigned;
+	};
+	Conversion const conversions[4] = {
+			{ TinyImageFormat_ETC2_EAC_R11_UNORM, TinyImageFormat_R8_UNORM, 1, false },
+			{ TinyImageFormat_ETC2_EAC_R11G11_UNORM, TinyImageFormat_R8G8_UNORM, 2, false },
+			{ TinyImageFormat_ETC2_EAC_R11_SNORM, TinyImageFormat_R8_SNORM, 1, true },
+			{ TinyImageFormat_ETC2_EAC_R11G11_SNORM, TinyImageFormat_R8G8_SNORM, 2, true },
+	};
+	for (uint32_t c = 0; c < 4; ++c) {
+		INFO("conversion " << c);
+		Conversion const& conversion = conversions[c];
+		Image_ImageHeader const *src = Image_Create(30, 18, 1, 1, conversion.srcFormat);
+		REQUIRE(src);
+		memcpy(Image_RawDataPtr(src), blocks, src->dataSize);
+
+		Image_ImageHeader const *wide = Image_Decompress(src);
+		REQUIRE(wide);
+		Image_ImageHeader const *narrow = Image_DecompressTo(src, conversion.dstFormat);
+		REQUIRE(narrow);
+		uint16_t const *values = (uint16_t const *) Image_RawDataPtr(wide);
+		uint8_t const *out = (uint8_t const *) Image_RawDataPtr(narrow);
+		for (uint32_t i = 0; i < 30 * 18 * conversion.channels; ++i) {
+			INFO("value " << i);
+			if (conversion.isSigned) {
+				// rounded half away from zero
+				int32_t const t = (int16_t) values[i] * 127;
+				int32_t const expected = (t >= 0) ? (t + 16383) / 32767 : -((16383 - t) / 32767);
+				CHECK((int8_t) out[i] == expected);
+			} else {
+				CHECK(out[i] == (values[i] * 255 + 32767) / 65535);
+			}
+		}
+		Image_Destroy(narrow);
+		Image_Destroy(wide);
+		Image_Destroy(src);
+	}
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "al2o3_platform/platform.h"
+#include "al2o3_catch2/catch2.hpp"
+
+// a 16 byte compressed block and the N values it must decode to
+template<typename T, size_t N>
+struct KnownAnswerBlock {
+	uint8_t block[16];
+	T expected[N];
+};
+
+// compares count decoded values, a failure reports the index of the value
+template<typename T>
+void CheckKnownAnswer(T const *output, T const *expected, size_t count) {
+	for (size_t i = 0; i < count; ++i) {
+		INFO("value " << i);
+		CHECK(output[i] == expected[i]);
+	}
+}
+
+// decodes each vector with decode(block, output) and compares all N values
+template<typename T, size_t N, size_t Count, typename Decode>
+void CheckKnownAnswerBlocks(KnownAnswerBlock<T, N> const (&vectors)[Count], Decode decode) {
+	for (size_t v = 0; v < Count; ++v) {
+		INFO("vector " << v);
+		T output[N];
+		decode(vectors[v].block, output);
+		CheckKnownAnswer(output, vectors[v].expected, N);
+	}
+}
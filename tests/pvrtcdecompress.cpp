@@ -0,0 +1,195 @@
+#include "al2o3_platform/platform.h"
+#include "al2o3_catch2/catch2.hpp"
+#include "gfx_image/image.h"
+#include "gfx_imagedecompress/imagedecompress.h"
+#include "knownanswers.h"
+#include "al2o3_enki/TaskScheduler_c.h"
+
+// PVRTC1 known answer images, blocks are in morton order and expected texels are B8G8R8A8 as little endian uint32s
+namespace {
+// 4bpp 8x8, 2x2 blocks so every texel interpolates blocks that wrap around the image
+static uint8_t const Wrap4BPPBlocks[32] = {
+		0x10, 0x2E, 0x90, 0x35, 0x95, 0x2C, 0x86, 0x8F, 0x6C, 0x12, 0xE4, 0x27, 0x85, 0xB2, 0x87, 0x20,
+		0x04, 0xCC, 0xF3, 0xEE, 0x35, 0x77, 0xDD, 0x24, 0xB2, 0x2B, 0x85, 0x4A, 0x08, 0x4E, 0xC8, 0x35
+};
+static uint32_t const Wrap4BPPTexels[64] = {
+		0xAEA55C52, 0xA79E7E44, 0xA152AC43, 0xA79E7E44, 0xAEA55C52, 0x8E72847E, 0xBBB1186F, 0xB4AB3A60,
+		0x00679B6A, 0xAF1ED264, 0x0062B740, 0x8BAB7F47, 0xA3A2614E, 0x6D38D7A8, 0xD492255C, 0x6D38D7A8,
+		0x99A0674A, 0x6EB7814A, 0xA173C13D, 0x006DB253, 0xA12DE288, 0xC38A4C4A, 0x4442DEDE, 0x7237E0B3,
+		0x98679B6A, 0x9D64A855, 0xD012D042, 0x8BAB7F47, 0x00679B6A, 0x6D38D7A8, 0x006C7F93, 0x6D38D7A8,
+		0xAEA55C52, 0x8E1BC06B, 0x0052AC43, 0x9A5C9F57, 0x8E589F71, 0xB4AB3A60, 0x554AD6B5, 0x84649785,
+		0x0068886B, 0xC4927C40, 0xA141A247, 0xC4927C40, 0x682ABA81, 0x7E6B8E83, 0x767E8794, 0xADBB316C,
+		0xC3A9525A, 0x964D8B5B, 0x0031984A, 0x4C149C79, 0x99797467, 0x8A96607C, 0x88EF0094, 0x78728580,
+		0x682ABA81, 0x98549559, 0x0041A247, 0xC4927C40, 0x86589470, 0x7E6B8E83, 0xA1D00C81, 0x908B6879
+};
+
+// 4bpp 16x8, 4x2 blocks so the morton order puts the extra x bit above the interleaved bits
+static uint8_t const Wide4BPPBlocks[64] = {
+		0x8D, 0x26, 0xC4, 0x4B, 0xF9, 0x82, 0xF5, 0xD0, 0x79, 0x61, 0xA1, 0xB2, 0xCB, 0xA2, 0x37, 0x6F,
+		0xE9, 0x80, 0x43, 0x9F, 0x2E, 0xC6, 0xAB, 0x84, 0x63, 0x5D, 0x1D, 0x89, 0xBE, 0xBB, 0xC4, 0x85,
+		0xB6, 0xBF, 0xF0, 0x49, 0x9D, 0xD4, 0x2B, 0x4D, 0xC7, 0x42, 0xEC, 0x11, 0xE9, 0x80, 0x8D, 0x22,
+		0xC2, 0x87, 0x94, 0xFB, 0x0E, 0x2C, 0xD6, 0x73, 0x37, 0x65, 0x2D, 0x4F, 0x53, 0x77, 0x07, 0xCD
+};
+static uint32_t const Wide4BPPTexels[128] = {
+		0xDD7E6A7F, 0xE9B74C7F, 0xFF21B990, 0x006B7A8A, 0xFA5A8D8D, 0xFA4B7374, 0xFF34776B, 0xD8265061,
+		0x00576397, 0xC56052A5, 0x667F56CE, 0x007148A2, 0xB9765890, 0xB28E2A92, 0x99A02990, 0xF281795E,
+		0x00746F9B, 0xE66C74A1, 0x006579A6, 0xFF2DB5A9, 0xFF4BB0A2, 0xFF68AA9C, 0xFF86A596, 0xE950567E,
+		0xBB5B3B89, 0x99853BA7, 0x77AF3BC6, 0x00923EB7, 0xB47D798F, 0xAA9048A7, 0x6EB714C8, 0xCE75758A,
+		0xA1675EE7, 0xE55D78BA, 0xFF00BDCE, 0xFF7D3598, 0xFF563184, 0xFF69988A, 0xFF8C8C73, 0xF3735586,
+		0xFF9C56B1, 0xFFA53BD0, 0x88DE21BD, 0xA1B350A7, 0xA1BD10F7, 0x969E46CA, 0x839353C4, 0xC26A82A4,
+		0xF284777B, 0x006C74A1, 0xFF10BBAF, 0xFA5D7699, 0xF8613975, 0xFB343A60, 0xFF567D7A, 0xE950567E,
+		0xDD6F509B, 0x008340AF, 0xFF8127C3, 0xB7923EB7, 0xB47D798F, 0xBA7E6892, 0xF24CB758, 0xF268976A,
+		0xDD7E6A7F, 0x007B7087, 0xE5D23590, 0xF56B7A8A, 0xF26D4267, 0xFF68BCAF, 0xFF34776B, 0xF0577D93,
+		0xB2445286, 0xC56052A5, 0xFF562D98, 0x8A7965AE, 0xAE73738E, 0xC27D5580, 0xF667904E, 0xB2804D90,
+		0xE5896464, 0xF047986B, 0x008D7579, 0xF0797E7C, 0xF7629889, 0xF53F5544, 0xFF4EA99B, 0xEE499299,
+		0x003F7793, 0xFF3E5B89, 0xFF2B336D, 0xB74F528C, 0xC4615278, 0xD1735262, 0x0085534E, 0xE2875B58,
+		0xED945E47, 0xFA4E9C46, 0x00A07362, 0x0087826D, 0xF569A285, 0xF2466335, 0xFF4AC0AB, 0xFF56C1D0,
+		0xFF3994A0, 0x721A86AF, 0x00106290, 0x723F79B5, 0xCB4B565E, 0xD07D5463, 0x00874A2D, 0xF2676B2D,
+		0x00896464, 0xF047986B, 0xD8E93381, 0x00797E7C, 0xF7629889, 0xF84E8272, 0xFF79D6DC, 0xE435807F,
+		0xD43F7793, 0xFF3E5B89, 0xAA3D52A1, 0xF0433568, 0xA7696D8D, 0xD1756B68, 0xC38A3D58, 0xE2875B58
+};
+
+// 2bpp 16x16, 2x4 blocks so the morton order puts the extra y bit above the interleaved bits
+static uint8_t const Tall2BPPBlocks[64] = {
+		0xF2, 0x9B, 0x94, 0x4F, 0x87, 0x14, 0x5E, 0xEA, 0x7F, 0xB3, 0xA8, 0x49, 0xD1, 0xFA, 0xE7, 0x1C,
+		0xA0, 0x55, 0x59, 0x99, 0x38, 0xBC, 0x85, 0x1A, 0x2C, 0x08, 0xF8, 0x8F, 0xAA, 0x63, 0x9B, 0xB6,
+		0x11, 0xC3, 0xD0, 0xF9, 0xC6, 0x8D, 0xCA, 0x97, 0x2E, 0x1C, 0xBC, 0x71, 0x27, 0x19, 0x95, 0x1A,
+		0xC0, 0x47, 0xB7, 0xCE, 0x21, 0xD5, 0xFC, 0xC9, 0x3C, 0x5A, 0x92, 0x27, 0x47, 0x57, 0xB9, 0x62
+};
+static uint32_t const Tall2BPPTexels[256] = {
+		0x83949E8E, 0x798E7B8A, 0x4E714A77, 0x578A6B81, 0x90C198A5, 0x82AD8F98, 0x8AAB9B99, 0x75887088,
+		0x7B733D84, 0x9174378A, 0xA7753190, 0xBE762B96, 0xD477259C, 0x7A72A27C, 0xA7753190, 0x80899F88,
+		0x878A6D94, 0x99B396A6, 0x7D8D7898, 0x889C84A3, 0x89A088A8, 0x68827890, 0x88987F9E, 0x88957B9A,
+		0x8AAB9799, 0x9E6D3899, 0x6B9A977E, 0xD07522AC, 0x4C8A9865, 0xD07522AC, 0x6B9A977E, 0x9E6D3899,
+		0x905E4A9C, 0x979D7CA9, 0x827E799F, 0xA49E8AB9, 0x74798F9F, 0x7B7C849F, 0x9D9D83B2, 0x979D7CA9,
+		0x90C190A5, 0xAC6639A9, 0xC76D29B5, 0x3DB28D67, 0x22AD8C52, 0xE37418C1, 0x59B78E7B, 0xAC6639A9,
+		0x95A58FA3, 0x9EBEA1B1, 0xA6BA9FB6, 0xB9CDA8CA, 0x9DAEA3B0, 0x6C6E897D, 0x8F8E8B9B, 0x968A829D,
+		0x90B89EA6, 0xB86B56A8, 0xCC6A4AB2, 0x67A29580, 0x599C9275, 0xDF693DBC, 0xCC6A4AB2, 0x82B19B99,
+		0x90AFADA7, 0x90B7B2AA, 0x90C0B7AE, 0x90C9BCB1, 0x90D2C1B5, 0x92BBB2A5, 0x9D9E9E99, 0xA88E919A,
+		0xBB797D9E, 0xC57074A7, 0x909DA29F, 0x90949D9B, 0xE5565AC1, 0x90949D9B, 0xD0686CB0, 0xC57074A7,
+		0xB096A9A3, 0x82B0C2A2, 0xA0B1B597, 0xC9B8A68A, 0x90CDC18C, 0x67C4D198, 0x7FB7C49B, 0x9EA6B39E,
+		0xD087979F, 0xD27592A6, 0xD4658DAD, 0xB986A6B6, 0xD84484BB, 0xD65488B4, 0xD4658DAD, 0xD27592A6,
+		0xE594B1A0, 0xBEABBE9B, 0x92BBCC91, 0x54C4DE82, 0x22CEEF73, 0x54C4DE82, 0x92BBCC91, 0xBEABBE9B,
+		0xE594B1A0, 0xDF7BB0A6, 0xD863AFAB, 0xE377AED1, 0xFF6BA5DE, 0xE377AED1, 0xC784B7C3, 0xAC90C0B6,
+		0xBB8BBB9C, 0xCE93B085, 0xBB9DBD80, 0xA1A5CB78, 0xC0B5C171, 0xF9B1A277, 0xD8A0AE7C, 0xCE93B085,
+		0xAC8DC6A6, 0xC087BAB4, 0xD580B0C2, 0xE97AA5D1, 0xD8509488, 0xDD5D9685, 0xE26C9882, 0xC087BAB4,
+		0xC77DC1A2, 0xF57E8B5C, 0xF8818E5D, 0xFB85915D, 0x907BF363, 0xFB85915D, 0xF8818E5D, 0xF57E8B5C,
+		0xF27B885C, 0xE27A9D86, 0xEB75815B, 0xEB768987, 0xE56F7B5A, 0xEA758578, 0xE37EA9C2, 0xD87CAFA7,
+		0xE36EBD9F, 0xDB67CB8E, 0xFB5F7B40, 0xFC577F44, 0xFF508448, 0xFC577F44, 0xD55FD97C, 0xDB67CB8E,
+		0xE86EAA85, 0xE974AFB0, 0xF37C867A, 0xF484776D, 0xF68C7071, 0xF3866730, 0xF37C867A, 0xF1758763,
+		0xFF635E18, 0xFF50641E, 0xFF3D6925, 0xFF2B6E2B, 0xFF29F752, 0xFF2B6E2B, 0xFF44D877, 0xFF51C98A,
+		0xFF5EB99C, 0xFF6E9587, 0xFF826E4F, 0xFF8B7CA0, 0xFF947BE7, 0xFF926553, 0xFF7E7F7D, 0xFF708160,
+		0xDD60B693, 0xD45E5531, 0xD0525836, 0xCD4FD561, 0xC74AE052, 0xCD4FD561, 0xD255CB72, 0xD75AC082,
+		0xDB64906C, 0xE06C8874, 0xE5728B8F, 0xEC7196C3, 0xEF807BA5, 0xE5914A1E, 0xE37B6C59, 0xE266ABA2,
+		0xBB63B38A, 0xAD698060, 0xA567BE6E, 0x9A67B35C, 0x90649A50, 0x9A648655, 0xA1684948, 0xAB6B6452,
+		0xB2754842, 0xC16A8675, 0xD05EA8A6, 0xD86195A3, 0xE55A9CC1, 0xD1786866, 0xC382473B, 0xC16A8675,
+		0x90746765, 0x7F7D3A57, 0x77799265, 0x6981B25D, 0x59879354, 0x677D645B, 0x737B565D, 0x7F7D3A57,
+		0x90746765, 0xA2678477, 0xB062847D, 0xBF5C8483, 0xCE56858B, 0xBA6A6A6F, 0xAC6D686C, 0x9E706769,
+		0x6688316B, 0x59855B6C, 0x4C8AA565, 0x369A815F, 0x22AD9C52, 0x369A815F, 0x498D7667, 0x59855B6C,
+		0x70737E72, 0x84658278, 0x887D396B, 0xA35D6B7A, 0xB654707D, 0xA7557B7F, 0x9759867E, 0x7C765470,
+		0x747D607B, 0x64835F78, 0x558A5F75, 0x35843A6E, 0x4BAA8277, 0x61A99C7C, 0x6293857A, 0x64835F78,
+		0x767D6E7C, 0x856FA884, 0x946F6180, 0xA3696183, 0xB3626286, 0x9E5F8085, 0x946F6180, 0x837B367A
+};
+
+void CheckImage(TinyImageFormat format,
+								uint32_t width,
+								uint32_t height,
+								uint8_t const *blocks,
+								size_t blocksSize,
+								uint32_t const *texels) {
+	Image_ImageHeader const *src = Image_Create(width, height, 1, 1, format);
+	REQUIRE(src);
+	REQUIRE(src->dataSize == blocksSize);
+	memcpy(Image_RawDataPtr(src), blocks, blocksSize);
+
+	Image_ImageHeader const *dst = Image_Decompress(src);
+	REQUIRE(dst);
+	CHECK(dst->format == TinyImageFormat_B8G8R8A8_UNORM);
+	CheckKnownAnswer((uint32_t const *) Image_RawDataPtr(dst), texels, width * height);
+	Image_Destroy(dst);
+	Image_Destroy(src);
+}
+
+// decodes random blocks plainly and premultiplies afterwards, then premultiplied serially and in bands of block
+// rows. A band owns the texel rows between its block row centres, the first rows wrap to the last band
+void CheckPremultipliedBands(TinyImageFormat format, uint32_t width, uint32_t height, uint32_t slices) {
+	Image_ImageHeader const *src = Image_Create(width, height, 1, slices, format);
+	REQUIRE(src);
+	uint32_t state = 0x2545F491;
+	uint8_t *blocks = (uint8_t *) Image_RawDataPtr(src);
+	for (size_t i = 0; i < src->dataSize; ++i) {
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		blocks[i] = (uint8_t) state;
+	}
+
+	Image_ImageHeader const *plain = Image_Decompress(src);
+	REQUIRE(plain);
+	size_t const texelCount = (size_t) width * height * slices;
+	uint8_t *expected = (uint8_t *) malloc(texelCount * 4);
+	memcpy(expected, Image_RawDataPtr(plain), texelCount * 4);
+	for (size_t i = 0; i < texelCount; ++i) {
+		uint32_t const alpha = expected[i * 4 + 3];
+		for (uint32_t c = 0; c < 3; ++c) {
+			expected[i * 4 + c] = (uint8_t) ((2 * expected[i * 4 + c] * alpha + 255) / 510);
+		}
+	}
+
+	Image_ImageHeader const *serial = Image_DecompressToPremultiplied(src, TinyImageFormat_B8G8R8A8_UNORM);
+	REQUIRE(serial);
+	CheckKnownAnswer((uint8_t const *) Image_RawDataPtr(serial), expected, texelCount * 4);
+
+	enkiTaskSchedulerHandle scheduler = enkiNewTaskScheduler();
+	enkiInitTaskSchedulerNumThreads(scheduler, 4);
+	Image_ImageHeader const *banded =
+			ImageDecompressToPremultipliedWithEnki(src, TinyImageFormat_B8G8R8A8_UNORM, scheduler);
+	REQUIRE(banded);
+	CheckKnownAnswer((uint8_t const *) Image_RawDataPtr(banded), expected, texelCount * 4);
+	enkiDeleteTaskScheduler(scheduler);
+
+	Image_Destroy(banded);
+	Image_Destroy(serial);
+	free(expected);
+	Image_Destroy(plain);
+	Image_Destroy(src);
+}
+
+} // end anon namespace
+
+TEST_CASE("PVRTC1 4bpp wraps at the image edges", "[gfx_imagedecompress pvrtc]") {
+	CheckImage(TinyImageFormat_PVRTC1_4BPP_UNORM, 8, 8, Wrap4BPPBlocks, sizeof(Wrap4BPPBlocks), Wrap4BPPTexels);
+}
+
+TEST_CASE("PVRTC1 morton order of non square block counts", "[gfx_imagedecompress pvrtc]") {
+	CheckImage(TinyImageFormat_PVRTC1_4BPP_UNORM, 16, 8, Wide4BPPBlocks, sizeof(Wide4BPPBlocks), Wide4BPPTexels);
+	CheckImage(TinyImageFormat_PVRTC1_2BPP_UNORM, 16, 16, Tall2BPPBlocks, sizeof(Tall2BPPBlocks), Tall2BPPTexels);
+}
+
+TEST_CASE("PVRTC1 constant colour ignores modulation", "[gfx_imagedecompress pvrtc]") {
+	// opaque white for both colours, the punch through bit clear and a different modulation word per block
+	Image_ImageHeader const *src = Image_Create(16, 16, 1, 1, TinyImageFormat_PVRTC1_4BPP_UNORM);
+	REQUIRE(src);
+	uint8_t *blocks = (uint8_t *) Image_RawDataPtr(src);
+	for (uint32_t i = 0; i < 16; ++i) {
+		uint32_t const modulation = 0x9E3779B9u * (i + 1);
+		uint32_t const colours = 0xFFFFFFFEu;
+		memcpy(blocks + i * 8, &modulation, sizeof(uint32_t));
+		memcpy(blocks + i * 8 + 4, &colours, sizeof(uint32_t));
+	}
+
+	Image_ImageHeader const *dst = Image_Decompress(src);
+	REQUIRE(dst);
+	uint8_t const *out = (uint8_t const *) Image_RawDataPtr(dst);
+	for (uint32_t i = 0; i < 16 * 16 * 4; ++i) {
+		CHECK(out[i] == 255);
+	}
+	Image_Destroy(dst);
+	Image_Destroy(src);
+}
+
+TEST_CASE("PVRTC1 premultiplies every texel row once", "[gfx_imagedecompress pvrtc]") {
+	// 32 and 16 block rows, several bands each
+	CheckPremultipliedBands(TinyImageFormat_PVRTC1_4BPP_UNORM, 32, 128, 2);
+	CheckPremultipliedBands(TinyImageFormat_PVRTC1_2BPP_UNORM, 64, 64, 1);
+}